@@ -66,6 +66,7 @@ TASK_SOURCES = \
 	$(TASK_SRC_DIR)/Solvers/TaskCruiseEfficiency.cpp \
 	$(TASK_SRC_DIR)/Solvers/TaskEffectiveMacCready.cpp \
 	$(TASK_SRC_DIR)/Solvers/TaskMinTarget.cpp \
+	$(TASK_SRC_DIR)/Solvers/TaskAnalyticTarget.cpp \
 	$(TASK_SRC_DIR)/Solvers/TaskOptTarget.cpp \
 	$(TASK_SRC_DIR)/Solvers/TaskGlideRequired.cpp \
 	$(TASK_SRC_DIR)/Solvers/TaskSolution.cpp \
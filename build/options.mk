@@ -8,6 +8,12 @@ ifeq ($(FIXED),y)
 TARGET_CPPFLAGS += -DFIXED_MATH
 endif
 
+# use single precision in bulk geometric loops (see Math/BulkFloat.hpp)?
+FLOAT_GEOMETRY ?= $(call bool_and,$(TARGET_IS_ARM),$(HAVE_FPU))
+ifeq ($(FLOAT_GEOMETRY),y)
+TARGET_CPPFLAGS += -DFLOAT_GEOMETRY
+endif
+
 ifeq ($(RADIANS),y)
 TARGET_CPPFLAGS += -DRADIANS
 endif
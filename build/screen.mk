@@ -56,9 +56,15 @@ SCREEN_SOURCES += \
 	$(SCREEN_SRC_DIR)/Memory/Dither.cpp
 endif
 
+ifeq ($(TARGET_IS_KOBO),y)
+SCREEN_SOURCES += \
+	$(SCREEN_SRC_DIR)/FB/FrameDamage.cpp
+endif
+
 ifeq ($(FREETYPE),y)
 SCREEN_SOURCES += \
 	$(SCREEN_SRC_DIR)/FreeType/Font.cpp \
+	$(SCREEN_SRC_DIR)/FreeType/GlyphCache.cpp \
 	$(SCREEN_SRC_DIR)/FreeType/Init.cpp
 endif
 
@@ -90,8 +96,10 @@ SCREEN_SOURCES += \
 	$(SCREEN_SRC_DIR)/OpenGL/TopCanvas.cpp \
 	$(SCREEN_SRC_DIR)/OpenGL/SubCanvas.cpp \
 	$(SCREEN_SRC_DIR)/OpenGL/Texture.cpp \
+	$(SCREEN_SRC_DIR)/OpenGL/GlyphAtlas.cpp \
 	$(SCREEN_SRC_DIR)/OpenGL/UncompressedImage.cpp \
 	$(SCREEN_SRC_DIR)/OpenGL/Buffer.cpp \
+	$(SCREEN_SRC_DIR)/OpenGL/LineBatch.cpp \
 	$(SCREEN_SRC_DIR)/OpenGL/Shapes.cpp \
 	$(SCREEN_SRC_DIR)/OpenGL/Surface.cpp \
 	$(SCREEN_SRC_DIR)/OpenGL/Triangulate.cpp
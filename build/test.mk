@@ -90,20 +90,24 @@ TEST_NAMES = \
 	test_pressure \
 	test_task \
 	TestOverwritingRingBuffer \
+	TestTripleBuffer \
+	TestIdleScheduler \
+	TestTracing \
+	TestThreadPool \
 	TestDateTime TestRoughTime TestWrapClock \
 	TestMathTables \
 	TestAngle TestARange \
 	TestUnits TestEarth TestSunEphemeris \
 	TestValidity TestUTM TestProfile \
 	TestAllocatedGrid \
-	TestRadixTree TestGeoBounds TestGeoClip \
+	TestRadixTree TestGeoBounds TestGeoClip TestSearchPointVector \
 	TestLogger TestGRecord TestDriver TestClimbAvCalc \
 	TestWaypointReader TestThermalBase \
 	TestFlarmNet \
-	TestColorRamp TestGeoPoint TestDiffFilter \
+	TestColorRamp TestPixelOperations TestGeoPoint TestDiffFilter \
 	TestFileUtil TestPolars TestCSVLine TestGlidePolar \
-	test_replay_task TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint \
-	TestMacCready TestOrderedTask TestAATPoint \
+	test_replay_task TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint TestFlatProjection \
+	TestMacCready TestGlideBatch TestWaypointReach TestOrderedTask TestAATPoint TestTaskAnalyticTarget \
 	TestPlanes \
 	TestTaskPoint \
 	TestTaskWaypoint \
@@ -124,6 +128,14 @@ TEST_NAMES = \
 	TestIGCFilenameFormatter \
 	TestLXNToIGC
 
+ifeq ($(HAVE_POSIX),y)
+TEST_NAMES += TestFrameDamage TestIOLoop
+endif
+
+ifeq ($(FREETYPE),y)
+TEST_NAMES += TestGlyphCache
+endif
+
 TESTS = $(call name-to-bin,$(TEST_NAMES))
 
 TEST_CRC_SOURCES = \
@@ -138,6 +150,51 @@ TEST_OVERWRITING_RING_BUFFER_SOURCES = \
 TEST_OVERWRITING_RING_BUFFER_DEPENDS = MATH
 $(eval $(call link-program,TestOverwritingRingBuffer,TEST_OVERWRITING_RING_BUFFER))
 
+TEST_TRIPLE_BUFFER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTripleBuffer.cpp
+TEST_TRIPLE_BUFFER_DEPENDS = THREAD
+$(eval $(call link-program,TestTripleBuffer,TEST_TRIPLE_BUFFER))
+
+TEST_IDLE_SCHEDULER_SOURCES = \
+	$(SRC)/Computer/IdleScheduler.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestIdleScheduler.cpp
+$(eval $(call link-program,TestIdleScheduler,TEST_IDLE_SCHEDULER))
+
+TEST_TRACING_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTracing.cpp
+TEST_TRACING_DEPENDS = THREAD OS
+$(eval $(call link-program,TestTracing,TEST_TRACING))
+
+TEST_THREAD_POOL_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestThreadPool.cpp
+TEST_THREAD_POOL_DEPENDS = THREAD OS
+$(eval $(call link-program,TestThreadPool,TEST_THREAD_POOL))
+
+TEST_FRAME_DAMAGE_SOURCES = \
+	$(SRC)/Screen/FB/FrameDamage.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFrameDamage.cpp
+TEST_FRAME_DAMAGE_CPPFLAGS = $(SCREEN_CPPFLAGS)
+$(eval $(call link-program,TestFrameDamage,TEST_FRAME_DAMAGE))
+
+TEST_GLYPH_CACHE_SOURCES = \
+	$(SRC)/Screen/Debug.cpp \
+	$(SRC)/Screen/Custom/Files.cpp \
+	$(SRC)/Screen/FreeType/Init.cpp \
+	$(SRC)/Screen/FreeType/Font.cpp \
+	$(SRC)/Screen/FreeType/GlyphCache.cpp \
+	$(TEST_SRC_DIR)/FakeAsset.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestGlyphCache.cpp
+TEST_GLYPH_CACHE_CPPFLAGS = $(SCREEN_CPPFLAGS)
+TEST_GLYPH_CACHE_LDLIBS = $(FREETYPE_LDLIBS)
+TEST_GLYPH_CACHE_DEPENDS = OS THREAD UTIL
+$(eval $(call link-program,TestGlyphCache,TEST_GLYPH_CACHE))
+
 TEST_IGC_PARSER_SOURCES = \
 	$(SRC)/IGC/IGCParser.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -214,6 +271,41 @@ TEST_MAC_CREADY_OBJS = $(call SRC_TO_OBJ,$(TEST_MAC_CREADY_SOURCES))
 TEST_MAC_CREADY_DEPENDS = GLIDE GEO MATH UTIL
 $(eval $(call link-program,TestMacCready,TEST_MAC_CREADY))
 
+TEST_GLIDE_BATCH_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/TestGlideBatch.cpp
+TEST_GLIDE_BATCH_DEPENDS = GLIDE GEO MATH UTIL
+$(eval $(call link-program,TestGlideBatch,TEST_GLIDE_BATCH))
+
+TEST_WAYPOINT_REACH_SOURCES = \
+	$(SRC)/Computer/WaypointReachComputer.cpp \
+	$(SRC)/Task/RoutePlannerGlue.cpp \
+	$(SRC)/Airspace/ActivePredicate.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(SRC)/NMEA/Derived.cpp \
+	$(SRC)/NMEA/MoreData.cpp \
+	$(SRC)/NMEA/Info.cpp \
+	$(SRC)/NMEA/Attitude.cpp \
+	$(SRC)/NMEA/Acceleration.cpp \
+	$(SRC)/NMEA/ExternalSettings.cpp \
+	$(SRC)/NMEA/SwitchState.cpp \
+	$(SRC)/NMEA/VarioInfo.cpp \
+	$(SRC)/NMEA/ClimbInfo.cpp \
+	$(SRC)/NMEA/CirclingInfo.cpp \
+	$(SRC)/NMEA/ClimbHistory.cpp \
+	$(SRC)/NMEA/ThermalBand.cpp \
+	$(SRC)/NMEA/ThermalLocator.cpp \
+	$(SRC)/NMEA/FlyingState.cpp \
+	$(SRC)/Engine/Navigation/TraceHistory.cpp \
+	$(SRC)/Engine/Navigation/Aircraft.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/TestWaypointReach.cpp
+TEST_WAYPOINT_REACH_DEPENDS = TASK ROUTE GLIDE WAYPOINT AIRSPACE TERRAIN IO ZZIP THREAD OS GEO TIME MATH UTIL
+$(eval $(call link-program,TestWaypointReach,TEST_WAYPOINT_REACH))
+
 TEST_ORDERED_TASK_SOURCES = \
 	$(SRC)/Engine/Navigation/Aircraft.cpp \
 	$(SRC)/Engine/Util/Gradient.cpp \
@@ -233,6 +325,17 @@ TEST_AAT_POINT_OBJS = $(call SRC_TO_OBJ,$(TEST_AAT_POINT_SOURCES))
 TEST_AAT_POINT_DEPENDS = TASK ROUTE GLIDE WAYPOINT GEO TIME MATH UTIL
 $(eval $(call link-program,TestAATPoint,TEST_AAT_POINT))
 
+TEST_TASK_ANALYTIC_TARGET_SOURCES = \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(SRC)/Engine/Navigation/Aircraft.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/FakeTaskState.cpp \
+	$(TEST_SRC_DIR)/TestTaskAnalyticTarget.cpp
+TEST_TASK_ANALYTIC_TARGET_OBJS = $(call SRC_TO_OBJ,$(TEST_TASK_ANALYTIC_TARGET_SOURCES))
+TEST_TASK_ANALYTIC_TARGET_DEPENDS = TASK ROUTE GLIDE WAYPOINT GEO TIME MATH UTIL
+$(eval $(call link-program,TestTaskAnalyticTarget,TEST_TASK_ANALYTIC_TARGET))
+
 TEST_PLANES_SOURCES = \
 	$(SRC)/Polar/Parser.cpp \
 	$(SRC)/Plane/PlaneFileGlue.cpp \
@@ -385,6 +488,12 @@ TEST_GEO_CLIP_SOURCES = \
 TEST_GEO_CLIP_DEPENDS = GEO MATH
 $(eval $(call link-program,TestGeoClip,TEST_GEO_CLIP))
 
+TEST_SEARCH_POINT_VECTOR_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSearchPointVector.cpp
+TEST_SEARCH_POINT_VECTOR_DEPENDS = GEO MATH
+$(eval $(call link-program,TestSearchPointVector,TEST_SEARCH_POINT_VECTOR))
+
 TEST_CLIMB_AV_CALC_SOURCES = \
 	$(SRC)/Computer/ClimbAverageCalculator.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -488,6 +597,7 @@ TEST_GLIDE_POLAR_SOURCES = \
 	$(ENGINE_SRC_DIR)/GlideSolvers/GlideResult.cpp \
 	$(ENGINE_SRC_DIR)/GlideSolvers/GlideState.cpp \
 	$(ENGINE_SRC_DIR)/GlideSolvers/MacCready.cpp \
+	$(ENGINE_SRC_DIR)/GlideSolvers/GlideBatch.cpp \
 	$(SRC)/Units/Descriptor.cpp \
 	$(SRC)/Units/System.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -526,6 +636,12 @@ TEST_FLAT_GEO_POINT_SOURCES = \
 TEST_FLAT_GEO_POINT_DEPENDS = GEO MATH
 $(eval $(call link-program,TestFlatGeoPoint,TEST_FLAT_GEO_POINT))
 
+TEST_FLAT_PROJECTION_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFlatProjection.cpp
+TEST_FLAT_PROJECTION_DEPENDS = GEO MATH
+$(eval $(call link-program,TestFlatProjection,TEST_FLAT_PROJECTION))
+
 TEST_FLAT_LINE_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestFlatLine.cpp
@@ -553,6 +669,12 @@ TEST_COLOR_RAMP_SOURCES = \
 TEST_COLOR_RAMP_CPPFLAGS = $(SCREEN_CPPFLAGS)
 $(eval $(call link-program,TestColorRamp,TEST_COLOR_RAMP))
 
+TEST_PIXEL_OPERATIONS_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestPixelOperations.cpp
+TEST_PIXEL_OPERATIONS_CPPFLAGS = $(SCREEN_CPPFLAGS)
+$(eval $(call link-program,TestPixelOperations,TEST_PIXEL_OPERATIONS))
+
 TEST_SUN_EPHEMERIS_SOURCES = \
 	$(SRC)/Math/SunEphemeris.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -704,6 +826,12 @@ DEBUG_PROGRAM_NAMES = \
 	FlightPath \
 	BenchmarkProjection \
 	BenchmarkFAITriangleSector \
+	BenchmarkLabelBlock \
+	BenchmarkRasterCanvas \
+	BenchmarkTaskDijkstra \
+	BenchmarkMacCready \
+	BenchmarkTaskManager \
+	BenchmarkAirspaceWarning \
 	DumpTextFile DumpTextZip DumpTextInflate WriteTextFile RunTextWriter \
 	DumpHexColor \
 	RunXMLParser \
@@ -768,6 +896,10 @@ DEBUG_PROGRAM_NAMES += \
 	FeedFlyNetData
 endif
 
+ifeq ($(FREETYPE),y)
+DEBUG_PROGRAM_NAMES += BenchmarkFont
+endif
+
 ifeq ($(TARGET),PC)
 DEBUG_PROGRAM_NAMES += \
   FeedFlyNetData
@@ -850,7 +982,7 @@ DEBUG_REPLAY_LDADD = \
 BENCHMARK_PROJECTION_SOURCES = \
 	$(SRC)/Projection/Projection.cpp \
 	$(TEST_SRC_DIR)/BenchmarkProjection.cpp
-BENCHMARK_PROJECTION_DEPENDS = MATH
+BENCHMARK_PROJECTION_DEPENDS = GEO MATH OS
 BENCHMARK_PROJECTION_CPPFLAGS = $(SCREEN_CPPFLAGS)
 $(eval $(call link-program,BenchmarkProjection,BENCHMARK_PROJECTION))
 
@@ -861,6 +993,94 @@ BENCHMARK_FAI_TRIANGLE_SECTOR_SOURCES = \
 BENCHMARK_FAI_TRIANGLE_SECTOR_DEPENDS = GEO MATH
 $(eval $(call link-program,BenchmarkFAITriangleSector,BENCHMARK_FAI_TRIANGLE_SECTOR))
 
+BENCHMARK_LABEL_BLOCK_SOURCES = \
+	$(SRC)/Waypoint/WaypointFileType.cpp \
+	$(SRC)/Waypoint/WaypointReaderBase.cpp \
+	$(SRC)/Waypoint/WaypointReader.cpp \
+	$(SRC)/Waypoint/WaypointReaderWinPilot.cpp \
+	$(SRC)/Waypoint/WaypointReaderFS.cpp \
+	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
+	$(SRC)/Waypoint/WaypointReaderSeeYou.cpp \
+	$(SRC)/Waypoint/WaypointReaderZander.cpp \
+	$(SRC)/Waypoint/WaypointReaderCompeGPS.cpp \
+	$(SRC)/Waypoint/Factory.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Compatibility/fmode.c \
+	$(SRC)/Operation/Operation.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/Projection/Projection.cpp \
+	$(SRC)/Renderer/LabelBlock.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/BenchmarkLabelBlock.cpp
+BENCHMARK_LABEL_BLOCK_LDADD = $(FAKE_LIBS)
+BENCHMARK_LABEL_BLOCK_DEPENDS = WAYPOINT IO OS THREAD ZZIP GEO MATH UTIL
+BENCHMARK_LABEL_BLOCK_CPPFLAGS = $(SCREEN_CPPFLAGS)
+$(eval $(call link-program,BenchmarkLabelBlock,BENCHMARK_LABEL_BLOCK))
+
+BENCHMARK_RASTER_CANVAS_SOURCES = \
+	$(TEST_SRC_DIR)/BenchmarkRasterCanvas.cpp
+BENCHMARK_RASTER_CANVAS_DEPENDS = OS
+BENCHMARK_RASTER_CANVAS_CPPFLAGS = $(SCREEN_CPPFLAGS)
+$(eval $(call link-program,BenchmarkRasterCanvas,BENCHMARK_RASTER_CANVAS))
+
+BENCHMARK_FONT_SOURCES = \
+	$(SRC)/Screen/Debug.cpp \
+	$(SRC)/Screen/Custom/Files.cpp \
+	$(SRC)/Screen/FreeType/Init.cpp \
+	$(SRC)/Screen/FreeType/Font.cpp \
+	$(SRC)/Screen/FreeType/GlyphCache.cpp \
+	$(TEST_SRC_DIR)/FakeAsset.cpp \
+	$(TEST_SRC_DIR)/BenchmarkFont.cpp
+BENCHMARK_FONT_CPPFLAGS = $(SCREEN_CPPFLAGS)
+BENCHMARK_FONT_LDLIBS = $(FREETYPE_LDLIBS)
+BENCHMARK_FONT_DEPENDS = OS THREAD UTIL
+$(eval $(call link-program,BenchmarkFont,BENCHMARK_FONT))
+
+BENCHMARK_TASK_DIJKSTRA_SOURCES = \
+	$(ENGINE_SRC_DIR)/Task/PathSolvers/TaskDijkstra.cpp \
+	$(ENGINE_SRC_DIR)/Task/PathSolvers/TaskDijkstraMin.cpp \
+	$(ENGINE_SRC_DIR)/Task/PathSolvers/TaskDijkstraMax.cpp \
+	$(TEST_SRC_DIR)/BenchmarkTaskDijkstra.cpp
+BENCHMARK_TASK_DIJKSTRA_DEPENDS = OS GEO MATH UTIL
+$(eval $(call link-program,BenchmarkTaskDijkstra,BENCHMARK_TASK_DIJKSTRA))
+
+BENCHMARK_MAC_CREADY_SOURCES = \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/BenchmarkMacCready.cpp
+BENCHMARK_MAC_CREADY_DEPENDS = GLIDE OS GEO MATH UTIL
+$(eval $(call link-program,BenchmarkMacCready,BENCHMARK_MAC_CREADY))
+
+BENCHMARK_TASK_MANAGER_SOURCES = \
+	$(SRC)/Engine/Navigation/Aircraft.cpp \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(SRC)/Task/Deserialiser.cpp \
+	$(SRC)/XML/Node.cpp \
+	$(SRC)/XML/Parser.cpp \
+	$(SRC)/XML/Writer.cpp \
+	$(SRC)/XML/DataNode.cpp \
+	$(SRC)/XML/DataNodeXML.cpp \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/FakeTaskState.cpp \
+	$(TEST_SRC_DIR)/BenchmarkTaskManager.cpp
+BENCHMARK_TASK_MANAGER_DEPENDS = TASK ROUTE WAYPOINT GLIDE GEO MATH IO OS UTIL TIME
+$(eval $(call link-program,BenchmarkTaskManager,BENCHMARK_TASK_MANAGER))
+
+BENCHMARK_AIRSPACE_WARNING_SOURCES = \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/Engine/Navigation/Aircraft.cpp \
+	$(SRC)/Engine/GlideSolvers/GlidePolar.cpp \
+	$(SRC)/Engine/GlideSolvers/PolarCoefficients.cpp \
+	$(SRC)/Engine/GlideSolvers/GlideResult.cpp \
+	$(SRC)/Engine/Task/Stats/TaskStats.cpp \
+	$(SRC)/Engine/Task/Stats/CommonStats.cpp \
+	$(SRC)/Engine/Task/Stats/ElementStat.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/BenchmarkAirspaceWarning.cpp
+BENCHMARK_AIRSPACE_WARNING_DEPENDS = AIRSPACE GEO MATH UTIL
+$(eval $(call link-program,BenchmarkAirspaceWarning,BENCHMARK_AIRSPACE_WARNING))
+
 DUMP_TEXT_FILE_SOURCES = \
 	$(TEST_SRC_DIR)/DumpTextFile.cpp
 DUMP_TEXT_FILE_DEPENDS = IO OS ZZIP UTIL
@@ -1091,7 +1311,7 @@ RUN_HEIGHT_MATRIX_SOURCES = \
 	$(SRC)/Operation/Operation.cpp \
 	$(TEST_SRC_DIR)/RunHeightMatrix.cpp
 RUN_HEIGHT_MATRIX_CPPFLAGS = $(SCREEN_CPPFLAGS)
-RUN_HEIGHT_MATRIX_DEPENDS = TERRAIN GEO MATH IO OS ZZIP UTIL
+RUN_HEIGHT_MATRIX_DEPENDS = TERRAIN GEO MATH IO OS THREAD ZZIP UTIL
 $(eval $(call link-program,RunHeightMatrix,RUN_HEIGHT_MATRIX))
 
 RUN_INPUT_PARSER_SOURCES = \
@@ -1734,6 +1954,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Airspace/AirspaceVisibility.cpp \
 	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
 	$(SRC)/Renderer/TransparentRendererCache.cpp \
+	$(SRC)/Renderer/OpaqueRendererCache.cpp \
 	$(SRC)/Renderer/AirspaceRendererSettings.cpp \
 	$(SRC)/Renderer/BackgroundRenderer.cpp \
 	$(SRC)/LocalPath.cpp \
@@ -1763,6 +1984,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Renderer/AirspaceRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRendererGL.cpp \
 	$(SRC)/Renderer/AirspaceRendererOther.cpp \
+	$(SRC)/Renderer/AirspaceVertexBuffer.cpp \
 	$(SRC)/Renderer/AirspaceLabelList.cpp \
 	$(SRC)/Renderer/AirspaceLabelRenderer.cpp \
 	$(SRC)/Renderer/BestCruiseArrowRenderer.cpp \
@@ -2244,9 +2466,11 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Computer/AverageVarioComputer.cpp \
 	$(SRC)/Computer/GlideRatioComputer.cpp \
 	$(SRC)/Computer/GlideComputer.cpp \
+	$(SRC)/Computer/IdleScheduler.cpp \
 	$(SRC)/Computer/GlideComputerBlackboard.cpp \
 	$(SRC)/Computer/TaskComputer.cpp \
 	$(SRC)/Computer/RouteComputer.cpp \
+	$(SRC)/Computer/WaypointReachComputer.cpp \
 	$(SRC)/Computer/GlideComputerAirData.cpp \
 	$(SRC)/Computer/WaveComputer.cpp \
 	$(SRC)/Computer/StatsComputer.cpp \
@@ -2449,6 +2673,14 @@ TEST_NOTIFY_SOURCES = \
 TEST_NOTIFY_DEPENDS = EVENT SCREEN MATH UTIL ASYNC OS THREAD
 $(eval $(call link-program,TestNotify,TEST_NOTIFY))
 
+TEST_IO_LOOP_SOURCES = \
+	$(SRC)/OS/LogError.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestIOLoop.cpp
+TEST_IO_LOOP_DEPENDS = PORT ASYNC LIBNET OS THREAD UTIL
+$(eval $(call link-program,TestIOLoop,TEST_IO_LOOP))
+
 FEED_NMEA_SOURCES = \
 	$(SRC)/Device/Port/ConfiguredPort.cpp \
 	$(SRC)/Device/Config.cpp \
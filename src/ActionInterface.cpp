@@ -47,13 +47,14 @@ void
 XCSoarInterface::ReceiveGPS()
 {
   {
-    ScopeLock protect(device_blackboard->mutex);
+    /* the MergeThread publishes snapshots, so we don't need to lock
+       the DeviceBlackboard */
+    TripleBuffer<MoreData> &basic = device_blackboard->UIBasic();
+    basic.Update();
 
-    ReadBlackboardBasic(device_blackboard->Basic());
+    ReadBlackboardBasic(basic.Front());
 
-    const NMEAInfo &real = device_blackboard->RealState();
-    Private::movement_detected = real.alive && real.gps.real &&
-      real.MovementDetected();
+    Private::movement_detected = device_blackboard->IsMovementDetected();
   }
 
   BroadcastGPSUpdate();
@@ -67,9 +68,14 @@ void
 XCSoarInterface::ReceiveCalculated()
 {
   {
-    ScopeLock protect(device_blackboard->mutex);
+    TripleBuffer<DerivedInfo> &calculated = device_blackboard->UICalculated();
+    calculated.Update();
+
+    ReadBlackboardCalculated(calculated.Front());
+  }
 
-    ReadBlackboardCalculated(device_blackboard->Calculated());
+  {
+    ScopeLock protect(device_blackboard->mutex);
     device_blackboard->ReadComputerSettings(GetComputerSettings());
   }
 
@@ -53,6 +53,13 @@ DeviceBlackboard::DeviceBlackboard()
 
   real_clock.Reset();
   replay_clock.Reset();
+
+  ui_basic.Reset(gps_info);
+  calculation_basic.Reset(gps_info);
+  map_basic.Reset(gps_info);
+  ui_calculated.Reset(calculated_info);
+  map_calculated.Reset(calculated_info);
+  movement_detected.store(false, std::memory_order_relaxed);
 }
 
 /**
@@ -207,6 +214,29 @@ DeviceBlackboard::ReadBlackboard(const DerivedInfo &derived_info)
   calculated_info = derived_info;
 }
 
+void
+DeviceBlackboard::UpdateMovementDetected()
+{
+  movement_detected.store(real_data.alive && real_data.gps.real &&
+                          real_data.MovementDetected(),
+                          std::memory_order_relaxed);
+}
+
+void
+DeviceBlackboard::PublishBasic()
+{
+  ui_basic.Publish(gps_info);
+  calculation_basic.Publish(gps_info);
+  map_basic.Publish(gps_info);
+}
+
+void
+DeviceBlackboard::PublishCalculated(const DerivedInfo &derived_info)
+{
+  ui_calculated.Publish(derived_info);
+  map_calculated.Publish(derived_info);
+}
+
 /**
  * in Sim mode, the simulator engine needs the airspeed info
  * that is generated in the Basic Computer and written to NMEAInfo
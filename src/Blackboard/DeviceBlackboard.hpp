@@ -29,8 +29,10 @@ Copyright_License {
 #include "Device/Simulator.hpp"
 #include "Device/Features.hpp"
 #include "Thread/Mutex.hpp"
+#include "Thread/TripleBuffer.hpp"
 #include "Time/WrapClock.hpp"
 
+#include <atomic>
 #include <cassert>
 
 class MultipleDevices;
@@ -79,6 +81,24 @@ class DeviceBlackboard
    */
   WrapClock real_clock, replay_clock;
 
+  /**
+   * Snapshots of #gps_info published by the MergeThread, one for each
+   * consumer thread.  Consumers pick them up without locking #mutex.
+   */
+  TripleBuffer<MoreData> ui_basic, calculation_basic, map_basic;
+
+  /**
+   * Snapshots of the CalculationThread's results, one for each
+   * consumer thread.
+   */
+  TripleBuffer<DerivedInfo> ui_calculated, map_calculated;
+
+  /**
+   * Has the real (non-simulated) GPS detected movement?  Published
+   * together with #ui_basic.
+   */
+  std::atomic<bool> movement_detected;
+
 public:
   Mutex mutex;
 
@@ -95,6 +115,59 @@ public:
   void ReadComputerSettings(const ComputerSettings &settings);
   void ReadSimulatorAirspeeds(const NMEAInfo &basic);
 
+  /**
+   * Refresh the flag returned by IsMovementDetected().  Called by the
+   * MergeThread; the caller must lock the blackboard.
+   */
+  void UpdateMovementDetected();
+
+  /**
+   * Publish a snapshot of #gps_info to all consumer threads.  Called
+   * by the MergeThread after it has released the blackboard lock;
+   * this is safe because no other thread modifies #gps_info.
+   */
+  void PublishBasic();
+
+  /**
+   * Publish a snapshot of calculated results to all consumer
+   * threads.  Called by the CalculationThread; the blackboard does
+   * not need to be locked.
+   */
+  void PublishCalculated(const DerivedInfo &derived_info);
+
+  /**
+   * The snapshots consumed by the UI thread.
+   */
+  TripleBuffer<MoreData> &UIBasic() {
+    return ui_basic;
+  }
+
+  TripleBuffer<DerivedInfo> &UICalculated() {
+    return ui_calculated;
+  }
+
+  /**
+   * The snapshots consumed by the CalculationThread.
+   */
+  TripleBuffer<MoreData> &CalculationBasic() {
+    return calculation_basic;
+  }
+
+  /**
+   * The snapshots consumed by the thread which renders the map.
+   */
+  TripleBuffer<MoreData> &MapBasic() {
+    return map_basic;
+  }
+
+  TripleBuffer<DerivedInfo> &MapCalculated() {
+    return map_calculated;
+  }
+
+  bool IsMovementDetected() const {
+    return movement_detected.load(std::memory_order_relaxed);
+  }
+
 protected:
   NMEAInfo &SetBasic() { return gps_info; }
   MoreData &SetMoreData() { return gps_info; }
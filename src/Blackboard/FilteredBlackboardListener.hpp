@@ -0,0 +1,49 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_FILTERED_BLACKBOARD_LISTENER_HPP
+#define XCSOAR_FILTERED_BLACKBOARD_LISTENER_HPP
+
+#include "ProxyBlackboardListener.hpp"
+#include "GenerationFilter.hpp"
+
+/**
+ * Forwards OnCalculatedUpdate() only if one of the specified
+ * #DerivedGenerations categories has changed.  All other events are
+ * forwarded unconditionally.
+ */
+class FilteredBlackboardListener
+  : public ProxyBlackboardListener, private GenerationFilter {
+public:
+  FilteredBlackboardListener(BlackboardListener &_next,
+                             DerivedGenerations::Mask categories)
+    :ProxyBlackboardListener(_next), GenerationFilter(categories) {}
+
+  using GenerationFilter::Reset;
+
+private:
+  virtual void OnCalculatedUpdate(const MoreData &basic,
+                                  const DerivedInfo &calculated);
+};
+
+#endif
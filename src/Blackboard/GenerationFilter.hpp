@@ -0,0 +1,73 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_GENERATION_FILTER_HPP
+#define XCSOAR_GENERATION_FILTER_HPP
+
+#include "NMEA/Derived.hpp"
+
+/**
+ * Remembers the #DerivedGenerations seen by a listener, and decides
+ * whether a new #DerivedInfo contains changes in the categories the
+ * listener is interested in.
+ */
+class GenerationFilter {
+  DerivedGenerations::Mask categories;
+
+  DerivedGenerations last;
+
+  bool initialised;
+
+public:
+  explicit GenerationFilter(DerivedGenerations::Mask _categories)
+    :categories(_categories), initialised(false) {}
+
+  bool IsFiltering() const {
+    return categories != DerivedGenerations::ALL;
+  }
+
+  /**
+   * Forget the previous state, so the next Check() call passes.
+   */
+  void Reset() {
+    initialised = false;
+  }
+
+  /**
+   * @return true if the listener shall be notified
+   */
+  bool Check(const DerivedInfo &calculated) {
+    if (!IsFiltering())
+      return true;
+
+    if (initialised &&
+        (calculated.generations.Compare(last) & categories) == 0)
+      return false;
+
+    last = calculated.generations;
+    initialised = true;
+    return true;
+  }
+};
+
+#endif
@@ -29,6 +29,7 @@ Copyright_License {
 #include "Hardware/CPU.hpp"
 #include "Device/Driver/ILEC.hpp"
 #include "Simulator.hpp"
+#include "Thread/Tracing.hpp"
 
 /**
  * Constructor of the CalculationThread class
@@ -64,16 +65,20 @@ CalculationThread::Tick()
   const ScopeLockCPU cpu;
 #endif
 
+  const ScopeTrace trace("CalculationThread::Tick");
+
   bool gps_updated;
 
-  // update and transfer master info to glide computer
+  // update and transfer master info to glide computer; the
+  // MergeThread publishes it without blocking us
   {
-    ScopeLock protect(device_blackboard->mutex);
+    TripleBuffer<MoreData> &basic = device_blackboard->CalculationBasic();
+    basic.Update();
 
-    gps_updated = device_blackboard->Basic().location_available.Modified(glide_computer.Basic().location_available);
+    gps_updated = basic.Front().location_available.Modified(glide_computer.Basic().location_available);
 
     // Copy data from DeviceBlackboard to GlideComputerBlackboard
-    glide_computer.ReadBlackboard(device_blackboard->Basic());
+    glide_computer.ReadBlackboard(basic.Front());
   }
 
   bool force;
@@ -107,6 +112,9 @@ CalculationThread::Tick()
       device_blackboard->ReadSimulatorAirspeeds(glide_computer.Basic());
   }
 
+  // hand the results to the UI and map threads, outside of the lock
+  device_blackboard->PublishCalculated(glide_computer.Calculated());
+
   // if (new GPS data)
   if (gps_updated || force)
     // inform map new data is ready.
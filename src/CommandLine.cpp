@@ -33,6 +33,7 @@ Copyright_License {
 #include "Util/StringAPI.hxx"
 #include "Util/NumberParser.hpp"
 #include "Asset.hpp"
+#include "Thread/Tracing.hpp"
 
 #ifdef WIN32
 #include <windows.h> /* for AllocConsole() */
@@ -52,6 +53,10 @@ namespace CommandLine {
   ReplayPathType replay_path;
 #endif
 
+#ifdef HAVE_CMDLINE_TRACE
+  TracePathType trace_path;
+#endif
+
   bool show_dialog_setup_quick = true;
 }
 
@@ -85,6 +90,11 @@ CommandLine::Parse(Args &args)
     } else if (StringIsEqual(s, "-replay=", 8)) {
       replay_path = s + 8;
 #endif
+#ifdef HAVE_CMDLINE_TRACE
+    } else if (StringIsEqual(s, "-trace=", 7)) {
+      trace_path = s + 7;
+      Tracing::Enable(true);
+#endif
 #ifdef SIMULATOR_AVAILABLE
     } else if (StringIsEqual(s, "-simulator")) {
       global_simulator_flag = true;
@@ -28,6 +28,7 @@ Copyright_License {
 class Args;
 
 typedef StaticString<256> ReplayPathType;
+typedef StaticString<256> TracePathType;
 
 namespace CommandLine {
 #ifndef _WIN32_WCE
@@ -50,6 +51,15 @@ extern bool show_dialog_setup_quick;
   extern ReplayPathType replay_path;
 #endif
 
+#if !defined(_WIN32_WCE)
+#define HAVE_CMDLINE_TRACE
+  /**
+   * If set, #Tracing is enabled on startup, and the events are
+   * written to this file on shutdown.
+   */
+  extern TracePathType trace_path;
+#endif
+
 /**
  * Reads and parses arguments/options from the command line
  * @param CommandLine command line argument string
@@ -32,19 +32,21 @@ ContestComputer::ContestComputer(const Trace &trace_full,
   contest_manager.SetIncremental(true);
 }
 
-void
+bool
 ContestComputer::Solve(const ContestSettings &settings,
                        ContestStatistics &contest_stats)
 {
   if (!settings.enable)
-    return;
+    return false;
 
   contest_manager.SetHandicap(settings.handicap);
   contest_manager.SetContest(settings.contest);
 
-  contest_manager.UpdateIdle();
+  bool result = contest_manager.UpdateIdle();
 
   contest_stats = contest_manager.GetStats();
+
+  return result;
 }
 
 bool
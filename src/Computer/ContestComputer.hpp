@@ -53,7 +53,10 @@ public:
     contest_manager.SetPredicted(predicted);
   }
 
-  void Solve(const ContestSettings &settings_computer,
+  /**
+   * @return true if the contest statistics have been modified
+   */
+  bool Solve(const ContestSettings &settings_computer,
              ContestStatistics &contest_stats);
 
   bool SolveExhaustive(const ContestSettings &settings_computer,
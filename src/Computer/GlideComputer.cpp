@@ -49,7 +49,8 @@ GlideComputer::GlideComputer(const Waypoints &_way_points,
   task_computer(task, _airspace_database, &warning_computer.GetManager()),
   waypoints(_way_points),
   retrospective(_way_points),
-  team_code_ref_id(-1)
+  team_code_ref_id(-1),
+  last_flarm_traffic(false)
 {
   events.SetComputer(*this);
   idle_clock.Update();
@@ -71,6 +72,7 @@ GlideComputer::ResetFlight(const bool full)
 
   cu_computer.Reset();
   warning_computer.Reset();
+  waypoint_reach_computer.Reset();
 
   trace_history_time.Reset();
 }
@@ -126,6 +128,11 @@ GlideComputer::ProcessGPS(bool force)
                                  force);
   task_computer.ProcessMoreTask(basic, calculated, GetComputerSettings());
 
+  waypoint_reach_computer.Compute(waypoints, basic, calculated,
+                                  settings.task,
+                                  settings.polar.glide_polar_task,
+                                  task_computer.GetRoutePlanner());
+
   if (!last_finished && calculated.ordered_task_stats.task_finished)
     OnFinishTask();
 
@@ -150,6 +157,13 @@ GlideComputer::ProcessGPS(bool force)
   // Calculate the bearing and range of the teammate
   CalculateTeammateBearingRange();
 
+  /* FLARM traffic moves with each update; only an empty list remains
+     unchanged */
+  const bool flarm_traffic = !basic.flarm.traffic.IsEmpty();
+  if (flarm_traffic || last_flarm_traffic)
+    calculated.generations.Bump(DerivedGenerations::FLARM);
+  last_flarm_traffic = flarm_traffic;
+
   vegavoice.Update(basic, Calculated(), GetComputerSettings().voice);
 
   // update basic trace history
@@ -174,24 +188,53 @@ GlideComputer::ProcessGPS(bool force)
  */
 void
 GlideComputer::ProcessIdle(bool exhaustive)
+{
+  idle_scheduler.Run([this, exhaustive](IdleScheduler::Item item){
+      ProcessIdleItem(item, exhaustive);
+    }, exhaustive);
+}
+
+void
+GlideComputer::ProcessIdleItem(IdleScheduler::Item item, bool exhaustive)
 {
   const MoreData &basic = Basic();
   DerivedInfo &calculated = SetCalculated();
 
-  // Log GPS fixes for internal usage
-  // (snail trail, stats, olc, ...)
-  stats_computer.DoLogging(basic, calculated);
-  log_computer.Run(basic, calculated, GetComputerSettings().logger);
-
-  task_computer.ProcessIdle(basic, calculated, GetComputerSettings(),
-                            exhaustive);
-
-  warning_computer.Update(GetComputerSettings(), basic,
-                          calculated, calculated.airspace_warnings);
-
-  // Calculate summary of flight
-  if (basic.location_available)
-    retrospective.UpdateSample(basic.location);
+  switch (item) {
+  case IdleScheduler::AIRSPACE:
+    if (warning_computer.Update(GetComputerSettings(), basic,
+                                calculated, calculated.airspace_warnings))
+      calculated.generations.Bump(DerivedGenerations::AIRSPACE);
+    break;
+
+  case IdleScheduler::LOGGER:
+    log_computer.Run(basic, calculated, GetComputerSettings().logger);
+    break;
+
+  case IdleScheduler::TASK:
+    task_computer.ProcessIdle(basic, calculated);
+    break;
+
+  case IdleScheduler::STATISTICS:
+    // Log GPS fixes for internal usage
+    // (snail trail, stats, olc, ...)
+    stats_computer.DoLogging(basic, calculated);
+    break;
+
+  case IdleScheduler::RETROSPECTIVE:
+    // Calculate summary of flight
+    if (basic.location_available)
+      retrospective.UpdateSample(basic.location);
+    break;
+
+  case IdleScheduler::CONTEST:
+    task_computer.ProcessContest(basic, calculated, GetComputerSettings(),
+                                 exhaustive);
+    break;
+
+  case IdleScheduler::COUNT:
+    gcc_unreachable();
+  }
 }
 
 bool
@@ -34,6 +34,8 @@ Copyright_License {
 #include "LogComputer.hpp"
 #include "WarningComputer.hpp"
 #include "CuComputer.hpp"
+#include "WaypointReachComputer.hpp"
+#include "IdleScheduler.hpp"
 #include "Compiler.h"
 #include "Engine/Contest/Solvers/Retrospective.hpp"
 
@@ -54,6 +56,7 @@ class GlideComputer : public GlideComputerBlackboard
   StatsComputer stats_computer;
   LogComputer log_computer;
   CuComputer cu_computer;
+  WaypointReachComputer waypoint_reach_computer;
 
   const Waypoints &waypoints;
 
@@ -63,8 +66,14 @@ class GlideComputer : public GlideComputerBlackboard
   GeoPoint team_code_ref_location;
 
   PeriodClock idle_clock;
+  IdleScheduler idle_scheduler;
   VegaVoice vegavoice;
 
+  /**
+   * Did the previous ProcessGPS() call see FLARM traffic?
+   */
+  bool last_flarm_traffic;
+
   /**
    * This object is used to check whether to update
    * DerivedInfo::trace_history.
@@ -101,6 +110,10 @@ public:
     ProcessIdle(true);
   }
 
+  const IdleScheduler &GetIdleScheduler() const {
+    return idle_scheduler;
+  }
+
   void OnStartTask();
   void OnFinishTask();
   void OnTransitionEnter();
@@ -133,6 +146,10 @@ public:
     return task_computer.GetProtectedRoutePlanner();
   }
 
+  const ProtectedWaypointReach &GetWaypointReach() const {
+    return waypoint_reach_computer.GetReach();
+  }
+
   void ClearAirspaces() {
     task_computer.ClearAirspaces();
   }
@@ -159,6 +176,10 @@ protected:
   void TakeoffLanding(bool last_flying);
 
 private:
+  /**
+   * Run one of the slow calculations, called by #idle_scheduler.
+   */
+  void ProcessIdleItem(IdleScheduler::Item item, bool exhaustive);
 
   /**
    * Fill the cache variable TeamCodeRefLocation.
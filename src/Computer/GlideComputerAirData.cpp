@@ -89,6 +89,8 @@ GlideComputerAirData::ProcessVertical(const MoreData &basic,
      CirclingComputer::Turning(); remember the old state so this
      method can check for modifications */
   const bool last_circling = calculated.circling;
+  const Validity last_wind_available = calculated.wind_available;
+  const auto last_wind_source = calculated.wind_source;
 
   auto_qnh.Process(basic, calculated, settings, waypoints);
 
@@ -104,6 +106,10 @@ GlideComputerAirData::ProcessVertical(const MoreData &basic,
   wind_computer.Select(settings.wind, basic, calculated);
   wind_computer.ComputeHeadWind(basic, calculated);
 
+  if (calculated.wind_available != last_wind_available ||
+      calculated.wind_source != last_wind_source)
+    calculated.generations.Bump(DerivedGenerations::WIND);
+
   thermallocator.Process(calculated.circling,
                          basic.time, basic.location,
                          basic.netto_vario,
@@ -131,6 +137,11 @@ GlideComputerAirData::ProcessVertical(const MoreData &basic,
                                  basic, calculated);
   circling_computer.MaxHeightGain(basic, calculated.flight, calculated);
   NextLegEqThermal(basic, calculated, settings);
+
+  /* while circling, the turn and climb statistics change with every
+     fix */
+  if (calculated.circling || last_circling)
+    calculated.generations.Bump(DerivedGenerations::CIRCLING);
 }
 
 inline void
@@ -32,7 +32,13 @@ void
 GlideComputerBlackboard::ResetFlight(const bool full)
 {
   gps_info.Reset();
+
+  /* keep the generation counters monotonic, so listeners notice
+     the reset */
+  const DerivedGenerations generations = calculated_info.generations;
   calculated_info.Reset();
+  calculated_info.generations = generations;
+  calculated_info.generations.BumpAll();
 }
 
 /**
@@ -65,12 +71,15 @@ void
 GlideComputerBlackboard::RestoreFinish()
 {
   const auto flight = calculated_info.flight;
+  const auto generations = calculated_info.generations;
 
   calculated_info = Finish_Derived_Info;
 
   /* retain some of the data to avoid confusing some of our subsystems
      (e.g. spurious takeoff/landing detection) */
   calculated_info.flight = flight;
+  calculated_info.generations = generations;
+  calculated_info.generations.BumpAll();
 }
 
 /**
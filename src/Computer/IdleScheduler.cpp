@@ -0,0 +1,99 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "IdleScheduler.hpp"
+
+#include <algorithm>
+
+#include <assert.h>
+#include <string.h>
+
+static constexpr IdleScheduler::ItemInfo item_info[IdleScheduler::COUNT] = {
+  { "airspace", true, 20000, 0 },
+  { "logger", true, 5000, 0 },
+  { "task", false, 20000, 2000000 },
+  /* must see every fix: StatsComputer::DoLogging() discards samples
+     after a jump of more than 200m */
+  { "statistics", true, 5000, 0 },
+  { "retrospective", false, 5000, 10000000 },
+  { "contest", false, 50000, 30000000 },
+};
+
+const IdleScheduler::ItemInfo &
+IdleScheduler::GetInfo(Item item)
+{
+  assert(item < COUNT);
+
+  return item_info[item];
+}
+
+void
+IdleScheduler::Reset()
+{
+  memset(stats, 0, sizeof(stats));
+}
+
+bool
+IdleScheduler::IsDue(Item item, uint64_t cycle_start, uint64_t now,
+                     bool exhaustive) const
+{
+  assert(item < COUNT);
+  assert(now >= cycle_start);
+
+  const ItemInfo &info = item_info[item];
+  const ItemStats &s = stats[item];
+
+  if (exhaustive || info.critical || s.last_run == 0)
+    return true;
+
+  if (now - s.last_run >= info.deadline_us)
+    /* overdue: don't let it starve */
+    return true;
+
+  return now - cycle_start + s.estimate_us <= cycle_budget_us;
+}
+
+void
+IdleScheduler::Done(Item item, uint64_t start, uint64_t end)
+{
+  assert(item < COUNT);
+  assert(end >= start);
+
+  const unsigned duration = unsigned(std::min<uint64_t>(end - start,
+                                                        0xffffffff));
+
+  ItemStats &s = stats[item];
+  ++s.runs;
+  if (duration > item_info[item].budget_us)
+    ++s.overruns;
+
+  s.last_us = duration;
+  s.max_us = std::max(s.max_us, duration);
+  s.total_us += duration;
+  s.estimate_us = s.runs > 1
+    ? unsigned((3 * uint64_t(s.estimate_us) + duration) / 4)
+    : duration;
+
+  /* never store 0, which means "never run" */
+  s.last_run = std::max<uint64_t>(start, 1);
+}
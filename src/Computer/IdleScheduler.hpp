@@ -0,0 +1,177 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IDLE_SCHEDULER_HPP
+#define XCSOAR_IDLE_SCHEDULER_HPP
+
+#include "OS/Clock.hpp"
+#include "Thread/Tracing.hpp"
+
+#include <stdint.h>
+
+/**
+ * Decides which of the slow calculations shall be run in
+ * GlideComputer::ProcessIdle().  Items are run in the order of their
+ * priority.  Critical items are run on every cycle; all others are
+ * deferred when the cycle's time budget has been used up, until
+ * their deadline has expired.
+ *
+ * All times are in microseconds, see MonotonicClockUS().
+ */
+class IdleScheduler {
+public:
+  /**
+   * The work items, sorted by priority (highest first).
+   */
+  enum Item : uint8_t {
+    AIRSPACE,
+    LOGGER,
+    TASK,
+    STATISTICS,
+    RETROSPECTIVE,
+    CONTEST,
+
+    COUNT
+  };
+
+  struct ItemInfo {
+    const char *name;
+
+    /**
+     * Critical items are never deferred.
+     */
+    bool critical;
+
+    /**
+     * The expected maximum duration of one run [us].  Runs which
+     * take longer are counted in ItemStats::overruns.
+     */
+    unsigned budget_us;
+
+    /**
+     * The item is run regardless of the cycle budget if it has not
+     * been run for this long [us].
+     */
+    unsigned deadline_us;
+  };
+
+  struct ItemStats {
+    unsigned runs, skips, overruns;
+
+    /**
+     * Duration of the last run and the longest run [us].
+     */
+    unsigned last_us, max_us;
+
+    uint64_t total_us;
+
+    /**
+     * Moving average of the run duration [us], used to decide
+     * whether the item fits into the remaining budget.
+     */
+    unsigned estimate_us;
+
+    /**
+     * Start time of the last run, 0 if it has never been run.
+     */
+    uint64_t last_run;
+
+    unsigned GetAverageUS() const {
+      return runs > 0 ? unsigned(total_us / runs) : 0;
+    }
+  };
+
+private:
+  /**
+   * The time budget of one ProcessIdle() cycle [us].
+   */
+  unsigned cycle_budget_us;
+
+  ItemStats stats[COUNT];
+
+public:
+  explicit IdleScheduler(unsigned _cycle_budget_us=100000)
+    :cycle_budget_us(_cycle_budget_us) {
+    Reset();
+  }
+
+  static const ItemInfo &GetInfo(Item item);
+
+  const ItemStats &GetStats(Item item) const {
+    return stats[item];
+  }
+
+  /**
+   * Clear all statistics and deadlines.
+   */
+  void Reset();
+
+  /**
+   * Shall the item be run now?  Does not modify the statistics.
+   *
+   * @param cycle_start the time the current cycle was started
+   * @param now the current time
+   * @param exhaustive run all items, ignoring the budget
+   */
+  bool IsDue(Item item, uint64_t cycle_start, uint64_t now,
+             bool exhaustive=false) const;
+
+  /**
+   * Record a run of the item.
+   */
+  void Done(Item item, uint64_t start, uint64_t end);
+
+  /**
+   * Record that the item has been deferred.
+   */
+  void Skip(Item item) {
+    ++stats[item].skips;
+  }
+
+  /**
+   * Run one cycle, calling f(item) for each item which is due.
+   */
+  template<typename F>
+  void Run(F &&f, bool exhaustive=false) {
+    const uint64_t cycle_start = MonotonicClockUS();
+
+    for (unsigned i = 0; i < COUNT; ++i) {
+      const Item item = Item(i);
+      const uint64_t start = MonotonicClockUS();
+
+      if (!IsDue(item, cycle_start, start, exhaustive)) {
+        Skip(item);
+        continue;
+      }
+
+      {
+        const ScopeTrace trace(GetInfo(item).name);
+        f(item);
+      }
+
+      Done(item, start, MonotonicClockUS());
+    }
+  }
+};
+
+#endif
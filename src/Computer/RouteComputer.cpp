@@ -28,6 +28,7 @@ Copyright_License {
 #include "NMEA/Derived.hpp"
 #include "NMEA/Aircraft.hpp"
 #include "Navigation/Aircraft.hpp"
+#include "Thread/Tracing.hpp"
 
 #include <algorithm>
 
@@ -70,6 +71,8 @@ RouteComputer::TerrainWarning(const MoreData &basic,
                               DerivedInfo &calculated,
                               const RoutePlannerConfig &config)
 {
+  const ScopeTrace trace("RouteComputer::TerrainWarning");
+
   const AircraftState as = ToAircraftState(basic, calculated);
 
   const GlideResult& sol = calculated.task_stats.current_leg.solution_remaining;
@@ -114,11 +117,13 @@ RouteComputer::TerrainWarning(const MoreData &basic,
         calculated.terrain_warning =
           route_planner.Intersection(start, dest,
                                      calculated.terrain_warning_location);
+        calculated.generations.Bump(DerivedGenerations::TERRAIN);
       }
       return;
     } else {
       protected_route_planner.SolveRoute(start, start, config, h_ceiling);
       calculated.planned_route = route_planner.GetSolution();
+      calculated.generations.Bump(DerivedGenerations::TERRAIN);
     }
   }
   calculated.terrain_warning = false;
@@ -128,6 +133,8 @@ inline void
 RouteComputer::Reach(const MoreData &basic, DerivedInfo &calculated,
                      const RoutePlannerConfig &config)
 {
+  const ScopeTrace trace("RouteComputer::Reach");
+
   if (!calculated.terrain_valid) {
     /* without valid terrain information, we cannot calculate
        reachabilty, so let's skip that step completely */
@@ -150,6 +157,8 @@ RouteComputer::Reach(const MoreData &basic, DerivedInfo &calculated,
       calculated.terrain_base = route_planner.GetTerrainBase();
       calculated.terrain_base_valid = true;
     }
+
+    calculated.generations.Bump(DerivedGenerations::TERRAIN);
   }
 }
 
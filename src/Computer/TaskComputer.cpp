@@ -107,6 +107,7 @@ TaskComputer::ProcessBasicTask(const MoreData &basic,
   calculated.ordered_task_stats = _task->GetOrderedTask().GetStats();
   calculated.common_stats = _task->GetCommonStats();
   calculated.glide_polar_safety = _task->GetSafetyPolar();
+  calculated.generations.Bump(DerivedGenerations::TASK);
 }
 
 void
@@ -154,19 +155,24 @@ Predicted(const ContestSettings &settings,
 }
 
 void
-TaskComputer::ProcessIdle(const MoreData &basic, DerivedInfo &calculated,
-                          const ComputerSettings &settings_computer,
-                          bool exhaustive)
+TaskComputer::ProcessContest(const MoreData &basic, DerivedInfo &calculated,
+                             const ComputerSettings &settings_computer,
+                             bool exhaustive)
 {
   contest.SetPredicted(Predicted(settings_computer.contest, basic,
                                  calculated.task_stats.current_leg));
 
-  if (exhaustive)
-    contest.SolveExhaustive(settings_computer.contest,
-                            calculated.contest_stats);
-  else
-    contest.Solve(settings_computer.contest, calculated.contest_stats);
+  const bool contest_modified = exhaustive
+    ? contest.SolveExhaustive(settings_computer.contest,
+                              calculated.contest_stats)
+    : contest.Solve(settings_computer.contest, calculated.contest_stats);
+  if (contest_modified)
+    calculated.generations.Bump(DerivedGenerations::CONTEST);
+}
 
+void
+TaskComputer::ProcessIdle(const MoreData &basic, const DerivedInfo &calculated)
+{
   const AircraftState as = ToAircraftState(basic, calculated);
 
   ProtectedTaskManager::ExclusiveLease _task(task);
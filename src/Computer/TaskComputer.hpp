@@ -68,6 +68,14 @@ public:
     return route.GetProtectedRoutePlanner();
   }
 
+  /**
+   * Returns a reference to the unprotected route planner object,
+   * which must not be used outside of the calculation thread.
+   */
+  const RoutePlannerGlue &GetRoutePlanner() const {
+    return route.GetRoutePlanner();
+  }
+
   void ClearAirspaces() {
     route.ClearAirspaces();
   }
@@ -114,9 +122,14 @@ public:
    */
   void ProcessAutoTask(const NMEAInfo &basic, const DerivedInfo &calculated);
 
-  void ProcessIdle(const MoreData &basic, DerivedInfo &calculated,
-                   const ComputerSettings &settings_computer,
-                   bool exhaustive=false);
+  /**
+   * Run the contest optimiser.
+   */
+  void ProcessContest(const MoreData &basic, DerivedInfo &calculated,
+                      const ComputerSettings &settings_computer,
+                      bool exhaustive=false);
+
+  void ProcessIdle(const MoreData &basic, const DerivedInfo &calculated);
 };
 
 #endif
@@ -36,14 +36,14 @@ WarningComputer::WarningComputer(Airspaces &_airspaces)
 {
 }
 
-void
+bool
 WarningComputer::Update(const ComputerSettings &settings_computer,
                         const MoreData &basic,
                         const DerivedInfo &calculated,
                         AirspaceWarningsInfo &result)
 {
   if (!basic.time_available)
-    return;
+    return false;
 
   const fixed dt = delta_time.Update(basic.time, fixed(1), fixed(20));
   if (negative(dt))
@@ -51,7 +51,7 @@ WarningComputer::Update(const ComputerSettings &settings_computer,
     Reset();
 
   if (!positive(dt))
-    return;
+    return false;
 
   airspaces.SetFlightLevels(settings_computer.pressure);
 
@@ -63,9 +63,10 @@ WarningComputer::Update(const ComputerSettings &settings_computer,
     if (initialised) {
       initialised = false;
       protected_manager.Clear();
+      return true;
     }
 
-    return;
+    return false;
   }
 
   const AircraftState as = ToAircraftState(basic, calculated);
@@ -78,9 +79,12 @@ WarningComputer::Update(const ComputerSettings &settings_computer,
     lease->Reset(as);
   }
 
-  if (lease->Update(as, settings_computer.polar.glide_polar_task,
-                    calculated.task_stats,
-                    calculated.circling,
-                    uround(dt)))
-    result.latest.Update(basic.clock);
+  if (!lease->Update(as, settings_computer.polar.glide_polar_task,
+                     calculated.task_stats,
+                     calculated.circling,
+                     uround(dt)))
+    return false;
+
+  result.latest.Update(basic.clock);
+  return true;
 }
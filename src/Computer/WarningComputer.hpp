@@ -63,7 +63,10 @@ public:
     initialised = false;
   }
 
-  void Update(const ComputerSettings &settings_computer,
+  /**
+   * @return true if the list of warnings has been modified
+   */
+  bool Update(const ComputerSettings &settings_computer,
               const MoreData &basic,
               const DerivedInfo &calculated,
               AirspaceWarningsInfo &result);
@@ -0,0 +1,228 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "WaypointReachComputer.hpp"
+#include "NMEA/MoreData.hpp"
+#include "NMEA/Derived.hpp"
+#include "Engine/Waypoint/Waypoint.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Waypoint/WaypointVisitor.hpp"
+#include "Engine/GlideSolvers/MacCready.hpp"
+#include "Geo/GeoVector.hpp"
+#include "Engine/Task/TaskBehaviour.hpp"
+#include "Task/RoutePlannerGlue.hpp"
+#include "Thread/Tracing.hpp"
+
+#include <algorithm>
+
+static bool
+CompareDistance(const WaypointReachComputer::Candidate &a,
+                const WaypointReachComputer::Candidate &b)
+{
+  return a.distance < b.distance;
+}
+
+/**
+ * Collects the nearest landable and watched waypoints.  Once the
+ * array is full, it is a max-heap by distance, and a nearer waypoint
+ * replaces the farthest one, so the result does not depend on the
+ * order in which the waypoints are visited.
+ */
+class WaypointReachCandidateVisitor final : public WaypointVisitor {
+  const GeoPoint location;
+
+  WaypointReachComputer::CandidateArray &candidates;
+
+public:
+  WaypointReachCandidateVisitor(const GeoPoint &_location,
+                                WaypointReachComputer::CandidateArray &_candidates)
+    :location(_location), candidates(_candidates) {}
+
+  void Visit(const Waypoint &wp) override {
+    if (!wp.IsLandable() && !wp.flags.watched)
+      return;
+
+    const WaypointReachComputer::Candidate candidate{
+      &wp, location.DistanceS(wp.location)
+    };
+
+    if (!candidates.full()) {
+      candidates.append(candidate);
+      if (candidates.full())
+        std::make_heap(candidates.begin(), candidates.end(),
+                       CompareDistance);
+    } else if (candidate.distance < candidates.front().distance) {
+      std::pop_heap(candidates.begin(), candidates.end(), CompareDistance);
+      candidates.back() = candidate;
+      std::push_heap(candidates.begin(), candidates.end(), CompareDistance);
+    }
+  }
+};
+
+void
+WaypointReachComputer::CollectCandidates(const Waypoints &waypoints,
+                                         const GeoPoint &location,
+                                         fixed range,
+                                         CandidateArray &candidates)
+{
+  candidates.clear();
+
+  WaypointReachCandidateVisitor visitor(location, candidates);
+  waypoints.VisitWithinRange(location, range, visitor);
+}
+
+/**
+ * Solve straight glides to all candidates at once.
+ */
+inline void
+WaypointReachComputer::SolveDirect(const MoreData &basic,
+                                   const SpeedVector &wind,
+                                   const MacCready &mac_cready,
+                                   const TaskBehaviour &task_behaviour)
+{
+  batch.Clear();
+
+  for (const Candidate &candidate : candidates) {
+    const Waypoint &waypoint = *candidate.waypoint;
+    const fixed elevation = waypoint.elevation +
+      task_behaviour.safety_height_arrival;
+    batch.Add(GeoVector(basic.location, waypoint.location),
+              basic.nav_altitude - elevation);
+  }
+
+  mac_cready.SolveStraight(batch, wind);
+}
+
+void
+WaypointReachComputer::Publish()
+{
+  ++next.version;
+
+  ProtectedWaypointReach::ExclusiveLease lease(reach);
+  lease->version = next.version;
+  lease->items = next.items;
+}
+
+void
+WaypointReachComputer::Reset()
+{
+  clock.Reset();
+
+  if (!next.items.empty()) {
+    next.items.clear();
+    Publish();
+  }
+}
+
+static void
+CalculateReachability(WaypointReachInfo::Item &item,
+                      const Waypoint &waypoint,
+                      const RoutePlannerGlue &route_planner,
+                      const TaskBehaviour &task_behaviour)
+{
+  const RoughAltitude elevation(waypoint.elevation +
+                                task_behaviour.safety_height_arrival);
+  const AGeoPoint p_dest(waypoint.location, elevation);
+  if (route_planner.FindPositiveArrival(p_dest, item.reach))
+    item.reach.Subtract(elevation);
+
+  if (!item.reach.IsReachableDirect())
+    item.reachable = WaypointReachInfo::Reachability::UNREACHABLE;
+  else if (task_behaviour.route_planner.IsReachEnabled() &&
+           !item.reach.IsReachableTerrain())
+    item.reachable = WaypointReachInfo::Reachability::STRAIGHT;
+  else
+    item.reachable = WaypointReachInfo::Reachability::TERRAIN;
+}
+
+void
+WaypointReachComputer::Compute(const Waypoints &waypoints,
+                               const MoreData &basic, DerivedInfo &calculated,
+                               const TaskBehaviour &task_behaviour,
+                               const GlidePolar &task_polar,
+                               const RoutePlannerGlue &route_planner)
+{
+  if (!basic.location_available || !basic.NavAltitudeAvailable()) {
+    if (!next.items.empty()) {
+      next.items.clear();
+      Publish();
+      calculated.generations.Bump(DerivedGenerations::TERRAIN);
+    }
+
+    return;
+  }
+
+  if (!clock.CheckAdvance(basic.time, fixed(PERIOD)))
+    return;
+
+  const ScopeTrace trace("WaypointReachComputer::Compute");
+
+  const GlidePolar &glide_polar =
+    task_behaviour.route_planner.reach_polar_mode == RoutePlannerConfig::Polar::TASK
+    ? task_polar
+    : calculated.glide_polar_safety;
+
+  /* nothing beyond twice the still-air glide range can be reached,
+     even with a strong tail wind */
+  fixed range = fixed(MIN_RANGE);
+  const fixed height = basic.nav_altitude -
+    calculated.GetTerrainBaseFallback();
+  if (positive(height) && glide_polar.IsValid())
+    range = std::max(range, 2 * height * glide_polar.GetBestLD());
+
+  CollectCandidates(waypoints, basic.location, range, candidates);
+
+  const bool use_route = !route_planner.IsReachEmpty();
+  const MacCready mac_cready(task_behaviour.glide, glide_polar);
+  const SpeedVector wind = calculated.GetWindOrZero();
+
+  if (!use_route)
+    SolveDirect(basic, wind, mac_cready, task_behaviour);
+
+  next.items.clear();
+  for (unsigned i = 0; i < candidates.size(); ++i) {
+    const Waypoint &waypoint = *candidates[i].waypoint;
+
+    WaypointReachInfo::Item &item = next.items.append();
+    item.waypoint_id = waypoint.id;
+    item.reachable = WaypointReachInfo::Reachability::UNREACHABLE;
+    item.reach.Clear();
+
+    if (use_route)
+      CalculateReachability(item, waypoint, route_planner, task_behaviour);
+    else if (batch.IsOk(i)) {
+      item.reach.direct = batch.GetAltitudeDifference(i);
+      if (positive(batch.GetAltitudeDifference(i)))
+        item.reachable = WaypointReachInfo::Reachability::TERRAIN;
+    }
+  }
+
+  std::sort(next.items.begin(), next.items.end(),
+            [](const WaypointReachInfo::Item &a,
+               const WaypointReachInfo::Item &b) {
+              return a.waypoint_id < b.waypoint_id;
+            });
+
+  Publish();
+  calculated.generations.Bump(DerivedGenerations::TERRAIN);
+}
@@ -0,0 +1,131 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_WAYPOINT_REACH_COMPUTER_HPP
+#define XCSOAR_WAYPOINT_REACH_COMPUTER_HPP
+
+#include "NMEA/WaypointReachInfo.hpp"
+#include "Engine/GlideSolvers/GlideBatch.hpp"
+#include "Time/GPSClock.hpp"
+#include "Util/StaticArray.hpp"
+#include "Math/fixed.hpp"
+
+struct Waypoint;
+struct GeoPoint;
+class Waypoints;
+struct MoreData;
+struct DerivedInfo;
+struct TaskBehaviour;
+class GlidePolar;
+class MacCready;
+class RoutePlannerGlue;
+struct SpeedVector;
+
+/**
+ * Calculates the arrival heights of the landable and watched
+ * waypoints near the aircraft into a #ProtectedWaypointReach, so the
+ * map renderer does not need to query the route planner.
+ */
+class WaypointReachComputer {
+  /**
+   * Minimum time between two updates [s].
+   */
+  static constexpr unsigned PERIOD = 1;
+
+  /**
+   * Waypoints within this range [m] are always considered, even if
+   * the glide range is smaller.
+   */
+  static constexpr unsigned MIN_RANGE = 50000;
+
+public:
+  struct Candidate {
+    const Waypoint *waypoint;
+    fixed distance;
+  };
+
+  /**
+   * The nearest #WaypointReachInfo::MAX_ITEMS candidates.
+   */
+  typedef StaticArray<Candidate, WaypointReachInfo::MAX_ITEMS> CandidateArray;
+
+private:
+  CandidateArray candidates;
+
+  /**
+   * The table being calculated; it is copied to #reach when
+   * finished.  Only accessed by the calculation thread.
+   */
+  WaypointReachInfo next;
+
+  ProtectedWaypointReach reach;
+
+  /**
+   * The straight glides to #candidates, used when there is no reach
+   * fan.
+   */
+  GlideBatch batch;
+
+  GPSClock clock;
+
+public:
+  WaypointReachComputer() {
+    next.Clear();
+  }
+
+  const ProtectedWaypointReach &GetReach() const {
+    return reach;
+  }
+
+  void Reset();
+
+  /**
+   * @param route_planner the route planner of the calculation
+   * thread; the reach fan is used if it is not empty
+   */
+  void Compute(const Waypoints &waypoints,
+               const MoreData &basic, DerivedInfo &calculated,
+               const TaskBehaviour &task_behaviour,
+               const GlidePolar &task_polar,
+               const RoutePlannerGlue &route_planner);
+
+  /**
+   * Collect the nearest #WaypointReachInfo::MAX_ITEMS landable and
+   * watched waypoints within the given range, in no particular order.
+   */
+  static void CollectCandidates(const Waypoints &waypoints,
+                                const GeoPoint &location, fixed range,
+                                CandidateArray &candidates);
+
+private:
+  /**
+   * Copy #next to #reach.
+   */
+  void Publish();
+
+  void SolveDirect(const MoreData &basic, const SpeedVector &wind,
+                   const MacCready &mac_cready,
+                   const TaskBehaviour &task_behaviour);
+};
+
+#endif
@@ -76,7 +76,7 @@ SocketPort::Set(SocketDescriptor &&_socket)
 
   /* register the socket in then IOThread or the SocketThread */
 #ifdef HAVE_POSIX
-  io_thread->LockAdd(socket.ToFileDescriptor(), Poll::READ, *this);
+  io_thread->LockAdd(socket.ToFileDescriptor(), IOThread::READ, *this);
 #else
   thread.Start(socket);
 #endif
@@ -66,7 +66,7 @@ TCPClientPort::Connect(const char *host, unsigned port)
 #ifdef HAVE_POSIX
   if (errno == EINPROGRESS) {
     connecting = std::move(s);
-    io_thread->LockAdd(connecting.ToFileDescriptor(), Poll::WRITE, *this);
+    io_thread->LockAdd(connecting.ToFileDescriptor(), IOThread::WRITE, *this);
     StateChanged();
     return true;
   }
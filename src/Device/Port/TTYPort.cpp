@@ -87,7 +87,7 @@ TTYPort::Open(const TCHAR *path, unsigned _baud_rate)
     return false;
 
   valid.store(true, std::memory_order_relaxed);
-  io_thread->LockAdd(tty.ToFileDescriptor(), Poll::READ, *this);
+  io_thread->LockAdd(tty.ToFileDescriptor(), IOThread::READ | IOThread::EDGE, *this);
   StateChanged();
   return true;
 }
@@ -99,7 +99,7 @@ TTYPort::OpenPseudo()
     return nullptr;
 
   valid.store(true, std::memory_order_relaxed);
-  io_thread->LockAdd(tty.ToFileDescriptor(), Poll::READ, *this);
+  io_thread->LockAdd(tty.ToFileDescriptor(), IOThread::READ | IOThread::EDGE, *this);
   StateChanged();
   return tty.GetSlaveName();
 }
@@ -270,15 +270,22 @@ TTYPort::OnFileEvent(gcc_unused FileDescriptor fd, unsigned mask)
 {
   char buffer[1024];
 
-  ssize_t nbytes = tty.Read(buffer, sizeof(buffer));
-  if (nbytes == 0 || (nbytes < 0 && errno != EAGAIN && errno != EINTR)) {
-    valid.store(false, std::memory_order_relaxed);
-    StateChanged();
-    return false;
-  }
+  /* the descriptor is registered edge-triggered, therefore we must
+     read until the kernel buffer is empty */
+  while (true) {
+    ssize_t nbytes = tty.Read(buffer, sizeof(buffer));
+    if (nbytes < 0 && errno == EINTR)
+      continue;
 
-  if (nbytes > 0)
-    BufferedPort::DataReceived(buffer, nbytes);
+    if (nbytes < 0 && errno == EAGAIN)
+      return true;
 
-  return true;
+    if (nbytes <= 0) {
+      valid.store(false, std::memory_order_relaxed);
+      StateChanged();
+      return false;
+    }
+
+    BufferedPort::DataReceived(buffer, nbytes);
+  }
 }
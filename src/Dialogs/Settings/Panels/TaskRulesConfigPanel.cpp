@@ -34,6 +34,7 @@ enum ControlIndex {
   StartMaxSpeedMargin,
   StartMaxHeightMargin,
   AATTimeMargin,
+  AATTargetOptimiser,
   ContestNationality,
 };
 
@@ -53,6 +54,16 @@ static constexpr StaticEnumChoice  task_rules_types[] = {
   { 0 }
 };
 
+static constexpr StaticEnumChoice target_optimiser_list[] = {
+  { (unsigned)TaskBehaviour::TargetOptimiser::ZERO_FINDER, N_("Search"),
+    N_("Search the target range with a full task glide solution per step.  "
+       "Runs in the background.") },
+  { (unsigned)TaskBehaviour::TargetOptimiser::ANALYTIC, N_("Analytic"),
+    N_("Calculate the target range from the time per metre of each leg.  "
+       "Cheap enough to follow every GPS fix.") },
+  { 0 }
+};
+
 void
 TaskRulesConfigPanel::Prepare(ContainerWindow &parent, const PixelRect &rc)
 {
@@ -79,6 +90,13 @@ TaskRulesConfigPanel::Prepare(ContainerWindow &parent, const PixelRect &rc)
           0, 30 * 60, 60, (unsigned)task_behaviour.optimise_targets_margin);
   SetExpertRow(AATTimeMargin);
 
+  AddEnum(_("Target optimiser"),
+          _("How AAT targets are moved to complete the task at the minimum "
+            "time plus the optimisation margin."),
+          target_optimiser_list,
+          (unsigned)task_behaviour.target_optimiser);
+  SetExpertRow(AATTargetOptimiser);
+
   AddEnum(_("Task rules"),
           _("Fly contest with US contest rules or with FAI contest rules"),
           task_rules_types,
@@ -99,6 +117,9 @@ TaskRulesConfigPanel::Save(bool &_changed)
   changed |= SaveValue(StartMaxHeightMargin, UnitGroup::ALTITUDE, ProfileKeys::StartMaxHeightMargin,
                        task_behaviour.start_margins.max_height_margin);
 
+  changed |= SaveValueEnum(AATTargetOptimiser, ProfileKeys::AATTargetOptimiser,
+                           task_behaviour.target_optimiser);
+
   changed |= SaveValueEnum(ContestNationality, ProfileKeys::ContestNationality,
                            task_behaviour.contest_nationality);
 
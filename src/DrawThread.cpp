@@ -27,6 +27,7 @@ Copyright_License {
 
 #include "MapWindow/GlueMapWindow.hpp"
 #include "Hardware/CPU.hpp"
+#include "Thread/Tracing.hpp"
 
 /**
  * Main loop of the DrawThread
@@ -74,11 +75,15 @@ DrawThread::Run()
       const ScopeLockCPU cpu;
 #endif
 
-      // Get data from the DeviceBlackboard
-      map.ExchangeBlackboard();
+      {
+        const ScopeTrace trace("DrawThread::Repaint");
 
-      // Draw the moving map
-      map.Repaint();
+        // Get data from the DeviceBlackboard
+        map.ExchangeBlackboard();
+
+        // Draw the moving map
+        map.Repaint();
+      }
 
       if (trigger.Test()) {
         // interrupt re-calculation of bounds if there was a 
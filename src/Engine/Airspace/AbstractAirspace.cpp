@@ -213,14 +213,22 @@ AbstractAirspace::MatchNamePrefix(const TCHAR *prefix) const
 void
 AbstractAirspace::Project(const FlatProjection &projection)
 {
+  if (projection.GetCenter() == projection_center)
+    return;
+
   m_border.Project(projection);
+  flat_bounds = m_border.CalculateBoundingbox();
+  projection_center = projection.GetCenter();
+
+  /* the clearance was built with the old projection */
+  ClearClearance();
 }
 
 const FlatBoundingBox
 AbstractAirspace::GetBoundingBox(const FlatProjection &projection)
 {
   Project(projection);
-  return m_border.CalculateBoundingbox();
+  return flat_bounds;
 }
 
 GeoBounds
@@ -259,7 +267,9 @@ AbstractAirspace::GetClearance(const FlatProjection &projection) const
 void
 AbstractAirspace::ClearClearance() const
 {
-  m_clearance.clear();
+  /* release the memory, too; only the few airspaces near the current
+     route need a clearance */
+  SearchPointVector().swap(m_clearance);
 }
 
 void
@@ -29,6 +29,7 @@
 #include "AirspaceActivity.hpp"
 #include "Geo/GeoPoint.hpp"
 #include "Geo/SearchPointVector.hpp"
+#include "Geo/Flat/FlatBoundingBox.hpp"
 #include "Compiler.h"
 
 #ifdef DO_PRINT
@@ -42,7 +43,6 @@ struct AltitudeState;
 class AtmosphericPressure;
 class AirspaceAircraftPerformance;
 struct AirspaceInterceptSolution;
-class FlatBoundingBox;
 class FlatProjection;
 class AirspaceIntersectionVector;
 
@@ -82,10 +82,22 @@ protected:
   /** Convex clearance border */
   mutable SearchPointVector m_clearance;
 
+  /**
+   * Center of the projection which the flat locations of #m_border,
+   * #m_clearance and #flat_bounds were calculated with; invalid if
+   * they have not been projected yet.
+   */
+  GeoPoint projection_center;
+
+  /** Flat bounding box of #m_border */
+  FlatBoundingBox flat_bounds;
+
   AirspaceActivity days_of_operation;
 
 public:
-  AbstractAirspace(Shape _shape):shape(_shape), active(true) {}
+  AbstractAirspace(Shape _shape)
+    :shape(_shape), active(true),
+     projection_center(GeoPoint::Invalid()) {}
   virtual ~AbstractAirspace();
 
   Shape GetShape() const {
@@ -349,9 +361,10 @@ public:
 
   /**
    * On-demand access of clearance border.  Generated on call,
-   * to deallocate, call clear_clearance().  Uses mutable object
+   * to deallocate, call ClearClearance().  Uses mutable object
    * and const methods to allow visitors to generate them on demand
-   * from within a visit method.
+   * from within a visit method.  It is discarded when the border is
+   * projected with a different projection.
    */
   gcc_pure
   const SearchPointVector &GetClearance(const FlatProjection &projection) const;
@@ -363,7 +376,11 @@ public:
   }
 
 protected:
-  /** Project border */
+  /**
+   * Project border.  This does nothing if it has already been
+   * projected with the same projection, e.g. by the master #Airspaces
+   * object if this airspace is shared with AirspaceRoute.
+   */
   void Project(const FlatProjection &tp);
 
 private:
@@ -67,6 +67,11 @@ class AirspaceAircraftPerformance {
 public:
   struct Simple {};
 
+  /**
+   * Non-initialising constructor.
+   */
+  AirspaceAircraftPerformance() = default;
+
   /**
    * Simplified aircraft performance model used for testing of
    * airspace warning system with minimal dependencies.
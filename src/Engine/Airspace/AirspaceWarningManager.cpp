@@ -28,6 +28,10 @@
 #include "AirspaceAircraftPerformance.hpp"
 #include "Task/Stats/TaskStats.hpp"
 #include "Predicate/AirspacePredicateAircraftInside.hpp"
+#include "Geo/Flat/FlatProjection.hpp"
+#include "Geo/Flat/FlatRay.hpp"
+
+#include <algorithm>
 
 #define CRUISE_FILTER_FACT fixed(0.5)
 
@@ -136,9 +140,12 @@ AirspaceWarningManager::Update(const AircraftState& state,
 
   // check from strongest to weakest alerts
   UpdateInside(state, glide_polar);
-  UpdateGlide(state, glide_polar);
-  UpdateFilter(state, circling);
-  UpdateTask(state, glide_polar, task_stats);
+
+  PredictionList predictions;
+  PredictGlide(state, glide_polar, predictions);
+  PredictFilter(state, circling, predictions);
+  PredictTask(state, glide_polar, task_stats, predictions);
+  UpdatePredicted(state, predictions);
 
   // action changes
   for (auto it = warnings.begin(), end = warnings.end(); it != end;) {
@@ -271,18 +278,36 @@ private:
 };
 
 
-bool 
-AirspaceWarningManager::UpdatePredicted(const AircraftState& state, 
-                                         const GeoPoint &location_predicted,
-                                         const AirspaceAircraftPerformance &perf,
-                                         const AirspaceWarning::State warning_state,
-                                         const fixed max_time) 
+/**
+ * Selects the airspaces which #AirspaceIntersectionWarningVisitor
+ * would not ignore anyway, before the more expensive geometric tests.
+ */
+class AirspaceWarningPredicate final : public AirspacePredicate {
+  const AirspaceWarningConfig &config;
+  const AltitudeState &state;
+  const fixed max_alt;
+
+public:
+  AirspaceWarningPredicate(const AirspaceWarningConfig &_config,
+                           const AltitudeState &_state,
+                           const fixed _max_alt)
+    :config(_config), state(_state), max_alt(_max_alt) {}
+
+  bool operator()(const AbstractAirspace &airspace) const override {
+    return airspace.IsActive() &&
+      config.IsClassEnabled(airspace.GetType()) &&
+      (!positive(max_alt) || airspace.GetBaseAltitude(state) <= max_alt);
+  }
+};
+
+bool
+AirspaceWarningManager::UpdatePredicted(const AircraftState &state,
+                                        const PredictionList &predictions)
 {
-  // this is the time limit of intrusions, beyond which we are not interested.
-  // it can be the minimum of the user set warning time, or the time of the 
-  // task segment
+  assert(predictions.size() <= MAX_PREDICTIONS);
 
-  const fixed max_time_limit = std::min(fixed(config.warning_time), max_time);
+  if (predictions.empty())
+    return false;
 
   // the ceiling is the max height for predicted intrusions, given
   // that you may be climbing.  the ceiling is nominally set at 1000m
@@ -295,37 +320,81 @@ AirspaceWarningManager::UpdatePredicted(const AircraftState& state,
   const fixed ceiling = state.altitude
     + fixed(std::max((unsigned)1000, config.altitude_warning_margin));
 
-  AirspaceIntersectionWarningVisitor visitor(state, perf, 
-                                             *this, 
-                                             warning_state, max_time_limit,
-                                             ceiling);
+  // one query for the corridor swept by all predicted tracks
+
+  static_assert(MAX_PREDICTIONS <= Airspaces::MAX_SWEPT_TRACKS,
+                "Too many predictions for Airspaces::ScanSwept()");
 
-  airspaces.VisitIntersecting(state.location, location_predicted, visitor);
+  GeoPoint ends[MAX_PREDICTIONS];
+  for (unsigned i = 0; i < predictions.size(); ++i)
+    ends[i] = predictions[i].location;
+
+  const AirspaceWarningPredicate condition(config, state, ceiling);
+  Airspaces::AirspaceVector candidates =
+    airspaces.ScanSwept(state.location, ends, predictions.size(), condition);
+  if (candidates.empty())
+    return false;
 
-  visitor.SetMode(true);
-  airspaces.VisitInside(state.location, visitor);
+  // move the airspaces the aircraft is inside to the front
+  const auto inside_end =
+    std::partition(candidates.begin(), candidates.end(),
+                   [&state](const Airspace &i){
+                     return i.IsInside(state.location);
+                   });
 
-  return visitor.Found();
+  const FlatProjection &projection = GetProjection();
+  const FlatGeoPoint origin = projection.ProjectInteger(state.location);
+
+  bool found = false;
+  for (const auto &p : predictions) {
+    // this is the time limit of intrusions, beyond which we are not
+    // interested.  it can be the minimum of the user set warning time,
+    // or the time of the task segment
+
+    const fixed max_time_limit = std::min(fixed(config.warning_time),
+                                          p.max_time);
+
+    AirspaceIntersectionWarningVisitor visitor(state, p.perf,
+                                               *this,
+                                               p.warning_state, max_time_limit,
+                                               ceiling);
+
+    const FlatRay ray(origin, projection.ProjectInteger(p.location));
+    for (const auto &i : candidates)
+      if (i.Intersects(ray) &&
+          visitor.SetIntersections(i.Intersects(state.location, p.location,
+                                                projection)))
+        visitor.Visit(i);
+
+    visitor.SetMode(true);
+    for (auto i = candidates.begin(); i != inside_end; ++i)
+      visitor.Visit(*i);
+
+    found |= visitor.Found();
+  }
+
+  return found;
 }
 
 
-bool 
-AirspaceWarningManager::UpdateTask(const AircraftState &state,
-                                   const GlidePolar &glide_polar,
-                                   const TaskStats &task_stats)
+void
+AirspaceWarningManager::PredictTask(const AircraftState &state,
+                                    const GlidePolar &glide_polar,
+                                    const TaskStats &task_stats,
+                                    PredictionList &predictions) const
 {
   if (!glide_polar.IsValid())
-    return false;
+    return;
 
   const ElementStat &current_leg = task_stats.current_leg;
 
   if (!task_stats.task_valid || !current_leg.location_remaining.IsValid())
-    return false;
+    return;
 
   const GlideResult &solution = current_leg.solution_remaining;
   if (!solution.IsOk() || !solution.IsAchievable())
     /* glide solver failed, cannot continue */
-    return false;
+    return;
 
   const AirspaceAircraftPerformance perf_task(glide_polar,
                                               current_leg.solution_remaining);
@@ -339,13 +408,15 @@ AirspaceWarningManager::UpdateTask(const AircraftState &state,
        the configured warning time */
     location_tp = state.location.IntermediatePoint(location_tp, max_distance);
 
-  return UpdatePredicted(state, location_tp, perf_task,
-                          AirspaceWarning::WARNING_TASK, time_remaining);
+  predictions.push_back({location_tp, perf_task,
+                         AirspaceWarning::WARNING_TASK, time_remaining});
 }
 
 
-bool 
-AirspaceWarningManager::UpdateFilter(const AircraftState& state, const bool circling)
+void
+AirspaceWarningManager::PredictFilter(const AircraftState& state,
+                                      const bool circling,
+                                      PredictionList &predictions)
 {
   // update both filters even though we are using only one
   cruise_filter.Update(state);
@@ -355,31 +426,34 @@ AirspaceWarningManager::UpdateFilter(const AircraftState& state, const bool circ
     circling_filter.GetPredictedState(prediction_time_filter).location:
     cruise_filter.GetPredictedState(prediction_time_filter).location;
 
-  if (circling) 
-    return UpdatePredicted(state, location_predicted,
+  if (circling)
+    predictions.push_back({location_predicted,
                            AirspaceAircraftPerformance(circling_filter),
-                            AirspaceWarning::WARNING_FILTER, prediction_time_filter);
+                           AirspaceWarning::WARNING_FILTER,
+                           prediction_time_filter});
   else
-    return UpdatePredicted(state, location_predicted,
+    predictions.push_back({location_predicted,
                            AirspaceAircraftPerformance(cruise_filter),
-                            AirspaceWarning::WARNING_FILTER, prediction_time_filter);
+                           AirspaceWarning::WARNING_FILTER,
+                           prediction_time_filter});
 }
 
 
-bool 
-AirspaceWarningManager::UpdateGlide(const AircraftState &state,
-                                    const GlidePolar &glide_polar)
+void
+AirspaceWarningManager::PredictGlide(const AircraftState &state,
+                                     const GlidePolar &glide_polar,
+                                     PredictionList &predictions) const
 {
   if (!glide_polar.IsValid())
-    return false;
+    return;
 
   const GeoPoint location_predicted = 
     state.GetPredictedState(prediction_time_glide).location;
 
   const AirspaceAircraftPerformance perf_glide(glide_polar);
-  return UpdatePredicted(state, location_predicted,
-                          perf_glide,
-                          AirspaceWarning::WARNING_GLIDE, prediction_time_glide);
+  predictions.push_back({location_predicted, perf_glide,
+                         AirspaceWarning::WARNING_GLIDE,
+                         prediction_time_glide});
 }
 
 
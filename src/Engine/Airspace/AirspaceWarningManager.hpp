@@ -24,7 +24,9 @@
 
 #include "AirspaceWarning.hpp"
 #include "AirspaceWarningConfig.hpp"
+#include "AirspaceAircraftPerformance.hpp"
 #include "Util/AircraftStateFilter.hpp"
+#include "Util/StaticArray.hpp"
 #include "Compiler.h"
 
 #include <list>
@@ -33,7 +35,6 @@ class TaskStats;
 class GlidePolar;
 class Airspaces;
 class FlatProjection;
-class AirspaceAircraftPerformance;
 
 /**
  * Class to detect and track airspace warnings
@@ -260,17 +261,40 @@ public:
   bool IsActive(const AbstractAirspace &airspace) const;
 
 private:
-  bool UpdateTask(const AircraftState &state, const GlidePolar &glide_polar,
-                  const TaskStats &task_stats);
-  bool UpdateFilter(const AircraftState& state, const bool circling);
-  bool UpdateGlide(const AircraftState& state, const GlidePolar &glide_polar);
+  /**
+   * A straight track from the aircraft's location to a predicted
+   * location, which is checked for airspace intrusions.
+   */
+  struct Prediction {
+    GeoPoint location;
+    AirspaceAircraftPerformance perf;
+    AirspaceWarning::State warning_state;
+
+    /** Time limit of intrusions (s) */
+    fixed max_time;
+  };
+
+  /** There is one prediction each for glide, filter and task */
+  static constexpr unsigned MAX_PREDICTIONS = 3;
+
+  typedef StaticArray<Prediction, MAX_PREDICTIONS> PredictionList;
+
+  void PredictTask(const AircraftState &state, const GlidePolar &glide_polar,
+                   const TaskStats &task_stats,
+                   PredictionList &predictions) const;
+  void PredictFilter(const AircraftState& state, const bool circling,
+                     PredictionList &predictions);
+  void PredictGlide(const AircraftState& state, const GlidePolar &glide_polar,
+                    PredictionList &predictions) const;
   bool UpdateInside(const AircraftState& state, const GlidePolar &glide_polar);
 
-  bool UpdatePredicted(const AircraftState& state, 
-                       const GeoPoint &location_predicted,
-                       const AirspaceAircraftPerformance &perf,
-                       const AirspaceWarning::State warning_state,
-                       const fixed max_time);
+  /**
+   * Check all predictions for intrusions.  The airspace index is
+   * searched only once for the region swept by all predicted tracks,
+   * and intercepts are only calculated for the airspaces found there.
+   */
+  bool UpdatePredicted(const AircraftState& state,
+                       const PredictionList &predictions);
 };
 
 #endif
@@ -112,6 +112,31 @@ Airspaces::VisitIntersecting(const GeoPoint &loc, const GeoPoint &end,
 #endif
 }
 
+class SweptAirspaceVisitor {
+  const AirspacePredicate *condition;
+  const StaticArray<FlatRay, Airspaces::MAX_SWEPT_TRACKS> *rays;
+  Airspaces::AirspaceVector *result;
+
+public:
+  SweptAirspaceVisitor(const AirspacePredicate &_condition,
+                       const StaticArray<FlatRay,
+                                         Airspaces::MAX_SWEPT_TRACKS> &_rays,
+                       Airspaces::AirspaceVector &_result)
+    :condition(&_condition), rays(&_rays), result(&_result) {}
+
+  void operator()(const Airspace &v) {
+    if (!(*condition)(v.GetAirspace()))
+      return;
+
+    for (const auto &ray : *rays) {
+      if (v.Intersects(ray)) {
+        result->push_back(v);
+        return;
+      }
+    }
+  }
+};
+
 // SCAN METHODS
 
 const Airspaces::AirspaceVector
@@ -144,6 +169,40 @@ Airspaces::ScanRange(const GeoPoint &location, fixed range,
   return res;
 }
 
+const Airspaces::AirspaceVector
+Airspaces::ScanSwept(const GeoPoint &location,
+                     const GeoPoint *ends, unsigned n,
+                     const AirspacePredicate &condition) const
+{
+  assert(n <= MAX_SWEPT_TRACKS);
+
+  if (IsEmpty() || n == 0)
+    // nothing to do
+    return AirspaceVector();
+
+  // the bounding box of all tracks
+  Airspace bb_target(location, task_projection);
+  const FlatGeoPoint origin = task_projection.ProjectInteger(location);
+
+  StaticArray<FlatRay, MAX_SWEPT_TRACKS> rays;
+  for (unsigned i = 0; i < n; ++i) {
+    const FlatGeoPoint end = task_projection.ProjectInteger(ends[i]);
+    bb_target.Expand(end);
+    rays.append(FlatRay(origin, end));
+  }
+
+#ifdef INSTRUMENT_TASK
+  n_queries++;
+#endif
+
+  AirspaceVector res;
+
+  SweptAirspaceVisitor visitor(condition, rays, res);
+  airspace_tree.visit_within_range(bb_target, 0, visitor);
+
+  return res;
+}
+
 const Airspaces::AirspaceVector
 Airspaces::FindInside(const AircraftState &state,
                       const AirspacePredicate &condition) const
@@ -247,6 +306,8 @@ Airspaces::Clear()
 
   // then delete the tree
   airspace_tree.clear();
+
+  ++serial;
 }
 
 unsigned
@@ -27,6 +27,7 @@
 #include "AirspaceActivity.hpp"
 #include "Predicate/AirspacePredicate.hpp"
 #include "Util/Serial.hpp"
+#include "Util/StaticArray.hpp"
 #include "Geo/Flat/TaskProjection.hpp"
 #include "Atmosphere/Pressure.hpp"
 #include "Compiler.h"
@@ -80,6 +81,9 @@ class Airspaces : public AirspacesInterface {
   Serial serial;
 
 public:
+  /** Maximum number of tracks accepted by ScanSwept() */
+  static constexpr unsigned MAX_SWEPT_TRACKS = 4;
+
   /**
    * Constructor.
    * Note this class can't safely be copied (yet)
@@ -213,6 +217,24 @@ public:
                                  const AirspacePredicate &condition =
                                        AirspacePredicate::always_true) const;
 
+  /**
+   * Find airspaces which may be touched by any of several straight
+   * tracks from one location, i.e. whose bounding box is crossed by
+   * at least one track (this includes all airspaces whose bounding
+   * box contains the location).  The index is searched only once for
+   * the region swept by all tracks.  The caller still has to test the
+   * exact shape of each airspace.
+   *
+   * @param location start of all tracks
+   * @param ends end points of the tracks
+   * @param n number of tracks, at most #MAX_SWEPT_TRACKS
+   * @param condition only airspaces matching this condition are returned
+   */
+  const AirspaceVector ScanSwept(const GeoPoint &location,
+                                 const GeoPoint *ends, unsigned n,
+                                 const AirspacePredicate &condition =
+                                       AirspacePredicate::always_true) const;
+
   /**
    * Find airspaces the aircraft is inside (taking altitude into account)
    *
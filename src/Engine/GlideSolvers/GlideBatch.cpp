@@ -0,0 +1,154 @@
+/* Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#include "GlideBatch.hpp"
+#include "Geo/GeoVector.hpp"
+
+#if defined(__SSE2__) && !defined(FIXED_MATH)
+#include <emmintrin.h>
+#endif
+
+void
+GlideBatch::Clear()
+{
+  distance.clear();
+  north.clear();
+  east.clear();
+  altitude_difference.clear();
+}
+
+void
+GlideBatch::Reserve(unsigned n)
+{
+  distance.reserve(n);
+  north.reserve(n);
+  east.reserve(n);
+  altitude_difference.reserve(n);
+  speed.reserve(n);
+  sink_rate.reserve(n);
+  arrival_altitude_difference.reserve(n);
+  time_elapsed.reserve(n);
+}
+
+unsigned
+GlideBatch::Add(const GeoVector &vector, const fixed _altitude_difference)
+{
+  const auto sc = vector.bearing.SinCos();
+
+  distance.push_back(vector.distance);
+  north.push_back(sc.second);
+  east.push_back(sc.first);
+  altitude_difference.push_back(_altitude_difference);
+  return distance.size() - 1;
+}
+
+#if defined(__SSE2__) && !defined(FIXED_MATH)
+
+gcc_always_inline
+static inline __m128d
+Select(__m128d mask, __m128d a, __m128d b)
+{
+  return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+}
+
+#endif
+
+void
+GlideBatch::Glide(const fixed wind_north, const fixed wind_east)
+{
+  const unsigned n = size();
+  arrival_altitude_difference.resize(n);
+  time_elapsed.resize(n);
+
+  const fixed wind_speed_squared = sqr(wind_north) + sqr(wind_east);
+
+  unsigned i = 0;
+
+#if defined(__SSE2__) && !defined(FIXED_MATH)
+  /* two destinations at a time; this is the same calculation as the
+     scalar loop below */
+
+  const __m128d v_wind_north = _mm_set1_pd(wind_north);
+  const __m128d v_wind_east = _mm_set1_pd(wind_east);
+  const __m128d v_wind_speed_squared = _mm_set1_pd(wind_speed_squared);
+  const __m128d zero = _mm_setzero_pd();
+  const __m128d one = _mm_set1_pd(1);
+  const __m128d minus_one = _mm_set1_pd(-1);
+
+  for (; i + 2 <= n; i += 2) {
+    const __m128d d = _mm_loadu_pd(&distance[i]);
+    const __m128d dh = _mm_loadu_pd(&altitude_difference[i]);
+    const __m128d v = _mm_loadu_pd(&speed[i]);
+
+    const __m128d head_wind =
+      _mm_add_pd(_mm_mul_pd(v_wind_north, _mm_loadu_pd(&north[i])),
+                 _mm_mul_pd(v_wind_east, _mm_loadu_pd(&east[i])));
+
+    const __m128d q =
+      _mm_sub_pd(_mm_add_pd(_mm_mul_pd(head_wind, head_wind),
+                            _mm_mul_pd(v, v)),
+                 v_wind_speed_squared);
+    const __m128d ground_speed =
+      _mm_sub_pd(_mm_sqrt_pd(_mm_max_pd(q, zero)), head_wind);
+
+    const __m128d glide_ok = _mm_and_pd(_mm_cmpge_pd(q, zero),
+                                        _mm_cmpgt_pd(ground_speed, zero));
+    const __m128d t = _mm_div_pd(d, Select(glide_ok, ground_speed, one));
+    const __m128d glide_dh =
+      _mm_sub_pd(dh, _mm_mul_pd(t, _mm_loadu_pd(&sink_rate[i])));
+
+    const __m128d vertical = _mm_cmple_pd(d, zero);
+    const __m128d ok = Select(vertical, _mm_cmpge_pd(dh, zero), glide_ok);
+
+    _mm_storeu_pd(&arrival_altitude_difference[i],
+                  Select(vertical, dh, glide_dh));
+    _mm_storeu_pd(&time_elapsed[i],
+                  Select(ok, Select(vertical, zero, t), minus_one));
+  }
+#endif
+
+  for (; i < n; ++i) {
+    arrival_altitude_difference[i] = altitude_difference[i];
+
+    if (!positive(distance[i])) {
+      /* the destination is at the aircraft's position */
+      time_elapsed[i] = negative(altitude_difference[i])
+        ? fixed(-1)
+        : fixed(0);
+      continue;
+    }
+
+    // same as GlideState::CalcAverageSpeed()
+    const fixed head_wind = wind_north * north[i] + wind_east * east[i];
+    const fixed q = sqr(head_wind) + sqr(speed[i]) - wind_speed_squared;
+    const fixed ground_speed = negative(q)
+      ? fixed(-1)
+      : sqrt(q) - head_wind;
+    if (!positive(ground_speed)) {
+      time_elapsed[i] = fixed(-1);
+      continue;
+    }
+
+    time_elapsed[i] = distance[i] / ground_speed;
+    arrival_altitude_difference[i] -= time_elapsed[i] * sink_rate[i];
+  }
+}
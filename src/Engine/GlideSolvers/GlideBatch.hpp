@@ -0,0 +1,137 @@
+/* Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+#ifndef GLIDEBATCH_HPP
+#define GLIDEBATCH_HPP
+
+#include "Math/fixed.hpp"
+#include "Compiler.h"
+
+#include <vector>
+
+class GeoVector;
+
+/**
+ * A list of straight glides from the same aircraft position to many
+ * destinations, e.g. all landables around the aircraft.  The
+ * destinations are stored as structure of arrays, so
+ * MacCready::SolveStraight(GlideBatch &, const SpeedVector &) can
+ * process several of them with one SIMD instruction.
+ *
+ * The results are the same as those of MacCready::SolveStraight() for
+ * each destination, except that a destination at the aircraft's
+ * position which is above the aircraft has no solution (that would
+ * require a climb).
+ */
+class GlideBatch {
+  friend class MacCready;
+
+  /* input */
+
+  /** Distance to the destination (m) */
+  std::vector<fixed> distance;
+
+  /** North and east components of the unit vector towards the destination */
+  std::vector<fixed> north, east;
+
+  /** Aircraft altitude less the minimum arrival altitude (m) */
+  std::vector<fixed> altitude_difference;
+
+  /* filled by MacCready */
+
+  /** Effective cruise speed (m/s) */
+  std::vector<fixed> speed;
+
+  /** Sink rate at the cruise speed (m/s) */
+  std::vector<fixed> sink_rate;
+
+  /* output */
+
+  /** Altitude difference at the destination (m) */
+  std::vector<fixed> arrival_altitude_difference;
+
+  /** Time to reach the destination (s), negative if there is no solution */
+  std::vector<fixed> time_elapsed;
+
+public:
+  void Clear();
+
+  void Reserve(unsigned n);
+
+  gcc_pure
+  unsigned size() const {
+    return distance.size();
+  }
+
+  gcc_pure
+  bool empty() const {
+    return distance.empty();
+  }
+
+  /**
+   * Add a destination.
+   *
+   * @param vector Vector from the aircraft to the destination
+   * @param altitude_difference Aircraft altitude less the minimum
+   * arrival altitude at the destination (m)
+   *
+   * @return the index of the destination
+   */
+  unsigned Add(const GeoVector &vector, fixed altitude_difference);
+
+  /**
+   * Was a solution found for this destination?  Only valid after
+   * solving.
+   */
+  gcc_pure
+  bool IsOk(unsigned i) const {
+    return !negative(time_elapsed[i]);
+  }
+
+  /**
+   * @return the altitude difference at the destination (m),
+   * i.e. GlideResult::pure_glide_altitude_difference
+   */
+  gcc_pure
+  fixed GetAltitudeDifference(unsigned i) const {
+    return arrival_altitude_difference[i];
+  }
+
+  /**
+   * @return the time to reach the destination (s)
+   */
+  gcc_pure
+  fixed GetTimeElapsed(unsigned i) const {
+    return time_elapsed[i];
+  }
+
+private:
+  /**
+   * Calculate the results from the speeds and sink rates.
+   *
+   * @param wind_north North component of the wind (m/s), where the
+   * wind blows from
+   * @param wind_east East component of the wind (m/s)
+   */
+  void Glide(fixed wind_north, fixed wind_east);
+};
+
+#endif
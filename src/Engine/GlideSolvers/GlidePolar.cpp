@@ -276,6 +276,7 @@ GlidePolar::GetMCEffectiveSpeed() const
   return d / t;
 }
 
+#if 0
 /**
  * Finds speed to fly for a given MacCready setting
  * Intended to be used temporarily.
@@ -337,6 +338,25 @@ public:
     return Vopt + m_head_wind;
   }
 };
+#endif
+
+fixed
+GlidePolar::SolveSpeedToFly(const fixed net_sink_rate,
+                            const fixed head_wind) const
+{
+  assert(polar.IsValid());
+
+  /* the ground speed u minimising
+     (MSinkRate(u + head_wind) + net_sink_rate) / u of the parabolic
+     polar solves a*u^2 = a*W^2 + b*W + c + mc + net_sink_rate; without
+     a solution, the glide ratio improves with decreasing speed */
+  const fixed s = sqr(head_wind) +
+    (polar.c + mc + net_sink_rate + polar.b * head_wind) / polar.a;
+  const fixed v = positive(s) ? head_wind + sqrt(s) : head_wind;
+
+  /* search range of the ground speed: at least 1 m/s */
+  return std::min(std::max(v, std::max(fixed(1) + head_wind, Vmin)), Vmax);
+}
 
 
 /**
@@ -413,10 +433,13 @@ GlidePolar::EquivalentMC(fixed speed) const
 fixed
 GlidePolar::SpeedToFlyStillAir() const
 {
-  fixed V_stf;
-
+#if 0
+  // this method to be used if polar is not parabolic
   GlidePolarSpeedToFly gp_stf(*this, fixed(0), fixed(0), Vmin, Vmax);
-  V_stf = gp_stf.solve(Vmax);
+  const fixed V_stf = gp_stf.solve(Vmax);
+#else
+  const fixed V_stf = SolveSpeedToFly(fixed(0), fixed(0));
+#endif
 
   return std::max(Vmin, V_stf);
 }
@@ -439,8 +462,13 @@ GlidePolar::SpeedToFly(const AircraftState &state,
                           : fixed(0));
     const fixed stf_sink_rate (block_stf ? fixed(0) : -state.netto_vario);
 
+#if 0
+    // this method to be used if polar is not parabolic
     GlidePolarSpeedToFly gp_stf(*this, stf_sink_rate, head_wind, Vmin, Vmax);
     V_stf = gp_stf.solve(Vmax);
+#else
+    V_stf = SolveSpeedToFly(stf_sink_rate, head_wind);
+#endif
   }
 
   return std::max(Vmin, V_stf * g_scaling);
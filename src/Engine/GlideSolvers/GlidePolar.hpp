@@ -603,6 +603,18 @@ private:
 
   /** Solve for min sink rate at current bugs/ballast setting. */
   void UpdateSMin();
+
+  /**
+   * Solve for the airspeed with the best glide ratio over ground at
+   * current MC/bugs/ballast setting.
+   *
+   * @param net_sink_rate Netto sink rate (m/s), positive down
+   * @param head_wind Head wind component (m/s)
+   *
+   * @return Speed to fly (true, m/s)
+   */
+  gcc_pure
+  fixed SolveSpeedToFly(fixed net_sink_rate, fixed head_wind) const;
 };
 
 static_assert(std::is_trivial<GlidePolar>::value, "type is not trivial");
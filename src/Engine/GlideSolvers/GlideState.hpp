@@ -57,6 +57,8 @@ private:
   fixed wind_speed_squared;
 
 public:
+  GlideState() = default;
+
   /**
    * Dummy task constructor.  Typically used for synthetic glide
    * tasks.  Where there are real targets, the other constructors should
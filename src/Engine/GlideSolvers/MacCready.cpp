@@ -25,8 +25,11 @@
 #include "GlideState.hpp"
 #include "GlidePolar.hpp"
 #include "GlideResult.hpp"
+#include "GlideBatch.hpp"
+#include "PolarCoefficients.hpp"
 #include "Math/ZeroFinder.hpp"
 #include "Util/Tolerances.hpp"
+#include "Geo/SpeedVector.hpp"
 
 #include <algorithm>
 #include <assert.h>
@@ -401,11 +404,71 @@ public:
   }
 };
 
+fixed
+MacCready::OptimiseGlideSpeed(const fixed head_wind,
+                              const fixed cross_wind_squared) const
+{
+  /* The sink rate of the parabolic polar is s(v) = a*v^2 + b*v + c,
+     and the ground speed is g(v) = sqrt((k*v)^2 - Wc^2) - Wh with the
+     cruise efficiency k, the cross wind Wc and the head wind Wh.  The
+     best glide ratio over ground is at the root of
+     phi(v) = s'(v)*g(v) - s(v)*g'(v), which is found with Newton's
+     method. */
+
+  const PolarCoefficients polar = glide_polar.GetRealCoefficients();
+  const fixed k = cruise_efficiency;
+  const fixed k2 = sqr(k);
+  const fixed v_min = glide_polar.GetVMin(), v_max = glide_polar.GetVMax();
+
+  /* start at the solution without cross wind */
+  const fixed q = sqr(head_wind) +
+    k * (polar.b * head_wind + polar.c * k) / polar.a;
+  fixed v = positive(q) ? (head_wind + sqrt(q)) / k : v_max;
+
+  for (unsigned i = 0; i < 8; ++i) {
+    v = std::min(std::max(v, v_min), v_max);
+
+    const fixed r_squared = sqr(k * v) - cross_wind_squared;
+    if (!positive(r_squared))
+      return fixed(-1);
+
+    const fixed r = sqrt(r_squared);
+    const fixed g = r - head_wind;
+    if (!positive(g))
+      return fixed(-1);
+
+    const fixed s = (polar.a * v + polar.b) * v + polar.c;
+    const fixed ds = Double(polar.a * v) + polar.b;
+    const fixed dg = k2 * v / r;
+    const fixed ddg = -k2 * cross_wind_squared / (r_squared * r);
+
+    const fixed phi = ds * g - s * dg;
+    const fixed dphi = Double(polar.a * g) - s * ddg;
+    if (!positive(dphi))
+      return fixed(-1);
+
+    const fixed v_next = std::min(std::max(v - phi / dphi, v_min), v_max);
+    if (fabs(v_next - v) < fixed(TOLERANCE_MC_OPT_GLIDE))
+      return v_next;
+
+    v = v_next;
+  }
+
+  return fixed(-1);
+}
+
 GlideResult
 MacCready::OptimiseGlide(const GlideState &task, const bool allow_partial) const
 {
   assert(!positive(glide_polar.GetMC()));
 
+  const fixed v =
+    OptimiseGlideSpeed(task.head_wind,
+                       std::max(sqr(task.wind.norm) - sqr(task.head_wind),
+                                fixed(0)));
+  if (!negative(v))
+    return SolveGlide(task, v, allow_partial);
+
   MacCreadyVopt mc_vopt(task, *this,
                        glide_polar.GetVMin(), glide_polar.GetVMax(),
                        allow_partial);
@@ -413,6 +476,77 @@ MacCready::OptimiseGlide(const GlideState &task, const bool allow_partial) const
   return mc_vopt.Result(glide_polar.GetVMin());
 }
 
+void
+MacCready::Solve(const GlideState *tasks, GlideResult *results,
+                 unsigned n) const
+{
+  for (unsigned i = 0; i < n; ++i)
+    results[i] = Solve(tasks[i]);
+}
+
+void
+MacCready::SolveStraight(const GlideState *tasks, GlideResult *results,
+                         unsigned n) const
+{
+  for (unsigned i = 0; i < n; ++i)
+    results[i] = SolveStraight(tasks[i]);
+}
+
+void
+MacCready::SolveStraight(GlideBatch &batch, const SpeedVector &wind) const
+{
+  const unsigned n = batch.size();
+
+  if (!glide_polar.IsValid()) {
+    /* can't solve without a valid GlidePolar() */
+    batch.arrival_altitude_difference.assign(n, fixed(0));
+    batch.time_elapsed.assign(n, fixed(-1));
+    return;
+  }
+
+  const auto sc = wind.bearing.SinCos();
+  const fixed wind_north = wind.norm * sc.second;
+  const fixed wind_east = wind.norm * sc.first;
+
+  if (positive(glide_polar.GetMC())) {
+    const fixed v = glide_polar.GetVBestLD();
+    batch.speed.assign(n, v * cruise_efficiency);
+    batch.sink_rate.assign(n, glide_polar.SinkRate(v));
+  } else {
+    /* the best speed depends on the head wind of each destination */
+    batch.speed.resize(n);
+    batch.sink_rate.resize(n);
+
+    for (unsigned i = 0; i < n; ++i) {
+      const fixed head_wind =
+        wind_north * batch.north[i] + wind_east * batch.east[i];
+
+      fixed v = fixed(-1);
+      if (positive(batch.distance[i])) {
+        v = OptimiseGlideSpeed(head_wind,
+                               std::max(sqr(wind.norm) - sqr(head_wind),
+                                        fixed(0)));
+        if (negative(v)) {
+          const GlideState task(GeoVector(batch.distance[i],
+                                          Angle::FromXY(batch.north[i],
+                                                        batch.east[i])),
+                                fixed(0), batch.altitude_difference[i],
+                                wind);
+          v = OptimiseGlide(task).v_opt;
+        }
+      }
+
+      if (!positive(v))
+        v = glide_polar.GetVBestLD();
+
+      batch.speed[i] = v * cruise_efficiency;
+      batch.sink_rate[i] = glide_polar.SinkRate(v);
+    }
+  }
+
+  batch.Glide(wind_north, wind_east);
+}
+
 /*
   // distance relation
 
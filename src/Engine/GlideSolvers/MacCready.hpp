@@ -28,7 +28,9 @@
 struct GlideSettings;
 struct GlideState;
 struct GlideResult;
+struct SpeedVector;
 class GlidePolar;
+class GlideBatch;
 
 /**
  *  Helper class used to calculate times/speeds and altitude differences
@@ -105,6 +107,35 @@ public:
                            const GlidePolar &glide_polar,
                            const GlideState &task);
 
+  /**
+   * Calculates the glide solutions for many tasks at once, e.g. one
+   * per direction.  The result is the same as calling Solve() for
+   * each task.
+   *
+   * @param tasks The tasks for which solutions are desired
+   * @param results Receives one solution per task
+   * @param n The number of tasks
+   */
+  void Solve(const GlideState *tasks, GlideResult *results,
+             unsigned n) const;
+
+  /**
+   * Like Solve(const GlideState *, GlideResult *, unsigned), but always
+   * assume straight glide, no cruise.
+   */
+  void SolveStraight(const GlideState *tasks, GlideResult *results,
+                     unsigned n) const;
+
+  /**
+   * Calculates straight glides to all destinations of the batch, with
+   * the same results as SolveStraight(const GlideState &) for each
+   * destination.
+   *
+   * @param batch The destinations, receives the results
+   * @param wind The wind vector
+   */
+  void SolveStraight(GlideBatch &batch, const SpeedVector &wind) const;
+
   /**
    * Calculates the glide solution for a classical MacCready theory task
    * with no climb component (pure glide).  This is used internally to
@@ -156,6 +187,17 @@ private:
   GlideResult OptimiseGlide(const GlideState &task,
                             const bool allow_partial = false) const;
 
+  /**
+   * Find the airspeed which gives the best glide ratio over ground.
+   *
+   * @param head_wind Head wind component (m/s)
+   * @param cross_wind_squared Square of the cross wind component (m/s)
+   *
+   * @return Optimum airspeed (m/s), or negative if the search failed
+   */
+  gcc_pure
+  fixed OptimiseGlideSpeed(fixed head_wind, fixed cross_wind_squared) const;
+
   /**
    * Solve a task which is known to be pure climb (no distance
    * to travel other than that due to drift).
@@ -25,19 +25,6 @@
 #include "GlideSolvers/GlideResult.hpp"
 #include "GlideSolvers/MacCready.hpp"
 
-GlideResult
-RoutePolar::SolveTask(const GlideSettings &settings,
-                      const GlidePolar& glide_polar,
-                       const SpeedVector& wind,
-                       const Angle theta, const bool glide) const
-{
-  const MacCready mac_cready(settings, glide_polar);
-  GlideState task(GeoVector(fixed(1), theta), fixed(0), fixed(0), wind);
-  return glide
-    ? mac_cready.SolveStraight(task)
-    : mac_cready.Solve(task);
-}
-
 void
 RoutePolar::Initialise(const GlideSettings &settings, const GlidePolar& polar,
                        const SpeedVector& wind,
@@ -45,9 +32,20 @@ RoutePolar::Initialise(const GlideSettings &settings, const GlidePolar& polar,
 {
   static constexpr Angle ang_step = Angle::FullCircle() / ROUTEPOLAR_POINTS;
 
+  GlideState tasks[ROUTEPOLAR_POINTS];
   Angle ang = Angle::QuarterCircle();
-  for (unsigned i = 0; i < ROUTEPOLAR_POINTS; ++i, ang -= ang_step) {
-    GlideResult res = SolveTask(settings, polar, wind, ang, is_glide);
+  for (unsigned i = 0; i < ROUTEPOLAR_POINTS; ++i, ang -= ang_step)
+    tasks[i] = GlideState(GeoVector(fixed(1), ang), fixed(0), fixed(0), wind);
+
+  GlideResult results[ROUTEPOLAR_POINTS];
+  const MacCready mac_cready(settings, polar);
+  if (is_glide)
+    mac_cready.SolveStraight(tasks, results, ROUTEPOLAR_POINTS);
+  else
+    mac_cready.Solve(tasks, results, ROUTEPOLAR_POINTS);
+
+  for (unsigned i = 0; i < ROUTEPOLAR_POINTS; ++i) {
+    const GlideResult &res = results[i];
     if (res.IsOk()) {
       RoutePolarPoint point(res.time_elapsed, res.height_glide);
       points[i] = point;
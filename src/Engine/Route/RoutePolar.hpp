@@ -25,10 +25,8 @@
 #include "Geo/Flat/FlatGeoPoint.hpp"
 #include "Math/fixed.hpp"
 
-class Angle;
 class GlidePolar;
 struct GlideSettings;
-struct GlideResult;
 struct SpeedVector;
 
 typedef AFlatGeoPoint RoutePoint;
@@ -107,11 +105,6 @@ public:
    * @param dy Y distance units
    */
   static void IndexToDXDY(const int index, int& dx, int& dy);
-
-private:
-  GlideResult SolveTask(const GlideSettings &settings, const GlidePolar& polar,
-                        const SpeedVector &wind,
-                        const Angle theta, const bool glide) const;
 };
 
 #endif
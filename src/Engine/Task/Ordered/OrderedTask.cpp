@@ -34,6 +34,7 @@
 #include "Task/Solvers/TaskEffectiveMacCready.hpp"
 #include "Task/Solvers/TaskBestMc.hpp"
 #include "Task/Solvers/TaskMinTarget.hpp"
+#include "Task/Solvers/TaskAnalyticTarget.hpp"
 #include "Task/Solvers/TaskGlideRequired.hpp"
 #include "Task/Solvers/TaskOptTarget.hpp"
 #include "Task/Visitors/TaskPointVisitor.hpp"
@@ -99,6 +100,7 @@ OrderedTask::OrderedTask(const TaskBehaviour &tb)
    active_factory(nullptr),
    ordered_settings(tb.ordered_defaults),
    dijkstra_min(nullptr), dijkstra_max(nullptr),
+   dijkstra_max_achieved(nullptr),
    saved_start_pushed_valid(false),
    last_task_mc_speed(fixed(-1)),
    is_glider_close_to_start_cylinder(false)
@@ -116,6 +118,7 @@ OrderedTask::~OrderedTask()
 
   delete dijkstra_min;
   delete dijkstra_max;
+  delete dijkstra_max_achieved;
 }
 
 const TaskFactoryConstraints &
@@ -260,9 +263,9 @@ OrderedTask::RunDijsktraMaxAchieved()
   if (task_size < 2)
     return false;
 
-  if (dijkstra_max == nullptr)
-    dijkstra_max = new TaskDijkstraMax();
-  TaskDijkstraMax &dijkstra = *dijkstra_max;
+  if (dijkstra_max_achieved == nullptr)
+    dijkstra_max_achieved = new TaskDijkstraMax();
+  TaskDijkstraMax &dijkstra = *dijkstra_max_achieved;
 
   dijkstra.SetTaskSize(task_size);
   for (unsigned i = 0; i != task_size; ++i) {
@@ -782,12 +785,15 @@ OrderedTask::UpdateIdle(const AircraftState &state,
 {
   bool retval = AbstractTask::UpdateIdle(state, glide_polar);
 
-  if (HasStart() && task_behaviour.optimise_targets_range &&
-      positive(GetOrderedTaskSettings().aat_min_time)) {
+  if (IsRangeOptimisationEnabled()) {
 
     if (IsOptimizable()) {
-      CalcMinTarget(state, glide_polar,
-                    GetOrderedTaskSettings().aat_min_time + fixed(task_behaviour.optimise_targets_margin));
+      /* the analytic optimiser is cheap enough to run on every fix
+         from UpdateSample() */
+      if (task_behaviour.target_optimiser !=
+          TaskBehaviour::TargetOptimiser::ANALYTIC)
+        CalcMinTarget(state, glide_polar,
+                      GetOrderedTaskSettings().aat_min_time + fixed(task_behaviour.optimise_targets_margin));
 
       if (task_behaviour.optimise_targets_bearing &&
           task_points[active_task_point]->GetType() == TaskPointType::AAT) {
@@ -805,9 +811,16 @@ OrderedTask::UpdateIdle(const AircraftState &state,
   return retval;
 }
 
+bool
+OrderedTask::IsRangeOptimisationEnabled() const
+{
+  return HasStart() && task_behaviour.optimise_targets_range &&
+    positive(GetOrderedTaskSettings().aat_min_time);
+}
+
 bool
 OrderedTask::UpdateSample(const AircraftState &state,
-                          gcc_unused const GlidePolar &glide_polar,
+                          const GlidePolar &glide_polar,
                           gcc_unused const bool full_update)
 {
   assert(state.location.IsValid());
@@ -815,6 +828,12 @@ OrderedTask::UpdateSample(const AircraftState &state,
   stats.inside_oz = active_task_point < task_points.size() &&
     task_points[active_task_point]->IsInSector(state);
 
+  if (task_behaviour.target_optimiser ==
+      TaskBehaviour::TargetOptimiser::ANALYTIC &&
+      IsRangeOptimisationEnabled() && IsOptimizable())
+    CalcMinTarget(state, glide_polar,
+                  GetOrderedTaskSettings().aat_min_time + fixed(task_behaviour.optimise_targets_margin));
+
   return true;
 }
 
@@ -1366,6 +1385,14 @@ OrderedTask::CalcMinTarget(const AircraftState &aircraft,
     const fixed t_rem = std::max(fixed(0),
                                  t_target - stats.total.time_elapsed);
 
+    if (task_behaviour.target_optimiser ==
+        TaskBehaviour::TargetOptimiser::ANALYTIC) {
+      TaskAnalyticTarget bmt(task_points, active_task_point, aircraft,
+                             task_behaviour.glide, glide_polar,
+                             t_rem, taskpoint_start);
+      return bmt.search(fixed(0));
+    }
+
     TaskMinTarget bmt(task_points, active_task_point, aircraft,
                       task_behaviour.glide, glide_polar,
                       t_rem, taskpoint_start);
@@ -91,6 +91,13 @@ private:
   TaskDijkstraMin *dijkstra_min;
   TaskDijkstraMax *dijkstra_max;
 
+  /**
+   * A separate instance for RunDijsktraMaxAchieved(), because its
+   * boundaries differ from RunDijsktraMax(), and sharing one solver
+   * would evict the cached partial results of each other.
+   */
+  TaskDijkstraMax *dijkstra_max_achieved;
+
   /* state that triggered the start prior to the most recent start */
   StartStats saved_start_stats_pushed;
   AircraftState saved_start_state_pushed;
@@ -568,6 +575,13 @@ private:
                       const GlidePolar &glide_polar,
                       const fixed t_target);
 
+  /**
+   * Determine whether target ranges shall be optimised for the
+   * minimum task time.
+   */
+  gcc_pure
+  bool IsRangeOptimisationEnabled() const;
+
   /**
    * Sets previous/next taskpoint pointers for task point at specified
    * index in sequence.
@@ -211,8 +211,9 @@ OrderedTaskPoint::UpdateBoundingBox(const FlatProjection &projection)
 {
   flat_bb = FlatBoundingBox(projection.ProjectInteger(GetLocation()));
 
-  for (const auto &i : GetBoundary())
-    flat_bb.Expand(projection.ProjectInteger(i));
+  /* the boundary points were projected by UpdateOZ() */
+  for (const auto &i : GetBoundaryPoints())
+    flat_bb.Expand(i.GetFlatLocation());
 
   flat_bb.ExpandByOne(); // add 1 to fix rounding
 }
@@ -23,7 +23,6 @@
 #include "TaskLegLandoutDistance.hpp"
 #include "Task/Ordered/Points/OrderedTaskPoint.hpp"
 #include "Task/ObservationZones/ObservationZoneClient.hpp"
-#include "Task/ObservationZones/Boundary.hpp"
 
 #include <assert.h>
 #include <algorithm>
@@ -91,7 +90,6 @@ TaskLegLandoutDistance::SetLandoutDistanceGeometry(bool force)
   }
   //TODO: optimize this so it is only called if GetLocationScored changes significantly
 
-  const OZBoundary &oz_boundary = destination.GetBoundary();
   const GeoPoint &start = destination.GetPrevious()->GetLocationScored();
   const Angle bearing_nominal = start.Bearing(destination.GetLocation());
   fixed distance_nominal = start.Distance(destination.GetLocation());
@@ -112,16 +110,15 @@ TaskLegLandoutDistance::SetLandoutDistanceGeometry(bool force)
   oz_point_farthest_right = oz_point_farthest_left = destination.GetLocation();
 
   // using AsDelta() enables if zone straddles 0 or 180 degree bearing
-  for (auto begin = oz_boundary.cbegin(),
-         end = oz_boundary.cend(), i = begin; i != end; ++i) {
-    // **i is the & to the point
-    Angle bearing = start.Bearing(*i);
+  for (const auto &i : destination.GetBoundaryPoints()) {
+    const GeoPoint &location = i.GetLocation();
+    Angle bearing = start.Bearing(location);
     if ((bearing - bearing_nominal).AsDelta() > delta_right.AsDelta()) {
       delta_right = (bearing - bearing_nominal).AsDelta();
-      oz_point_farthest_right = *i;
+      oz_point_farthest_right = location;
     } else if ((bearing - bearing_nominal).AsDelta() < delta_left.AsDelta()) {
       delta_left = (bearing - bearing_nominal).AsDelta();
-      oz_point_farthest_left = *i;
+      oz_point_farthest_left = location;
     }
   }
   vector_to_oz_farthest_left = start.DistanceBearing(oz_point_farthest_left);
@@ -138,15 +135,13 @@ TaskLegLandoutDistance::GetClosestOZPoint(const GeoPoint &ref) const
     return GeoPoint::Invalid();
   }
 
-  const OZBoundary &oz_boundary = destination.GetBoundary();
   fixed dist_min = fixed(-1);
   GeoPoint point_min = GeoPoint::Invalid();
-  for (auto begin = oz_boundary.cbegin(),
-         end = oz_boundary.cend(), i = begin; i != end; ++i) {
-    fixed distance = ref.DistanceS(*i);
+  for (const auto &i : destination.GetBoundaryPoints()) {
+    fixed distance = ref.DistanceS(i.GetLocation());
     if (!positive(dist_min) || distance < dist_min) {
       dist_min = distance;
-      point_min = *i;
+      point_min = i.GetLocation();
     }
   }
   return point_min;
@@ -21,70 +21,148 @@
 */
 
 #include "TaskDijkstra.hpp"
-#include "Geo/SearchPointVector.hpp"
 
 #include <algorithm>
 
 TaskDijkstra::TaskDijkstra(bool _is_min)
-  :NavDijkstra(0),
+  :num_stages(0), num_valid(0),
    is_min(_is_min)
 {
 }
 
-inline unsigned
-TaskDijkstra::GetStageSize(const unsigned stage) const
+gcc_pure
+static bool
+SameLocations(const SearchPointVector &a, const SearchPointVector &b)
 {
-  assert(stage < num_stages);
-
-  return boundaries[stage]->size();
+  return a.size() == b.size() &&
+    std::equal(a.begin(), a.end(), b.begin(),
+               [](const SearchPoint &x, const SearchPoint &y) {
+                 return x.GetLocation() == y.GetLocation();
+               });
 }
 
-const SearchPoint &
-TaskDijkstra::GetPoint(const ScanTaskPoint sp) const
+inline void
+TaskDijkstra::Validate()
 {
-  return (*boundaries[sp.GetStageNumber()])[sp.GetPointIndex()];
+  num_valid = std::min(num_valid, num_stages);
+
+  for (unsigned i = 0; i < num_valid; ++i) {
+    if (!SameLocations(stages[i].points,
+                       *boundaries[GetStageNumber(i)])) {
+      num_valid = i;
+      break;
+    }
+  }
 }
 
-void
-TaskDijkstra::AddEdges(const ScanTaskPoint curNode)
+inline void
+TaskDijkstra::UpdateStage(unsigned origin_distance, bool reuse)
 {
-  ScanTaskPoint destination(curNode.GetStageNumber() + 1, 0);
-  const unsigned dsize = GetStageSize(destination.GetStageNumber());
-
-  for (const ScanTaskPoint end(destination.GetStageNumber(), dsize);
-       destination != end; destination.IncrementPointIndex())
-    Link(destination, curNode, CalcDistance(curNode, destination));
+  Stage &stage = stages[origin_distance];
+  const SearchPointVector &boundary =
+    *boundaries[GetStageNumber(origin_distance)];
+
+  const unsigned n = boundary.size();
+  const unsigned n_reuse = reuse
+    ? std::min(n, unsigned(stage.points.size()))
+    : 0;
+
+  stage.value.resize(n);
+  stage.predecessor.resize(n);
+
+  for (unsigned j = 0; j < n; ++j) {
+    const SearchPoint &point = boundary[j];
+
+    if (j < n_reuse &&
+        point.GetLocation() == stage.points[j].GetLocation())
+      /* this point has not changed, and neither has the previous
+         stage */
+      continue;
+
+    if (origin_distance == 0) {
+      stage.value[j] = 0;
+      stage.predecessor[j] = 0;
+      continue;
+    }
+
+    const Stage &previous = stages[origin_distance - 1];
+    const unsigned n_previous = previous.points.size();
+    assert(n_previous > 0);
+
+    unsigned best_value = 0, best_index = 0;
+    for (unsigned i = 0; i < n_previous; ++i) {
+      /* measure from the earlier to the later task point, just like
+         the edges are directed */
+      const unsigned distance = is_min
+        ? CalcDistance(point, previous.points[i])
+        : CalcDistance(previous.points[i], point);
+      const unsigned value = previous.value[i] + distance;
+      if (i == 0 || IsBetter(value, best_value)) {
+        best_value = value;
+        best_index = i;
+      }
+    }
+
+    stage.value[j] = best_value;
+    stage.predecessor[j] = best_index;
+  }
+
+  stage.points = boundary;
 }
 
-void
-TaskDijkstra::AddZeroStartEdges()
+bool
+TaskDijkstra::Run(const SearchPoint &location)
 {
-  const unsigned stage = 0;
-  ScanTaskPoint destination(stage, 0);
-  const unsigned dsize = GetStageSize(stage);
+  assert(!location.IsValid() || is_min);
 
-  for (const ScanTaskPoint end(stage, dsize);
-       destination != end; destination.IncrementPointIndex())
-    LinkStart(destination, 0);
-}
+  if (num_stages == 0)
+    return false;
 
-void 
-TaskDijkstra::AddStartEdges(unsigned stage, const SearchPoint &currentLocation)
-{
-  assert(currentLocation.IsValid());
+  for (unsigned i = 0; i < num_stages; ++i)
+    if (boundaries[i]->empty())
+      /* no way to reach the final stage */
+      return false;
 
-  ScanTaskPoint destination(stage, 0);
-  const unsigned dsize = GetStageSize(stage);
+  const unsigned previous_valid = std::min(num_valid, num_stages);
+  Validate();
 
-  for (const ScanTaskPoint end(stage, dsize);
-       destination != end; destination.IncrementPointIndex())
-    LinkStart(destination, CalcDistance(destination, currentLocation));
-}
+  /* if a stage's boundary has been modified, but the stages before
+     it are unchanged, the results of its unmodified points can be
+     reused (usually, a new sample has been added to the active task
+     point) */
+  const bool reuse = num_valid < previous_valid;
 
-bool
-TaskDijkstra::Run()
-{
-  const bool retval = DistanceGeneral() == SolverResult::VALID;
-  dijkstra.Clear();
-  return retval;
+  for (const unsigned first = num_valid; num_valid < num_stages; ++num_valid)
+    UpdateStage(num_valid, reuse && num_valid == first);
+
+  /* find the best end point of the last stage (counted from the
+     origin), which is the first task point of the minimum search,
+     linked with the aircraft location */
+
+  const unsigned last = num_stages - 1;
+  const Stage &stage = stages[last];
+
+  unsigned best_value = 0, best_index = 0;
+  for (unsigned j = 0, n = stage.points.size(); j < n; ++j) {
+    unsigned value = stage.value[j];
+    if (location.IsValid())
+      value += CalcDistance(stage.points[j], location);
+
+    if (j == 0 || IsBetter(value, best_value)) {
+      best_value = value;
+      best_index = j;
+    }
+  }
+
+  /* trace the path back to the origin */
+
+  for (unsigned i = last;; --i) {
+    solution[GetStageNumber(i)] = best_index;
+    if (i == 0)
+      break;
+
+    best_index = stages[i].predecessor[best_index];
+  }
+
+  return true;
 }
@@ -23,21 +23,17 @@
 #ifndef TASK_DIJKSTRA_HPP
 #define TASK_DIJKSTRA_HPP
 
-#include "PathSolvers/NavDijkstra.hpp"
-#include "Geo/SearchPoint.hpp"
+#include "Geo/SearchPointVector.hpp"
+#include "Compiler.h"
 
-#include <assert.h>
+#include <vector>
 
-class OrderedTask;
-class SearchPointVector;
+#include <assert.h>
 
 /**
  * Class used to scan an OrderedTask for maximum/minimum distance
  * points.
  *
- * Uses flat-projected integer representation of search points for
- * speed, but this also makes the system approximate.
- *
  * Search points are located on OZ boundaries and each form a convex
  * hull, as this produces the minimum search vector size without loss
  * of accuracy.
@@ -49,12 +45,68 @@ class SearchPointVector;
  * Before each calculation, set up this object with SetTaskSize() and
  * call SetBoundary() for each task point.
  *
- * This uses a Dijkstra search and so is O(N log(N)).
+ * Edges only connect the points of one stage (task point) with the
+ * points of the next stage, so the shortest/longest path is found
+ * with one sweep over the stages, beginning at the "origin" stage.
+ * The partial result of each stage is cached, and the next
+ * calculation resumes at the first stage (counted from the origin)
+ * whose boundary has changed; in that stage, only the modified
+ * points are recalculated.  The maximum search starts at the
+ * start point, because new samples are only added to the active task
+ * point, and the stages after it are usually cheap.  The minimum
+ * search starts at the finish point, because its boundaries rarely
+ * change, but the aircraft location (which is linked to the first
+ * stage) changes with every fix.
  */
-class TaskDijkstra : protected NavDijkstra
+class TaskDijkstra
 {
+protected:
+  static constexpr unsigned MAX_STAGES = 32;
+
+private:
+  /**
+   * The cached partial result for one stage, indexed by the distance
+   * from the origin stage (see GetStageNumber()).
+   */
+  struct Stage {
+    /**
+     * A copy of the boundary which was used to calculate #value and
+     * #predecessor.
+     */
+    SearchPointVector points;
+
+    /**
+     * The best distance from the origin stage to each point.
+     */
+    std::vector<unsigned> value;
+
+    /**
+     * The index of the best predecessor (in the previous stage,
+     * counted from the origin) of each point.
+     */
+    std::vector<unsigned> predecessor;
+  };
+
   const SearchPointVector *boundaries[MAX_STAGES];
 
+  Stage stages[MAX_STAGES];
+
+  /**
+   * Number of stages in search
+   */
+  unsigned num_stages;
+
+  /**
+   * The number of stages (counted from the origin) in #stages which
+   * are up to date.
+   */
+  unsigned num_valid;
+
+  /**
+   * An array containing the point index for each of the solution's stages.
+   */
+  unsigned solution[MAX_STAGES];
+
   const bool is_min;
 
 public:
@@ -65,8 +117,12 @@ public:
    */
   TaskDijkstra(const bool is_min);
 
+  TaskDijkstra(const TaskDijkstra &) = delete;
+
   void SetTaskSize(unsigned size) {
-    SetStageCount(size);
+    assert(size <= MAX_STAGES);
+
+    num_stages = size;
   }
 
   void SetBoundary(unsigned idx, const SearchPointVector &boundary) {
@@ -75,6 +131,14 @@ public:
     boundaries[idx] = &boundary;
   }
 
+  /**
+   * Discard all cached partial results, to force a full calculation
+   * in the next run.
+   */
+  void Invalidate() {
+    num_valid = 0;
+  }
+
   /**
    * Returns the solution point for the specified task point.  Call
    * this after run() has returned true.
@@ -82,74 +146,68 @@ public:
   const SearchPoint &GetSolution(unsigned stage) const {
     assert(stage < num_stages);
 
-    return GetPoint(ScanTaskPoint(stage, solution[stage]));
+    return stages[GetOriginDistance(stage)].points[solution[stage]];
   }
 
 protected:
+  /**
+   * Calculate the solution.
+   *
+   * @param location the aircraft location, linked to each point of
+   * the first stage; if invalid, all paths begin at the first stage
+   * @return true if a solution was found
+   */
+  bool Run(const SearchPoint &location);
+
+private:
+  /**
+   * Convert a distance from the origin stage to a stage number.
+   */
   gcc_pure
-  const SearchPoint &GetPoint(ScanTaskPoint sp) const;
+  unsigned GetStageNumber(unsigned origin_distance) const {
+    assert(origin_distance < num_stages);
 
-  bool Run();
+    return is_min ? num_stages - 1 - origin_distance : origin_distance;
+  }
 
-  bool Link(const ScanTaskPoint node, const ScanTaskPoint parent,
-            unsigned value) {
-    if (!is_min)
-      value = DIJKSTRA_MINMAX_OFFSET - value;
+  gcc_pure
+  unsigned GetOriginDistance(unsigned stage_number) const {
+    return GetStageNumber(stage_number);
+  }
 
-    return NavDijkstra::Link(node, parent, value);
+  bool IsBetter(unsigned a, unsigned b) const {
+    return is_min ? a < b : a > b;
   }
 
   /**
-   * Add a zero-length start edge to each point in the first stage.
+   * Check which cached stages are still valid, and update
+   * #num_valid.
    */
-  void AddZeroStartEdges();
+  void Validate();
 
   /**
-   * Add a start edge from the given location to each point in the
-   * given stage.
-   */
-  void AddStartEdges(unsigned stage, const SearchPoint &loc);
-
-  /** 
-   * Distance function for free point
-   * 
-   * @param curNode Destination node
-   * @param currentLocation Origin location
-   * 
-   * @return Distance (flat) from origin to destination
+   * Calculate the partial result of a stage from the previous one.
+   *
+   * @param reuse true if the cached results of this stage were
+   * calculated from the current previous stage, and can be reused for
+   * points which have not changed
    */
-  gcc_pure
-  unsigned CalcDistance(const ScanTaskPoint curNode,
-                        const SearchPoint &currentLocation) const {
-    /* using expensive floating point formulas here to avoid integer
-       rounding errors */
+  void UpdateStage(unsigned origin_distance, bool reuse);
 
-    const GeoPoint &a = GetPoint(curNode).GetLocation();
-    const GeoPoint &b = currentLocation.GetLocation();
-
-    return (unsigned)a.Distance(b);
-  }
-
-  /** 
+  /**
    * Distance function for edges
-   * 
-   * @param s1 Origin node
-   * @param s2 Destination node
-   * 
-   * @return Distance (flat) from origin to destination
+   *
+   * @param a point in the earlier stage
+   * @param b point in the later stage (or the aircraft location)
+   *
+   * @return Distance from a to b
    */
   gcc_pure
-  unsigned CalcDistance(const ScanTaskPoint s1, const ScanTaskPoint s2) const {
-    return CalcDistance(s1, GetPoint(s2));
+  static unsigned CalcDistance(const SearchPoint &a, const SearchPoint &b) {
+    /* using expensive floating point formulas here to avoid integer
+       rounding errors */
+    return (unsigned)a.GetLocation().Distance(b.GetLocation());
   }
-
-private:
-  gcc_pure
-  unsigned GetStageSize(const unsigned stage) const;
-
-protected:
-  /* methods from NavDijkstra */
-  virtual void AddEdges(ScanTaskPoint curNode) final;
 };
 
 #endif
@@ -25,8 +25,5 @@
 bool
 TaskDijkstraMax::DistanceMax()
 {
-  dijkstra.Clear();
-  dijkstra.Reserve(256);
-  AddZeroStartEdges();
-  return Run();
+  return Run(SearchPoint::Invalid());
 }
@@ -42,10 +42,6 @@ public:
    * @return True if succeeded
    */
   bool DistanceMax();
-
-private:
-  bool DistanceMax(const SearchPoint *location);
-
 };
 
 #endif
@@ -44,24 +44,18 @@ SampledTaskPoint::AddInsideSample(const AircraftState& state,
 {
   assert(state.location.IsValid());
 
-  // if sample is inside sample polygon
-  if (sampled_points.IsInside(state.location))
-    // return false (no update required)
+  // add sample to the convex hull of the samples; if it is inside,
+  // return false (no update required)
+  if (!sampled_points.ExtendConvexHull(SearchPoint(state.location,
+                                                   projection)))
     return false;
 
-  // add sample to polygon
-  SearchPoint sp(state.location, projection);
-  sampled_points.push_back(sp);
+  /* thinning is used here to ensure the sampled points vector size is
+     bounded to reasonable values for AAT calculations */
+  sampled_points.ThinConvexHull(64);
 
-  // re-compute convex hull
-  bool retval = sampled_points.PruneInterior();
-
-  // only return true if hull changed
-  // return true; (update required)
-  return sampled_points.ThinToSize(64) || retval;
-
-  /* thin to size is used here to ensure the sampled points vector
-     size is bounded to reasonable values for AAT calculations */
+  // hull changed (update required)
+  return true;
 }
 
 void
@@ -0,0 +1,122 @@
+/* Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#include "TaskAnalyticTarget.hpp"
+#include "Task/Ordered/Points/StartPoint.hpp"
+#include "Util/Tolerances.hpp"
+
+#include <algorithm>
+
+TaskAnalyticTarget::TaskAnalyticTarget(const std::vector<OrderedTaskPoint*>& tps,
+                                       const unsigned activeTaskPoint,
+                                       const AircraftState &_aircraft,
+                                       const GlideSettings &settings,
+                                       const GlidePolar &_gp,
+                                       const fixed _t_remaining,
+                                       StartPoint *_ts)
+  :tm(tps.cbegin(), tps.cend(), activeTaskPoint, settings, _gp,
+      /* ignore the travel to the start point */
+      false),
+   aircraft(_aircraft),
+   t_remaining(_t_remaining),
+   tp_start(_ts),
+   force_current(false)
+{
+}
+
+fixed
+TaskAnalyticTarget::f(const fixed p)
+{
+  // set task targets
+  set_range(p);
+
+  res = tm.glide_solution(aircraft);
+  return res.time_elapsed - t_remaining;
+}
+
+fixed
+TaskAnalyticTarget::solve(const fixed p_start)
+{
+  /* bracket of the root; the time remaining grows with the range */
+  fixed lower = fixed(0), upper = fixed(1);
+  fixed p = std::max(lower, std::min(upper, p_start));
+
+  for (unsigned i = 0; i < MAX_ITERATIONS; ++i) {
+    const fixed error = f(p);
+    if (!res.IsOk())
+      return p;
+
+    if (positive(error))
+      upper = p;
+    else
+      lower = p;
+
+    const fixed derivative = tm.range_derivative(p);
+    fixed p_next = positive(derivative)
+      ? p - error / derivative
+      : (lower + upper) / 2;
+
+    if (!(p_next > lower && p_next < upper))
+      /* Newton step left the bracket, bisect instead */
+      p_next = (lower + upper) / 2;
+
+    if (fabs(p_next - p) < fixed(TOLERANCE_MIN_TARGET)) {
+      /* the remaining correction is below the tolerance, no need
+         to solve the task again */
+      set_range(p_next);
+      return p_next;
+    }
+
+    p = p_next;
+  }
+
+  f(p);
+  return p;
+}
+
+fixed
+TaskAnalyticTarget::search(const fixed tp)
+{
+  if (!tm.has_targets())
+    // don't bother if nothing to adjust
+    return tp;
+
+  force_current = false;
+  const fixed p = solve(tp);
+  if (res.IsOk())
+    return p;
+
+  force_current = true;
+  const fixed p2 = solve(tp);
+  if (res.IsOk())
+    return p2;
+
+  set_range(fixed(0));
+  return fixed(0);
+}
+
+void
+TaskAnalyticTarget::set_range(const fixed p)
+{
+  tm.set_range(p, force_current);
+  tp_start->ScanDistanceRemaining(aircraft.location);
+}
@@ -0,0 +1,102 @@
+/* Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#ifndef TASKANALYTICTARGET_HPP
+#define TASKANALYTICTARGET_HPP
+
+#include "TaskMacCreadyRemaining.hpp"
+
+#include <vector>
+
+class StartPoint;
+
+/**
+ * Optimise target ranges (for adjustable tasks) to produce an estimated
+ * time remaining with the current glide polar, equal to a target value.
+ *
+ * This is a drop-in alternative to TaskMinTarget.  Instead of a
+ * derivative-free root search, it runs a safeguarded Newton iteration
+ * on the range parameter, where the derivative of the time remaining
+ * is obtained analytically from the leg geometry and the leg speeds
+ * of the last glide solution.  This typically converges in two or
+ * three glide solutions, cheap enough to run on every fix.
+ */
+class TaskAnalyticTarget final {
+  /** Upper bound on glide solutions per search attempt */
+  static constexpr unsigned MAX_ITERATIONS = 16;
+
+  TaskMacCreadyRemaining tm;
+  GlideResult res;
+  const AircraftState &aircraft;
+  const fixed t_remaining;
+  StartPoint *tp_start;
+  bool force_current;
+
+public:
+  /**
+   * Constructor for ordered task points
+   *
+   * @param tps Vector of ordered task points comprising the task
+   * @param activeTaskPoint Current active task point in sequence
+   * @param _aircraft Current aircraft state
+   * @param _gp Glide polar to copy for calculations
+   * @param _t_remaining Desired time remaining (s) of task
+   * @param _ts StartPoint of task (to initiate scans)
+   */
+  TaskAnalyticTarget(const std::vector<OrderedTaskPoint*>& tps,
+                     const unsigned activeTaskPoint,
+                     const AircraftState &_aircraft,
+                     const GlideSettings &settings, const GlidePolar &_gp,
+                     const fixed _t_remaining,
+                     StartPoint *_ts);
+
+  /**
+   * Search for target range to produce remaining time equal to
+   * value specified in constructor.
+   *
+   * Running this adjusts the target values for AAT task points.
+   *
+   * @param p Default range (0-1)
+   *
+   * @return Range value for solution
+   */
+  fixed search(const fixed p);
+
+private:
+  /**
+   * Set the targets to the given range and solve the task.
+   *
+   * @return Time remaining error (s)
+   */
+  fixed f(const fixed p);
+
+  /**
+   * Run the Newton iteration from the given starting range.
+   *
+   * @return Range value for solution
+   */
+  fixed solve(const fixed p);
+
+  void set_range(const fixed p);
+};
+
+#endif
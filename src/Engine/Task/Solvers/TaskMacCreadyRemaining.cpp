@@ -25,6 +25,7 @@
 #include "GlideSolvers/MacCready.hpp"
 #include "Task/Points/TaskPoint.hpp"
 #include "Task/Ordered/Points/AATPoint.hpp"
+#include "Geo/FAISphere.hpp"
 
 GlideResult
 TaskMacCreadyRemaining::SolvePoint(const TaskPoint &tp,
@@ -89,6 +90,98 @@ TaskMacCreadyRemaining::set_range(const fixed tp, const bool force_current)
   }
 }
 
+/**
+ * Marginal time (s) per metre of additional distance on a leg.  The
+ * extra distance is flown at the leg's cruise speed, and the height
+ * lost doing so has to be climbed back at the MacCready setting unless
+ * the leg is a pure glide.
+ */
+static fixed
+LegRate(const GlideResult &solution, const fixed mc, const fixed fallback)
+{
+  if (!solution.IsOk() || !positive(solution.vector.distance))
+    return fallback;
+
+  const fixed distance = solution.vector.distance;
+  const bool climbing = positive(solution.height_climb) && positive(mc);
+  const fixed time_cruise = climbing
+    ? solution.time_elapsed - solution.height_climb / mc
+    : solution.time_elapsed;
+  if (!positive(time_cruise))
+    return fallback;
+
+  fixed rate = time_cruise / distance;
+  if (climbing)
+    rate += solution.height_glide / (distance * mc);
+  return rate;
+}
+
+/**
+ * Rate of change of a leg's length (m) when its end point moves by
+ * the given north/east offsets (m), i.e. the projection of the motion
+ * onto the leg direction.
+ */
+static fixed
+LegStretch(const GlideResult &solution, const fixed north, const fixed east)
+{
+  if (!positive(solution.vector.distance))
+    return fixed(0);
+
+  const Angle bearing = solution.vector.bearing;
+  return north * bearing.fastcosine() + east * bearing.fastsine();
+}
+
+fixed
+TaskMacCreadyRemaining::range_derivative(const fixed p) const
+{
+  const unsigned n = points.size();
+
+  fixed distance = fixed(0), time = fixed(0);
+  for (unsigned i = 0; i < n; ++i) {
+    if (leg_solutions[i].IsOk()) {
+      distance += leg_solutions[i].vector.distance;
+      time += leg_solutions[i].time_elapsed;
+    }
+  }
+
+  if (!positive(distance) || !positive(time))
+    return fixed(0);
+
+  const fixed mc = glide_polar.GetMC();
+  const fixed mean_rate = time / distance;
+
+  fixed derivative = fixed(0);
+  for (unsigned i = 0; i < n; ++i) {
+    if (!points[i]->HasTarget())
+      continue;
+
+    const AATPoint &ap = *(const AATPoint *)points[i];
+    const GeoPoint &target = ap.GetTarget();
+    if (!(target == ap.InterpolateLocationMinMax(p)))
+      /* not moved by set_range() */
+      continue;
+
+    /* the targets move linearly in latitude/longitude from the min to
+       the max location; convert that motion to metres */
+    const GeoPoint motion = ap.GetLocationMax() - ap.GetLocationMin();
+    const fixed north =
+      FAISphere::AngleToEarthDistance(motion.latitude);
+    const fixed east =
+      FAISphere::AngleToEarthDistance(motion.longitude) *
+      target.latitude.fastcosine();
+
+    /* leg i ends at the target, leg i+1 starts there */
+    derivative += LegStretch(leg_solutions[i], north, east) *
+      LegRate(leg_solutions[i], mc, mean_rate);
+
+    if (i + 1 < n)
+      derivative -= LegStretch(leg_solutions[i + 1], north, east) *
+        LegRate(leg_solutions[i + 1], mc, mean_rate);
+  }
+
+  return derivative;
+}
+
 void
 TaskMacCreadyRemaining::target_save()
 {
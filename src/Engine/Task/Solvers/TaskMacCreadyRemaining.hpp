@@ -74,6 +74,19 @@ public:
    */
   void set_range(const fixed tp, const bool force_current);
 
+  /**
+   * Calculate the derivative of the time remaining with respect to
+   * the range parameter from the leg solutions of the last call to
+   * glide_solution().  Only targets which currently sit at the
+   * parametric range p contribute, i.e. those moved by set_range().
+   *
+   * @param p Range parameter [0,1] the targets were last set to
+   *
+   * @return Rate of change of time remaining (s per unit range)
+   */
+  gcc_pure
+  fixed range_derivative(const fixed p) const;
+
   /**
    * Determine if any of the remaining TaskPoints have an adjustable target
    *
@@ -48,6 +48,7 @@ TaskBehaviour::SetDefaults()
   optimise_targets_range = true;
   optimise_targets_bearing = true;
   optimise_targets_margin = 300;
+  target_optimiser = TargetOptimiser::ZERO_FINDER;
   auto_mc = false;
   auto_mc_mode = AutoMCMode::CLIMBAVERAGE;
   calc_cruise_efficiency = true;
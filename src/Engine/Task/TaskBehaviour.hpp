@@ -88,6 +88,18 @@ struct TaskBehaviour {
   bool optimise_targets_bearing;
   /** Seconds additional to min time to optimise for */
   unsigned optimise_targets_margin;
+
+  /** Enumeration of target range optimisers */
+  enum class TargetOptimiser: uint8_t {
+    /** Root search with a full task glide solution per iteration */
+    ZERO_FINDER = 0,
+    /** Newton iteration using analytic leg time derivatives */
+    ANALYTIC,
+  };
+
+  /** Solver used to position AAT targets for the minimum task time */
+  TargetOptimiser target_optimiser;
+
   /** Option to enable calculation and setting of auto MacCready */
   bool auto_mc;
 
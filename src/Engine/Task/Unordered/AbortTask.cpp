@@ -25,7 +25,8 @@
 #include "AlternateList.hpp"
 #include "Navigation/Aircraft.hpp"
 #include "Task/Visitors/TaskPointVisitor.hpp"
-#include "Task/Solvers/TaskSolution.hpp"
+#include "GlideSolvers/GlideState.hpp"
+#include "GlideSolvers/MacCready.hpp"
 #include "Waypoint/Waypoints.hpp"
 #include "Waypoint/WaypointVisitor.hpp"
 #include "Util/ReservablePriorityQueue.hpp"
@@ -151,6 +152,7 @@ AbortTask::FillReachable(const AircraftState &state,
   q.reserve(32);
 
   bool found_non_airfield_landables = false;
+  const MacCready mac_cready(task_behaviour.glide, polar);
 
   for (auto v = approx_waypoints.begin(); v != approx_waypoints.end();) {
     if (!v->waypoint.IsAirport())
@@ -161,10 +163,7 @@ AbortTask::FillReachable(const AircraftState &state,
       continue;
     }
 
-    UnorderedTaskPoint t(v->waypoint, task_behaviour);
-    GlideResult result =
-        TaskSolution::GlideSolutionRemaining(t, state,
-                                             task_behaviour.glide, polar);
+    const GlideResult result = SolveCandidate(state, *v, mac_cready);
 
     if (IsReachable(result, final_glide)) {
       bool intersects = false;
@@ -203,6 +202,25 @@ AbortTask::FillReachable(const AircraftState &state,
   return found_final_glide;
 }
 
+const GlideResult &
+AbortTask::SolveCandidate(const AircraftState &state,
+                          AlternatePoint &candidate,
+                          const MacCready &mac_cready) const
+{
+  if (!candidate.solution.IsDefined()) {
+    /* same as TaskSolution::GlideSolutionRemaining() with an
+       UnorderedTaskPoint, but without copying the Waypoint */
+    const Waypoint &waypoint = candidate.waypoint;
+    const GlideState task(GeoVector(state.location, waypoint.location),
+                          std::max(fixed(0), waypoint.elevation +
+                                   task_behaviour.safety_height_arrival),
+                          state.altitude, state.wind);
+    candidate.solution = mac_cready.Solve(task);
+  }
+
+  return candidate.solution;
+}
+
 /**
  * Class to build vector from visited waypoints.
  * Intended to be used temporarily.
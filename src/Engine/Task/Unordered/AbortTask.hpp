@@ -34,6 +34,8 @@
 class Waypoints;
 class AbortIntersectionTest;
 class AlternateList;
+struct AlternatePoint;
+class MacCready;
 
 /**
  * Abort task provides automatic management of a sorted list of task points
@@ -184,6 +186,16 @@ protected:
                      const GlidePolar &polar, bool only_airfield,
                      bool final_glide, bool safety);
 
+private:
+  /**
+   * Calculate the glide solution of a candidate waypoint into
+   * AlternatePoint::solution, unless that was already done by a
+   * previous FillReachable() pass.
+   */
+  const GlideResult &SolveCandidate(const AircraftState &state,
+                                    AlternatePoint &candidate,
+                                    const MacCready &mac_cready) const;
+
 protected:
   /**
    * This is called by update_sample after the turnpoint list has 
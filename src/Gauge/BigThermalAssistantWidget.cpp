@@ -101,13 +101,14 @@ BigThermalAssistantWidget::Show(const PixelRect &rc)
   close_button.SetVisible(true);
 #endif
 
-  blackboard.AddListener(*this);
+  filtered_listener.Reset();
+  blackboard.AddListener(filtered_listener);
 }
 
 void
 BigThermalAssistantWidget::Hide()
 {
-  blackboard.RemoveListener(*this);
+  blackboard.RemoveListener(filtered_listener);
   ContainerWidget::Hide();
 }
 
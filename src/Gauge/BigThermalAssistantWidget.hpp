@@ -26,7 +26,7 @@ Copyright_License {
 
 #include "Widget/ContainerWidget.hpp"
 #include "Form/ActionListener.hpp"
-#include "Blackboard/BlackboardListener.hpp"
+#include "Blackboard/FilteredBlackboardListener.hpp"
 #include "Form/Button.hpp"
 
 struct AttitudeState;
@@ -43,6 +43,12 @@ class BigThermalAssistantWidget
   LiveBlackboard &blackboard;
   const ThermalAssistantLook &look;
 
+  /**
+   * The gauge only depends on the circling state and the lift
+   * database; this skips all other calculation results.
+   */
+  FilteredBlackboardListener filtered_listener;
+
   BigThermalAssistantWindow *view;
 
 #ifndef GNAV
@@ -56,7 +62,9 @@ class BigThermalAssistantWidget
 public:
   BigThermalAssistantWidget(LiveBlackboard &_blackboard,
                             const ThermalAssistantLook &_look)
-    :blackboard(_blackboard), look(_look) {}
+    :blackboard(_blackboard), look(_look),
+     filtered_listener(*this,
+                       DerivedGenerations::ToMask(DerivedGenerations::CIRCLING)) {}
 
   /* virtual methods from class Widget */
   virtual void Prepare(ContainerWindow &parent,
@@ -172,13 +172,14 @@ GaugeThermalAssistant::Show(const PixelRect &rc)
 
   OverlappedWidget::Show(rc);
 
-  blackboard.AddListener(*this);
+  filtered_listener.Reset();
+  blackboard.AddListener(filtered_listener);
 }
 
 void
 GaugeThermalAssistant::Hide()
 {
-  blackboard.RemoveListener(*this);
+  blackboard.RemoveListener(filtered_listener);
   OverlappedWidget::Hide();
 }
 
@@ -25,7 +25,7 @@ Copyright_License {
 #define GAUGE_THERMAL_ASSISTENT_HPP
 
 #include "Widget/OverlappedWidget.hpp"
-#include "Blackboard/BlackboardListener.hpp"
+#include "Blackboard/FilteredBlackboardListener.hpp"
 
 struct AttitudeState;
 class LiveBlackboard;
@@ -39,10 +39,18 @@ class GaugeThermalAssistant final
   LiveBlackboard &blackboard;
   const ThermalAssistantLook &look;
 
+  /**
+   * The gauge only depends on the circling state and the lift
+   * database; this skips all other calculation results.
+   */
+  FilteredBlackboardListener filtered_listener;
+
 public:
   GaugeThermalAssistant(LiveBlackboard &_blackboard,
                         const ThermalAssistantLook &_look)
-    :blackboard(_blackboard), look(_look) {}
+    :blackboard(_blackboard), look(_look),
+     filtered_listener(*this,
+                       DerivedGenerations::ToMask(DerivedGenerations::CIRCLING)) {}
 
   virtual void Prepare(ContainerWindow &parent, const PixelRect &rc) override;
   virtual void Unprepare() override;
@@ -26,10 +26,24 @@
 #include "FlatBoundingBox.hpp"
 #include "Geo/GeoBounds.hpp"
 #include "Geo/FAISphere.hpp"
+#include "Math/BulkFloat.hpp"
 
 #include <algorithm>
 #include <cassert>
 
+/* the SSE2 kernels calculate in double precision, i.e. they match the
+   scalar code only if bulk_float is double */
+#if defined(__SSE2__) && !defined(FIXED_MATH) && !defined(FLOAT_GEOMETRY)
+#define FLAT_PROJECTION_SSE2
+#include <emmintrin.h>
+
+/* each GeoPoint is loaded as one vector (longitude, latitude) and each
+   FlatGeoPoint is stored as two 32 bit integers */
+static_assert(sizeof(GeoPoint) == 2 * sizeof(double), "Unexpected layout");
+static_assert(sizeof(FlatPoint) == 2 * sizeof(double), "Unexpected layout");
+static_assert(sizeof(FlatGeoPoint) == 2 * sizeof(int), "Unexpected layout");
+#endif
+
 // scaling for flat earth integer representation, gives approximately 50m resolution
 #ifdef RADIANS
 static constexpr int fixed_scale = 57296;
@@ -61,6 +75,73 @@ FlatProjection::ProjectFloat(const GeoPoint &tp) const
                    .AsDelta().Native() * fixed_scale);
 }
 
+#ifdef FLAT_PROJECTION_SSE2
+
+/**
+ * Vector version of Angle::AsDelta() for the difference of two valid
+ * angles, which is never off by more than one full circle.
+ */
+gcc_always_inline
+static inline __m128d
+AsDelta(__m128d d)
+{
+  const __m128d half = _mm_set1_pd(Angle::HalfCircle().Native());
+  const __m128d full = _mm_set1_pd(Angle::FullCircle().Native());
+  const __m128d minus_half = _mm_set1_pd(-Angle::HalfCircle().Native());
+
+  d = _mm_add_pd(d, _mm_and_pd(_mm_cmple_pd(d, minus_half), full));
+  d = _mm_sub_pd(d, _mm_and_pd(_mm_cmpgt_pd(d, half), full));
+  return d;
+}
+
+/**
+ * Vector version of iround(), i.e. lround(): round half away from
+ * zero.  The result is still a double, but it is integral and can be
+ * converted with _mm_cvttpd_epi32() exactly.
+ */
+gcc_always_inline
+static inline __m128d
+Round(__m128d x)
+{
+  const __m128d t = _mm_cvtepi32_pd(_mm_cvttpd_epi32(x));
+  const __m128d fraction = _mm_sub_pd(x, t);
+  const __m128d one = _mm_set1_pd(1);
+
+  return _mm_sub_pd(_mm_add_pd(t, _mm_and_pd(_mm_cmpge_pd(fraction,
+                                                          _mm_set1_pd(0.5)),
+                                             one)),
+                    _mm_and_pd(_mm_cmple_pd(fraction, _mm_set1_pd(-0.5)),
+                               one));
+}
+
+#endif
+
+void
+FlatProjection::ProjectFloat(const GeoPoint *src, FlatPoint *dest,
+                             unsigned n) const
+{
+  assert(IsValid());
+
+  unsigned i = 0;
+
+#ifdef FLAT_PROJECTION_SSE2
+  /* longitude and latitude of one point at a time; this is the same
+     calculation as ProjectFloat(const GeoPoint &) */
+  const __m128d c = _mm_set_pd(center.latitude.Native(),
+                               center.longitude.Native());
+  const __m128d scale = _mm_set_pd(fixed_scale, cos);
+
+  for (; i < n; ++i) {
+    const __m128d p = _mm_loadu_pd((const double *)&src[i]);
+    _mm_storeu_pd((double *)&dest[i],
+                  _mm_mul_pd(AsDelta(_mm_sub_pd(p, c)), scale));
+  }
+#endif
+
+  for (; i < n; ++i)
+    dest[i] = ProjectFloat(src[i]);
+}
+
 GeoPoint
 FlatProjection::Unproject(const FlatPoint &fp) const
 {
@@ -77,8 +158,60 @@ FlatProjection::ProjectInteger(const GeoPoint &tp) const
 {
   assert(IsValid());
 
-  FlatPoint f = ProjectFloat(tp);
-  return FlatGeoPoint(iround(f.x), iround(f.y));
+  /* the deltas to the center are small enough for bulk_float; the
+     subtraction of the absolute angles is not */
+  const bulk_float dx((tp.longitude - center.longitude).AsDelta().Native());
+  const bulk_float dy((tp.latitude - center.latitude).AsDelta().Native());
+  return FlatGeoPoint(iround(dx * bulk_float(cos)),
+                      iround(dy * bulk_float(fixed_scale)));
+}
+
+void
+FlatProjection::ProjectInteger(const GeoPoint *src, FlatGeoPoint *dest,
+                               unsigned n) const
+{
+  assert(IsValid());
+
+  unsigned i = 0;
+
+#ifdef FLAT_PROJECTION_SSE2
+  /* two points at a time; this is the same calculation as
+     ProjectInteger(const GeoPoint &) */
+  const __m128d c = _mm_set_pd(center.latitude.Native(),
+                               center.longitude.Native());
+  const __m128d scale = _mm_set_pd(fixed_scale, cos);
+
+  for (; i + 2 <= n; i += 2) {
+    const __m128d a = _mm_loadu_pd((const double *)&src[i]);
+    const __m128d b = _mm_loadu_pd((const double *)&src[i + 1]);
+
+    const __m128i ia =
+      _mm_cvttpd_epi32(Round(_mm_mul_pd(AsDelta(_mm_sub_pd(a, c)), scale)));
+    const __m128i ib =
+      _mm_cvttpd_epi32(Round(_mm_mul_pd(AsDelta(_mm_sub_pd(b, c)), scale)));
+
+    _mm_storeu_si128((__m128i *)&dest[i], _mm_unpacklo_epi64(ia, ib));
+  }
+#endif
+
+  /* the same as ProjectInteger(const GeoPoint &), but without
+     branches, so the compiler may vectorise it (e.g. ARM NEON) */
+  const fixed half = Angle::HalfCircle().Native();
+  const fixed full = Angle::FullCircle().Native();
+  const bulk_float scale_x(cos), scale_y(fixed_scale);
+
+  for (; i < n; ++i) {
+    fixed dx = (src[i].longitude - center.longitude).Native();
+    dx += dx <= -half ? full : fixed(0);
+    dx -= dx > half ? full : fixed(0);
+
+    fixed dy = (src[i].latitude - center.latitude).Native();
+    dy += dy <= -half ? full : fixed(0);
+    dy -= dy > half ? full : fixed(0);
+
+    dest[i] = FlatGeoPoint(iround(bulk_float(dx) * scale_x),
+                           iround(bulk_float(dy) * scale_y));
+  }
 }
 
 GeoPoint
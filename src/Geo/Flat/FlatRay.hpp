@@ -39,6 +39,11 @@ public:
   /** speedups for box intersection test */
   fixed fy;
 
+  /**
+   * Non-initialising constructor.
+   */
+  FlatRay() = default;
+
   /**
    * Constructor given start/end locations
    *
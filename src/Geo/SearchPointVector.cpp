@@ -26,6 +26,10 @@
 #include "ConvexHull/PolygonInterior.hpp"
 #include "Flat/FlatRay.hpp"
 #include "Flat/FlatBoundingBox.hpp"
+#include "Flat/FlatProjection.hpp"
+#include "Math/BulkFloat.hpp"
+
+#include <algorithm>
 
 bool 
 SearchPointVector::PruneInterior()
@@ -48,11 +52,213 @@ SearchPointVector::ThinToSize(const unsigned max_size)
   return retval;
 }
 
+/**
+ * Twice the signed area of the triangle p0, p1, p2; positive if p2 is
+ * to the left of the line p0 -> p1.
+ *
+ * The sign is needed exactly for the visibility test, which therefore
+ * uses #fixed; the thinning loop only compares magnitudes and uses
+ * #bulk_float.
+ */
+template<typename T=fixed>
+gcc_pure
+static T
+CrossProduct(const GeoPoint &p0, const GeoPoint &p1, const GeoPoint &p2)
+{
+  const T x1((p1.longitude - p0.longitude).Native());
+  const T y1((p1.latitude - p0.latitude).Native());
+  const T x2((p2.longitude - p0.longitude).Native());
+  const T y2((p2.latitude - p0.latitude).Native());
+  return x1 * y2 - x2 * y1;
+}
+
+/**
+ * Is p1 on the line p0 -> p2?  This uses the same auto-tolerance as
+ * GrahamScan, so vertices pruned here would have been pruned by a full
+ * scan as well.
+ */
+gcc_pure
+static bool
+IsCollinear(const GeoPoint &p0, const GeoPoint &p1, const GeoPoint &p2)
+{
+  const bulk_float a = bulk_float((p0.longitude - p1.longitude).Native()) *
+    bulk_float((p2.latitude - p1.latitude).Native());
+  const bulk_float b = bulk_float((p2.longitude - p1.longitude).Native()) *
+    bulk_float((p0.latitude - p1.latitude).Native());
+  return fabs(a - b) <= std::max(fabs(a), fabs(b)) / 100;
+}
+
+/**
+ * Is this a closed polygon with at least three distinct vertices, as
+ * produced by GrahamScan::PruneInterior()?
+ */
+gcc_pure
+static bool
+IsClosedHull(const SearchPointVector &v)
+{
+  return v.size() >= 4 && v.front().GetLocation() == v.back().GetLocation();
+}
+
+bool
+SearchPointVector::ExtendConvexHull(const SearchPoint &sp)
+{
+  if (!IsClosedHull(*this)) {
+    if (IsInside(sp.GetLocation()))
+      return false;
+
+    push_back(sp);
+    PruneInterior();
+    return true;
+  }
+
+  const GeoPoint &p = sp.GetLocation();
+
+  /* the hull is counter-clockwise and closed, i.e. vertex m equals
+     vertex 0; edge i runs from vertex i to vertex i+1 and is visible
+     from p if p is strictly on its right-hand side */
+  const unsigned m = size() - 1;
+  const auto visible = [this, &p](unsigned i) {
+    return negative(CrossProduct((*this)[i].GetLocation(),
+                                 (*this)[i + 1].GetLocation(), p));
+  };
+
+  /* find the run of visible edges; a point outside a convex polygon
+     sees exactly one contiguous run of edges */
+  unsigned first = m, last = m, n_runs = 0, n_visible = 0;
+  bool previous = visible(m - 1);
+  for (unsigned i = 0; i < m; ++i) {
+    const bool current = visible(i);
+    if (current) {
+      ++n_visible;
+      if (!previous) {
+        ++n_runs;
+        first = i;
+      }
+    } else if (previous && i > 0)
+      last = i - 1;
+    else if (previous)
+      last = m - 1;
+
+    previous = current;
+  }
+
+  if (n_visible == 0)
+    /* inside, or on the boundary */
+    return false;
+
+  if (n_runs != 1 || n_visible == m) {
+    /* not a convex counter-clockwise hull; rebuild it */
+    push_back(sp);
+    PruneInterior();
+    return true;
+  }
+
+  if (n_visible == 1 &&
+      IsCollinear((*this)[first].GetLocation(), p,
+                  (*this)[first + 1].GetLocation()))
+    /* close enough to the edge that a full scan would drop it */
+    return false;
+
+  /* replace the vertices between the first and the last visible edge
+     with the new point; work on the open polygon */
+  pop_back();
+
+  unsigned position;
+  if (first <= last) {
+    /* vertices first+1 .. last */
+    erase(begin() + first + 1, begin() + last + 1);
+    position = first + 1;
+    insert(begin() + position, sp);
+  } else {
+    /* the run wraps around: vertices first+1 .. m-1 and 0 .. last */
+    erase(begin() + first + 1, end());
+    erase(begin(), begin() + last + 1);
+    position = size();
+    push_back(sp);
+  }
+
+  /* the turn at both neighbours of the new point has changed; drop
+     them if they are now (nearly) collinear */
+  while (size() > 3) {
+    const unsigned n = size();
+    const unsigned a = (position + n - 1) % n, aa = (position + n - 2) % n;
+    if (!IsCollinear((*this)[aa].GetLocation(), (*this)[a].GetLocation(), p))
+      break;
+
+    erase(begin() + a);
+    if (a < position)
+      --position;
+  }
+
+  while (size() > 3) {
+    const unsigned n = size();
+    const unsigned b = (position + 1) % n, bb = (position + 2) % n;
+    if (!IsCollinear(p, (*this)[b].GetLocation(), (*this)[bb].GetLocation()))
+      break;
+
+    erase(begin() + b);
+    if (b < position)
+      --position;
+  }
+
+  push_back(front());
+  return true;
+}
+
+bool
+SearchPointVector::ThinConvexHull(const unsigned max_size)
+{
+  if (size() <= max_size)
+    return false;
+
+  if (!IsClosedHull(*this))
+    return ThinToSize(max_size);
+
+  /* work on the open polygon, but keep counting the closing vertex */
+  pop_back();
+
+  while (size() >= max_size && size() > 3) {
+    const unsigned n = size();
+    unsigned i_min = 0;
+    bulk_float area_min = bulk_float(-1);
+    for (unsigned i = 0; i < n; ++i) {
+      const bulk_float area =
+        fabs(CrossProduct<bulk_float>((*this)[(i + n - 1) % n].GetLocation(),
+                                      (*this)[i].GetLocation(),
+                                      (*this)[(i + 1) % n].GetLocation()));
+      if (negative(area_min) || area < area_min) {
+        area_min = area;
+        i_min = i;
+      }
+    }
+
+    erase(begin() + i_min);
+  }
+
+  push_back(front());
+  return true;
+}
+
 void 
 SearchPointVector::Project(const FlatProjection &tp)
 {
-  for (auto &i : *this)
-    i.Project(tp);
+  /* copy the locations into small contiguous buffers, so the bulk
+     projection can process several of them at a time */
+  constexpr unsigned CHUNK_SIZE = 64;
+  GeoPoint src[CHUNK_SIZE];
+  FlatGeoPoint dest[CHUNK_SIZE];
+
+  for (auto i = begin(), e = end(); i != e;) {
+    const unsigned n = std::min<unsigned>(CHUNK_SIZE, e - i);
+
+    for (unsigned j = 0; j < n; ++j)
+      src[j] = i[j].GetLocation();
+
+    tp.ProjectInteger(src, dest, n);
+
+    for (unsigned j = 0; j < n; ++j, ++i)
+      *i = SearchPoint(src[j], dest[j]);
+  }
 }
 
 gcc_pure
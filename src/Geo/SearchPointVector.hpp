@@ -47,6 +47,26 @@ public:
    */
   bool ThinToSize(const unsigned max_size);
 
+  /**
+   * Add a point to a closed convex hull as produced by
+   * PruneInterior(), without rebuilding the whole hull: only the
+   * vertices which the new point hides are removed.  Falls back to
+   * PruneInterior() if the vector is not (yet) such a hull.
+   *
+   * @return True if the point was outside the hull (i.e. the hull
+   * was modified)
+   */
+  bool ExtendConvexHull(const SearchPoint &sp);
+
+  /**
+   * Remove the vertices of a closed convex hull which contribute the
+   * least area until the hull is not larger than the given size.
+   * Unlike ThinToSize(), this keeps the hull and does not rescan it.
+   *
+   * @return True if input was modified
+   */
+  bool ThinConvexHull(const unsigned max_size);
+
   void Project(const FlatProjection &tp);
 
   gcc_pure
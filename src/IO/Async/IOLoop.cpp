@@ -93,11 +93,21 @@ IOLoop::Update()
 
     file.modified = false;
 
+#ifdef HAVE_EPOLL
+    if (file.mask == 0) {
+      poll.Remove(file.fd.Get());
+      i = files.erase_and_dispose(i, File::Dispose);
+    } else {
+      poll.Set(file.fd.Get(), file.mask, &file);
+      ++i;
+    }
+#else
     poll.SetMask(file.fd.Get(), file.mask);
     if (file.mask == 0)
       i = files.erase_and_dispose(i, File::Dispose);
     else
       ++i;
+#endif
   }
 }
 
@@ -105,6 +115,20 @@ IOLoop::File *
 IOLoop::CollectReady()
 {
   File *ready = nullptr;
+
+#ifdef HAVE_EPOLL
+  /* the File pointer was registered with the descriptor; it remains
+     valid until the next Update() call, which happens only inside
+     Wait() */
+  for (const auto &event : poll) {
+    assert(event.events != 0);
+
+    File &file = *(File *)event.data.ptr;
+    file.ready_mask = event.events;
+    file.next_ready = ready;
+    ready = &file;
+  }
+#else
   for (auto i = poll.begin(), end = poll.end(); i != end; ++i) {
     const FileDescriptor fd(*i);
     const unsigned mask = i.GetMask();
@@ -120,6 +144,7 @@ IOLoop::CollectReady()
     file.next_ready = ready;
     ready = &file;
   }
+#endif
 
   return ready;
 }
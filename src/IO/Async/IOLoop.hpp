@@ -24,8 +24,14 @@ Copyright_License {
 #ifndef XCSOAR_IO_LOOP_HPP
 #define XCSOAR_IO_LOOP_HPP
 
-#include "OS/Poll.hpp"
 #include "OS/FileDescriptor.hxx"
+
+#ifdef HAVE_EPOLL
+#include "OS/EPoll.hpp"
+#else
+#include "OS/Poll.hpp"
+#endif
+
 #include "Thread/Mutex.hpp"
 #include "Thread/Cond.hpp"
 #include "FileEventHandler.hpp"
@@ -87,7 +93,13 @@ class IOLoop final {
     }
   };
 
-  Poll poll;
+#ifdef HAVE_EPOLL
+  typedef EPoll Backend;
+#else
+  typedef Poll Backend;
+#endif
+
+  Backend poll;
 
   Mutex mutex;
 
@@ -105,8 +117,20 @@ class IOLoop final {
   bool modified, running;
 
 public:
-  static constexpr unsigned READ = Poll::READ;
-  static constexpr unsigned WRITE = Poll::WRITE;
+  static constexpr unsigned READ = Backend::READ;
+  static constexpr unsigned WRITE = Backend::WRITE;
+
+  /**
+   * Request edge-triggered notification, which saves the loop from
+   * re-arming the descriptor after each event.  The handler must read
+   * until EAGAIN.  This is only a hint; it is ignored where epoll is
+   * not available, and the handler is then level-triggered.
+   */
+#ifdef HAVE_EPOLL
+  static constexpr unsigned EDGE = EPoll::EDGE;
+#else
+  static constexpr unsigned EDGE = 0;
+#endif
 
   IOLoop():modified(false), running(false) {}
   ~IOLoop();
@@ -45,6 +45,7 @@ class IOThread final : protected Thread, private FileEventHandler {
 public:
   static constexpr unsigned READ = IOLoop::READ;
   static constexpr unsigned WRITE = IOLoop::WRITE;
+  static constexpr unsigned EDGE = IOLoop::EDGE;
 
   IOThread():Thread("IOThread") {}
 
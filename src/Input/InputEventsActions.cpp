@@ -93,6 +93,10 @@ doc/html/advanced/input/ALL		http://xcsoar.sourceforge.net/advanced/input/
 #include "Terrain/RasterTerrain.hpp"
 #include "Waypoint/WaypointGlue.hpp"
 #include "Formatter/TimeFormatter.hpp"
+#include "Thread/Tracing.hpp"
+#include "JSON/TracingWriter.hpp"
+#include "IO/TextWriter.hpp"
+#include "LocalPath.hpp"
 
 #include <assert.h>
 #include <tchar.h>
@@ -560,6 +564,42 @@ InputEvents::eventCredits(gcc_unused const TCHAR *misc)
   dlgCreditsShowModal(*CommonInterface::main_window);
 }
 
+// Tracing
+// Records how long the calculation and drawing threads take.
+//   on: start recording
+//   off: stop recording
+//   toggle: toggle recording
+//   dump: write the recorded events to "trace.json" in the data
+//         directory, in the Chrome trace event format
+void
+InputEvents::eventTracing(const TCHAR *misc)
+{
+  if (StringIsEqual(misc, _T("on")))
+    Tracing::Enable(true);
+  else if (StringIsEqual(misc, _T("off")))
+    Tracing::Enable(false);
+  else if (StringIsEqual(misc, _T("toggle")))
+    Tracing::Enable(!Tracing::IsEnabled());
+  else if (StringIsEqual(misc, _T("dump"))) {
+    TCHAR path[MAX_PATH];
+    LocalPath(path, _T("trace.json"));
+
+    TextWriter writer(path);
+    if (!writer.IsOpen()) {
+      Message::AddMessage(_("Failed to write file"), path);
+      return;
+    }
+
+    JSON::WriteTracing(writer);
+    Message::AddMessage(_("Trace written"), path);
+    return;
+  }
+
+  Message::AddMessage(Tracing::IsEnabled()
+                      ? _("Tracing on")
+                      : _("Tracing off"));
+}
+
 // Run
 // Runs an external program of the specified filename.
 // Note that XCSoar will wait until this program exits.
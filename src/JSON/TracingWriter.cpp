@@ -0,0 +1,92 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "TracingWriter.hpp"
+#include "Writer.hpp"
+#include "Thread/Tracing.hpp"
+
+static void
+WriteTimestamp(TextWriter &writer, uint64_t value)
+{
+  writer.Format("%llu", (unsigned long long)value);
+}
+
+static void
+WriteThreadName(TextWriter &writer, const Tracing::ThreadEvents &thread)
+{
+  JSON::ObjectWriter object(writer);
+  object.WriteElement("name", JSON::WriteString, "thread_name");
+  object.WriteElement("ph", JSON::WriteString, "M");
+  object.WriteElement("pid", JSON::WriteUnsigned, 1);
+  object.WriteElement("tid", JSON::WriteUnsigned, thread.id);
+
+  object.BeginElement("args");
+  {
+    JSON::ObjectWriter args(writer);
+    args.WriteElement("name", JSON::WriteString, thread.name);
+  }
+  object.EndElement();
+}
+
+static void
+WriteEvent(TextWriter &writer, unsigned tid, const Tracing::Event &event,
+           uint64_t origin)
+{
+  JSON::ObjectWriter object(writer);
+  object.WriteElement("name", JSON::WriteString, event.name);
+  object.WriteElement("ph", JSON::WriteString, "X");
+  object.WriteElement("pid", JSON::WriteUnsigned, 1);
+  object.WriteElement("tid", JSON::WriteUnsigned, tid);
+  object.WriteElement("ts", WriteTimestamp, event.start_us - origin);
+  object.WriteElement("dur", JSON::WriteUnsigned, event.duration_us);
+}
+
+void
+JSON::WriteTracing(TextWriter &writer)
+{
+  const auto threads = Tracing::Collect();
+
+  /* make the timestamps relative to the oldest event */
+  uint64_t origin = UINT64_MAX;
+  for (const auto &thread : threads)
+    if (!thread.events.empty() &&
+        thread.events.front().start_us < origin)
+      origin = thread.events.front().start_us;
+
+  ObjectWriter root(writer);
+  root.BeginElement("traceEvents");
+  {
+    ArrayWriter array(writer);
+    for (const auto &thread : threads) {
+      array.BeginElement();
+      WriteThreadName(writer, thread);
+      array.EndElement();
+
+      for (const auto &event : thread.events)
+        array.WriteElement(WriteEvent, thread.id, event, origin);
+    }
+  }
+  root.EndElement();
+
+  root.WriteElement("displayTimeUnit", WriteString, "ms");
+}
@@ -134,9 +134,11 @@ GlueMapWindow::ExchangeBlackboard()
 {
   /* copy device_blackboard to MapWindow */
 
-  device_blackboard->mutex.Lock();
-  ReadBlackboard(device_blackboard->Basic(), device_blackboard->Calculated());
-  device_blackboard->mutex.Unlock();
+  TripleBuffer<MoreData> &basic = device_blackboard->MapBasic();
+  TripleBuffer<DerivedInfo> &calculated = device_blackboard->MapCalculated();
+  basic.Update();
+  calculated.Update();
+  ReadBlackboard(basic.Front(), calculated.Front());
 
 #ifndef ENABLE_OPENGL
   next_mutex.Lock();
@@ -28,6 +28,7 @@ Copyright_License {
 #include "Terrain/RasterWeatherCache.hpp"
 #include "Computer/GlideComputer.hpp"
 #include "Operation/Operation.hpp"
+#include "Thread/Tracing.hpp"
 
 #ifdef ENABLE_OPENGL
 #include "Screen/OpenGL/Scissor.hpp"
@@ -80,6 +81,10 @@ MapWindow::Create(ContainerWindow &parent, const PixelRect &rc)
   WindowStyle style;
   DoubleBufferWindow::Create(parent, rc, style);
 
+  /* the moving map is redrawn all the time; keeping the airspace
+     polygons in video memory pays off */
+  airspace_renderer.EnableVertexBuffer();
+
   // initialize other systems
   visible_projection.SetMapScale(fixed(5000));
   visible_projection.SetScreenOrigin((rc.left + rc.right) / 2,
@@ -104,6 +109,7 @@ void
 MapWindow::FlushCaches()
 {
   background.Flush();
+  base_layer_cache.Invalidate();
   airspace_renderer.Flush();
 }
 
@@ -184,6 +190,8 @@ MapWindow::UpdateWeather()
 void
 MapWindow::OnPaintBuffer(Canvas &canvas)
 {
+  const ScopeTrace trace("MapWindow::OnPaintBuffer");
+
 #ifndef ENABLE_OPENGL
   unsigned render_generation = ui_generation;
 #endif
@@ -213,6 +221,7 @@ MapWindow::SetTopography(TopographyStore *_topography)
   topography_renderer = topography != nullptr
     ? new CachedTopographyRenderer(*topography, look.topography)
     : nullptr;
+  base_layer_cache.Invalidate();
 }
 
 void
@@ -221,6 +230,7 @@ MapWindow::SetTerrain(RasterTerrain *_terrain)
   terrain = _terrain;
   terrain_center = GeoPoint::Invalid();
   background.SetTerrain(_terrain);
+  base_layer_cache.Invalidate();
 }
 
 void
@@ -231,6 +241,7 @@ MapWindow::SetWeather(const RasterWeatherStore *_weather)
     ? new RasterWeatherCache(*_weather)
     : nullptr;
   background.SetWeather(weather);
+  base_layer_cache.Invalidate();
 }
 
 void
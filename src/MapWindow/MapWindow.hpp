@@ -35,8 +35,11 @@ Copyright_License {
 #include "MapWindowBlackboard.hpp"
 #include "Renderer/AirspaceLabelRenderer.hpp"
 #include "Renderer/BackgroundRenderer.hpp"
+#include "Renderer/OpaqueRendererCache.hpp"
 #include "Renderer/WaypointRenderer.hpp"
 #include "Renderer/TrailRenderer.hpp"
+#include "Terrain/TerrainSettings.hpp"
+#include "Util/Serial.hpp"
 #include "Compiler.h"
 #include "Weather/Features.hpp"
 #include "Tracking/SkyLines/Features.hpp"
@@ -51,6 +54,7 @@ class RasterWeatherCache;
 class Waypoints;
 class Airspaces;
 class ProtectedTaskManager;
+class ProtectedRoutePlanner;
 class GlideComputer;
 class ContainerWindow;
 class NOAAStore;
@@ -129,6 +133,36 @@ protected:
   const TrafficLook &traffic_look;
 
   BackgroundRenderer background;
+
+  /**
+   * The data which the terrain and topography layers depend on,
+   * apart from the projection.  If any of it changes,
+   * #base_layer_cache must be redrawn.
+   */
+  struct BaseLayerKey {
+    Serial terrain_serial;
+    unsigned topography_serial;
+    TerrainRendererSettings terrain_settings;
+    Angle shading_angle;
+    bool topography_enabled;
+
+    gcc_pure
+    bool operator==(const BaseLayerKey &other) const {
+      return terrain_serial == other.terrain_serial &&
+        topography_serial == other.topography_serial &&
+        terrain_settings == other.terrain_settings &&
+        shading_angle.CompareRoughly(other.shading_angle) &&
+        topography_enabled == other.topography_enabled;
+    }
+  };
+
+  /**
+   * Caches the terrain and topography layers, which usually don't
+   * change while the map is not being moved.
+   */
+  OpaqueRendererCache base_layer_cache;
+  BaseLayerKey base_layer_key;
+
   WaypointRenderer waypoint_renderer;
 
   AirspaceRenderer airspace_renderer;
@@ -370,6 +404,12 @@ protected:
   virtual void OnPaintBuffer(Canvas& canvas) override;
 
 private:
+  /**
+   * Renders the terrain and topography layers, or copies them from
+   * #base_layer_cache if nothing has changed
+   * @param canvas The drawing canvas
+   */
+  void RenderBaseLayer(Canvas &canvas);
   /**
    * Renders the terrain background
    * @param canvas The drawing canvas
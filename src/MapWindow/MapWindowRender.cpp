@@ -24,6 +24,9 @@ Copyright_License {
 #include "MapWindow.hpp"
 #include "Look/MapLook.hpp"
 #include "Topography/CachedTopographyRenderer.hpp"
+#include "Topography/TopographyStore.hpp"
+#include "Terrain/RasterTerrain.hpp"
+#include "Terrain/RasterWeatherCache.hpp"
 #include "Renderer/AircraftRenderer.hpp"
 #include "Renderer/WaveRenderer.hpp"
 
@@ -39,10 +42,45 @@ MapWindow::RenderTrackBearing(Canvas &canvas, const RasterPoint aircraft_pos)
 }
 
 void
-MapWindow::RenderTerrain(Canvas &canvas)
+MapWindow::RenderBaseLayer(Canvas &canvas)
 {
-  background.SetShadingAngle(render_projection, GetMapSettings().terrain,
+  const MapSettings &settings = GetMapSettings();
+
+  background.SetShadingAngle(render_projection, settings.terrain,
                              Calculated());
+
+  if (weather != nullptr && !weather->IsTerrain()) {
+    /* RASP maps have no serial which would tell us when they were
+       reloaded; don't cache them */
+    base_layer_cache.Invalidate();
+    RenderTerrain(canvas);
+    RenderTopography(canvas);
+    return;
+  }
+
+  BaseLayerKey key;
+  key.terrain_serial = terrain != nullptr ? terrain->GetSerial() : Serial();
+  key.topography_serial = topography != nullptr ? topography->GetSerial() : 0;
+  key.terrain_settings = settings.terrain;
+  key.shading_angle = background.GetShadingAngle();
+  key.topography_enabled = settings.topography_enabled;
+
+  if (base_layer_cache.Check(render_projection) && key == base_layer_key) {
+    base_layer_cache.CopyTo(canvas, render_projection);
+    return;
+  }
+
+  Canvas &buffer = base_layer_cache.Begin(canvas, render_projection);
+  RenderTerrain(buffer);
+  RenderTopography(buffer);
+  base_layer_cache.Commit(canvas, render_projection);
+
+  base_layer_key = key;
+}
+
+void
+MapWindow::RenderTerrain(Canvas &canvas)
+{
   background.Draw(canvas, render_projection, GetMapSettings().terrain);
 }
 
@@ -143,11 +181,8 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
       aircraft_pos = render_projection.GeoToScreen(basic.location);
 
   // Render terrain, groundline and topography
-  draw_sw.Mark("RenderTerrain");
-  RenderTerrain(canvas);
-
-  draw_sw.Mark("RenderTopography");
-  RenderTopography(canvas);
+  draw_sw.Mark("RenderBaseLayer");
+  RenderBaseLayer(canvas);
 
   draw_sw.Mark("RenderFinalGlideShading");
   RenderFinalGlideShading(canvas);
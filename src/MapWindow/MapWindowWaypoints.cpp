@@ -22,14 +22,18 @@ Copyright_License {
 */
 
 #include "MapWindow.hpp"
+#include "Computer/GlideComputer.hpp"
 
 void
 MapWindow::DrawWaypoints(Canvas &canvas)
 {
   waypoint_renderer.render(canvas, label_block,
-                            render_projection, GetMapSettings().waypoint,
+                           render_projection, GetMapSettings().waypoint,
                            GetComputerSettings().polar,
-                            GetComputerSettings().task,
+                           GetComputerSettings().task,
                            Basic(), Calculated(),
-                            task, route_planner, mouse_down);
+                           task,
+                           glide_computer != nullptr
+                           ? &glide_computer->GetWaypointReach() : nullptr,
+                           mouse_down);
 }
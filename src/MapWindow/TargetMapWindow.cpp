@@ -175,7 +175,10 @@ TargetMapWindow::DrawWaypoints(Canvas &canvas)
                             GetComputerSettings().polar,
                             GetComputerSettings().task,
                             Basic(), Calculated(),
-                            task, nullptr, false);
+                            task,
+                            glide_computer != nullptr
+                            ? &glide_computer->GetWaypointReach() : nullptr,
+                            false);
 }
 
 void
@@ -0,0 +1,47 @@
+/* Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#ifndef XCSOAR_MATH_BULK_FLOAT_HPP
+#define XCSOAR_MATH_BULK_FLOAT_HPP
+
+#include "Math/fixed.hpp"
+
+/**
+ * The scalar type for inner loops over many geometric values, e.g.
+ * flat projections and convex hull area tests.
+ *
+ * With FLOAT_GEOMETRY, this is single precision, which halves the
+ * memory traffic and lets the compiler use 4-wide vector units (ARM
+ * NEON).  It has only 24 bits of mantissa: absolute angles and sums
+ * must be reduced in #fixed (e.g. to a delta relative to a projection
+ * center) before they are converted to this type, and results are
+ * accumulated in #fixed again.
+ *
+ * Without FLOAT_GEOMETRY (or with FIXED_MATH), this is just #fixed.
+ */
+#if defined(FLOAT_GEOMETRY) && !defined(FIXED_MATH)
+typedef float bulk_float;
+#else
+typedef fixed bulk_float;
+#endif
+
+#endif
@@ -28,6 +28,7 @@ Copyright_License {
 #include "NMEA/MoreData.hpp"
 #include "Audio/VarioGlue.hpp"
 #include "Device/MultipleDevices.hpp"
+#include "Thread/Tracing.hpp"
 
 MergeThread::MergeThread(DeviceBlackboard &_device_blackboard)
   :WorkerThread("MergeThread", 150, 50, 20),
@@ -42,6 +43,8 @@ MergeThread::Process()
 {
   assert(!IsDefined() || IsInside());
 
+  const ScopeTrace trace("MergeThread::Process");
+
   device_blackboard.Merge();
 
   const MoreData &basic = device_blackboard.Basic();
@@ -55,6 +58,17 @@ MergeThread::Process()
   flarm_computer.Process(device_blackboard.SetBasic().flarm,
                          last_fix.flarm, basic);
   device_blackboard.MergeSimulatorComputed();
+
+  device_blackboard.UpdateMovementDetected();
+}
+
+void
+MergeThread::FirstRun()
+{
+  assert(!IsDefined());
+
+  Process();
+  device_blackboard.PublishBasic();
 }
 
 void
@@ -102,6 +116,10 @@ MergeThread::Tick()
       last_fix = basic;
   }
 
+  /* only this thread writes DeviceBlackboard::gps_info, so the
+     snapshots can be copied without holding the lock */
+  device_blackboard.PublishBasic();
+
 #ifdef HAVE_PCM_PLAYER
   if (vario_available)
     AudioVarioGlue::SetValue(vario);
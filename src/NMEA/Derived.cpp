@@ -92,6 +92,8 @@ DerivedInfo::Reset()
   airspace_warnings.Clear();
 
   planned_route.clear();
+
+  generations.Clear();
 }
 
 void
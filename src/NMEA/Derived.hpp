@@ -128,6 +128,83 @@ struct AirspaceWarningsInfo {
 
 static_assert(std::is_trivial<AirspaceWarningsInfo>::value, "type is not trivial");
 
+/**
+ * Change counters for groups of #DerivedInfo attributes.  The
+ * computers which produce a group increment its counter whenever they
+ * have stored a new result, so consumers can skip work if nothing they
+ * depend on has changed.  The counters are only compared for
+ * equality.
+ */
+struct DerivedGenerations {
+  enum Category : uint8_t {
+    /** #task_stats, #ordered_task_stats, #common_stats */
+    TASK,
+
+    /** #contest_stats */
+    CONTEST,
+
+    /** wind estimate and effective wind */
+    WIND,
+
+    /** #CirclingInfo, climb statistics, lift database */
+    CIRCLING,
+
+    /** reach, terrain base, terrain warning, planned route,
+        waypoint reachability (#WaypointReachComputer) */
+    TERRAIN,
+
+    /** #airspace_warnings */
+    AIRSPACE,
+
+    /** FLARM traffic and team code */
+    FLARM,
+
+    COUNT
+  };
+
+  /**
+   * A bit mask of categories, see ToMask().
+   */
+  typedef unsigned Mask;
+
+  static constexpr Mask ALL = (1u << COUNT) - 1;
+
+  unsigned values[COUNT];
+
+  static constexpr Mask ToMask(Category category) {
+    return 1u << category;
+  }
+
+  void Clear() {
+    for (auto &i : values)
+      i = 0;
+  }
+
+  void Bump(Category category) {
+    ++values[category];
+  }
+
+  void BumpAll() {
+    for (auto &i : values)
+      ++i;
+  }
+
+  /**
+   * Returns a bit mask of categories which differ from the other
+   * object.
+   */
+  gcc_pure
+  Mask Compare(const DerivedGenerations &other) const {
+    Mask result = 0;
+    for (unsigned i = 0; i < COUNT; ++i)
+      if (values[i] != other.values[i])
+        result |= 1u << i;
+    return result;
+  }
+};
+
+static_assert(std::is_trivial<DerivedGenerations>::value, "type is not trivial");
+
 /**
  * A struct that holds all the calculated values derived from the data in the
  * NMEA_INFO struct
@@ -248,6 +325,9 @@ struct DerivedInfo:
    */
   fixed next_leg_eq_thermal;
 
+  /** Which groups of attributes have been updated? */
+  DerivedGenerations generations;
+
   /**
    * @todo Reset to cleared state
    */
@@ -0,0 +1,113 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_WAYPOINT_REACH_INFO_HPP
+#define XCSOAR_WAYPOINT_REACH_INFO_HPP
+
+#include "Engine/Route/ReachResult.hpp"
+#include "Util/TrivialArray.hpp"
+#include "Util/TypeTraits.hpp"
+#include "Thread/Guard.hpp"
+#include "Compiler.h"
+
+#include <algorithm>
+
+#include <stdint.h>
+
+/**
+ * Arrival heights of the landable (and watched) waypoints near the
+ * aircraft, calculated by the WaypointReachComputer.  The map
+ * renderer only looks up its results here and never calls the route
+ * planner itself.
+ *
+ * This table is not part of DerivedInfo, because DerivedInfo gets
+ * copied on each blackboard update, and this table changes at most
+ * once per second.  It is shared through #ProtectedWaypointReach
+ * instead.
+ */
+struct WaypointReachInfo {
+  static constexpr unsigned MAX_ITEMS = 256;
+
+  enum class Reachability : uint8_t {
+    UNREACHABLE,
+
+    /** reachable in straight glide, but not around terrain */
+    STRAIGHT,
+
+    /** reachable, also when flying around terrain */
+    TERRAIN,
+  };
+
+  struct Item {
+    unsigned waypoint_id;
+
+    Reachability reachable;
+
+    ReachResult reach;
+
+    bool operator<(unsigned other_id) const {
+      return waypoint_id < other_id;
+    }
+  };
+
+  /**
+   * Incremented each time the table has been recalculated.
+   */
+  unsigned version;
+
+  /**
+   * Sorted by Item::waypoint_id.  Waypoints which are not in this
+   * list are out of range, and thus unreachable.
+   */
+  TrivialArray<Item, MAX_ITEMS> items;
+
+  void Clear() {
+    version = 0;
+    items.clear();
+  }
+
+  gcc_pure
+  const Item *Find(unsigned waypoint_id) const {
+    auto i = std::lower_bound(items.begin(), items.end(), waypoint_id);
+    return i != items.end() && i->waypoint_id == waypoint_id
+      ? i
+      : nullptr;
+  }
+};
+
+static_assert(is_trivial_ndebug<WaypointReachInfo>::value, "type is not trivial");
+
+/**
+ * The #WaypointReachInfo written by the calculation thread and read
+ * by the map renderer.
+ */
+class ProtectedWaypointReach : public Guard<WaypointReachInfo> {
+  WaypointReachInfo info;
+
+public:
+  ProtectedWaypointReach():Guard<WaypointReachInfo>(info) {
+    info.Clear();
+  }
+};
+
+#endif
@@ -0,0 +1,153 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_EPOLL_HPP
+#define XCSOAR_EPOLL_HPP
+
+#include "Compiler.h"
+
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <errno.h>
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * A wrapper for a Linux epoll file descriptor.  Unlike #Poll, the
+ * kernel keeps the interest list, so registering a file descriptor
+ * costs one system call and waiting does not need to copy the whole
+ * list into the kernel each time.  Each registration carries a
+ * pointer which is returned with its events, which saves the caller
+ * a lookup.  It is not thread safe.
+ */
+class EPoll {
+  static constexpr unsigned MAX_EVENTS = 16;
+
+  int fd;
+
+  unsigned n_events;
+
+  struct epoll_event events[MAX_EVENTS];
+
+public:
+  /**
+   * Mask bit for "file is ready for reading".
+   */
+  static constexpr unsigned READ = EPOLLIN;
+
+  /**
+   * Mask bit for "file is ready for writing".
+   */
+  static constexpr unsigned WRITE = EPOLLOUT;
+
+  /**
+   * Mask bit for edge-triggered notification.  The handler must
+   * consume all available data (until EAGAIN) or it will not be
+   * notified again.
+   */
+  static constexpr unsigned EDGE = EPOLLET;
+
+  EPoll():fd(::epoll_create1(EPOLL_CLOEXEC)), n_events(0) {
+    if (fd < 0) {
+      /* without it, no I/O would ever be dispatched */
+      perror("epoll_create1() failed");
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  ~EPoll() {
+    if (fd >= 0)
+      ::close(fd);
+  }
+
+  EPoll(const EPoll &) = delete;
+  EPoll &operator=(const EPoll &) = delete;
+
+  bool IsDefined() const {
+    return fd >= 0;
+  }
+
+  /**
+   * Register a file descriptor, or update an existing registration.
+   *
+   * @param mask the bit mask of interesting events; must not be 0
+   * @param ptr an opaque pointer which will be returned with each
+   * event
+   */
+  bool Set(int _fd, unsigned mask, void *ptr) {
+    assert(mask != 0);
+
+    struct epoll_event e;
+    e.events = mask;
+    e.data.ptr = ptr;
+
+    if (::epoll_ctl(fd, EPOLL_CTL_MOD, _fd, &e) == 0)
+      return true;
+
+    /* the descriptor may have been closed and its number reused
+       since it was last registered; the kernel has forgotten it
+       then */
+    return errno == ENOENT && ::epoll_ctl(fd, EPOLL_CTL_ADD, _fd, &e) == 0;
+  }
+
+  /**
+   * Unregister a file descriptor.  Errors are ignored, because
+   * closing a file descriptor removes it implicitly.
+   */
+  void Remove(int _fd) {
+    struct epoll_event dummy;
+    ::epoll_ctl(fd, EPOLL_CTL_DEL, _fd, &dummy);
+  }
+
+  /**
+   * Wait for an event on any of the registered file descriptors.
+   *
+   * @param timeout_ms a timeout in milliseconds; the method will
+   * return successfully if the timeout has expired; -1 means no
+   * timeout (the default)
+   * @return false on error
+   */
+  bool Wait(int timeout_ms=-1) {
+    int result = ::epoll_wait(fd, events, MAX_EVENTS, timeout_ms);
+    n_events = result > 0 ? result : 0;
+    return result >= 0;
+  }
+
+  typedef const struct epoll_event *const_iterator;
+
+  /**
+   * Iterate over the events returned by the last Wait() call.
+   */
+  gcc_pure
+  const_iterator begin() const {
+    return events;
+  }
+
+  gcc_pure
+  const_iterator end() const {
+    return events + n_events;
+  }
+};
+
+#endif
@@ -40,6 +40,7 @@
 #define HAVE_EVENTFD
 #define HAVE_SIGNALFD
 #define HAVE_INOTIFY
+#define HAVE_EPOLL
 #include <signal.h>
 #endif
 
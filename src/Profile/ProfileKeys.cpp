@@ -187,6 +187,7 @@ const char FinishRadius[] = "FinishRadius";
 const char TaskType[] = "TaskType";
 const char AATMinTime[] = "AATMinTime";
 const char AATTimeMargin[] = "AATTimeMargin";
+const char AATTargetOptimiser[] = "AATTargetOptimiser";
 const char TaskPlanningSpeedMode[] = "TaskPlanningSpeedMode";
 const char TaskPlanningSpeedOverride[] = "TaskPlanningSpeedOverride";
 const char ContestNationality[] = "ContestNationality";
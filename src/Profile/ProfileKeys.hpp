@@ -181,6 +181,7 @@ extern const char FinishRadius[];
 extern const char TaskType[];
 extern const char AATMinTime[];
 extern const char AATTimeMargin[];
+extern const char AATTargetOptimiser[];
 extern const char TaskPlanningSpeedMode[];
 extern const char TaskPlanningSpeedOverride[];
 extern const char ContestNationality[];
@@ -91,6 +91,7 @@ Profile::Load(const ProfileMap &map, TaskBehaviour &settings)
   map.GetEnum(ProfileKeys::TaskPlanningSpeedMode, settings.task_planning_speed_mode);
   map.Get(ProfileKeys::TaskPlanningSpeedOverride, settings.task_planning_speed_override);
   map.Get(ProfileKeys::AATTimeMargin, settings.optimise_targets_margin);
+  map.GetEnum(ProfileKeys::AATTargetOptimiser, settings.target_optimiser);
   map.Get(ProfileKeys::AutoMc, settings.auto_mc);
   map.GetEnum(ProfileKeys::AutoMcMode, settings.auto_mc_mode);
 
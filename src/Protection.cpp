@@ -107,6 +107,7 @@ CreateCalculationThread()
 
   /* copy GlideComputer results to DeviceBlackboard */
   device_blackboard->ReadBlackboard(glide_computer->Calculated());
+  device_blackboard->PublishCalculated(glide_computer->Calculated());
   if (is_simulator())
     device_blackboard->ReadSimulatorAirspeeds(glide_computer->Basic());
 
@@ -42,6 +42,7 @@ class ProtectedAirspaceWarningManager;
 class AirspaceWarningCopy;
 class Canvas;
 class WindowProjection;
+class AirspaceVertexBuffer;
 
 class AirspaceRenderer
 {
@@ -60,6 +61,12 @@ class AirspaceRenderer
   TransparentRendererCache fill_cache;
 
   unsigned last_warning_serial;
+#else
+  /**
+   * All airspace polygons in video memory; only allocated after
+   * EnableVertexBuffer() has been called.
+   */
+  AirspaceVertexBuffer *vertex_buffer;
 #endif
 
 public:
@@ -67,9 +74,17 @@ public:
     :look(_look), airspaces(nullptr), warning_manager(nullptr)
 #ifndef ENABLE_OPENGL
     , last_warning_serial(0)
+#else
+    , vertex_buffer(nullptr)
 #endif
   {}
 
+  AirspaceRenderer(const AirspaceRenderer &) = delete;
+
+#ifdef ENABLE_OPENGL
+  ~AirspaceRenderer();
+#endif
+
   const AirspaceLook &GetLook() const {
     return look;
   }
@@ -101,6 +116,18 @@ public:
 #endif
   }
 
+  /**
+   * Keep all airspace polygons (and their triangulation) in video
+   * memory, to avoid projecting and triangulating them in each frame.
+   * This is only worth it for a map which is redrawn continuously;
+   * it's a no-op without OpenGL.
+   */
+#ifdef ENABLE_OPENGL
+  void EnableVertexBuffer();
+#else
+  void EnableVertexBuffer() {}
+#endif
+
 private:
 #ifndef ENABLE_OPENGL
   bool DrawFill(Canvas &buffer_canvas, Canvas &stencil_canvas,
@@ -25,6 +25,7 @@ Copyright_License {
 
 #include "AirspaceRenderer.hpp"
 #include "AirspaceRendererSettings.hpp"
+#include "AirspaceVertexBuffer.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "Screen/Canvas.hpp"
 #include "MapWindow/MapCanvas.hpp"
@@ -36,20 +37,94 @@ Copyright_License {
 #include "Airspace/AirspaceWarningCopy.hpp"
 #include "Screen/OpenGL/Scope.hpp"
 
+/**
+ * Draws airspace polygons from the #AirspaceVertexBuffer if
+ * available, and falls back to projecting them to screen coordinates
+ * with #MapCanvas.
+ */
+class AirspacePolygonCanvas : protected MapCanvas {
+  AirspaceVertexBuffer *const vertex_buffer;
+
+  const AbstractAirspace *prepared_airspace;
+  bool prepared_visible;
+
+protected:
+  AirspacePolygonCanvas(Canvas &_canvas, const WindowProjection &_projection,
+                        AirspaceVertexBuffer *_vertex_buffer)
+    :MapCanvas(_canvas, _projection,
+               _projection.GetScreenBounds().Scale(fixed(1.1))),
+     vertex_buffer(_vertex_buffer), prepared_airspace(nullptr)
+  {
+    if (vertex_buffer != nullptr)
+      vertex_buffer->SetProjection(_projection);
+  }
+
+  /**
+   * Project the polygon to screen coordinates, unless that was
+   * already done for this airspace.
+   *
+   * @return false if the polygon is not visible
+   */
+  bool Prepare(const AirspacePolygon &airspace) {
+    if (&airspace != prepared_airspace) {
+      prepared_airspace = &airspace;
+      prepared_visible = PreparePolygon(airspace.GetPoints());
+    }
+
+    return prepared_visible;
+  }
+
+  /**
+   * Fill the polygon with the given color.  The selected brush must
+   * have the same color, for the #Canvas fallback.
+   */
+  void DrawFill(const AirspacePolygon &airspace, const Color color) {
+    if (vertex_buffer != nullptr) {
+      color.Bind();
+      if (vertex_buffer->DrawFill(airspace))
+        return;
+    }
+
+    if (Prepare(airspace))
+      DrawPrepared();
+  }
+
+  /**
+   * Draw the polygon outline with the given pen, which must be
+   * selected in the #Canvas (together with a hollow brush) for the
+   * fallback.  Thick pens need triangulated lines in screen
+   * coordinates, so only thin ones use the #AirspaceVertexBuffer.
+   */
+  void DrawOutline(const AirspacePolygon &airspace, const Pen &pen) {
+    if (vertex_buffer != nullptr && pen.GetWidth() <= 2) {
+      pen.Bind();
+      const bool drawn = vertex_buffer->DrawOutline(airspace);
+      pen.Unbind();
+      if (drawn)
+        return;
+    }
+
+    if (Prepare(airspace))
+      DrawPrepared();
+  }
+};
+
 class AirspaceVisitorRenderer final
-  : public AirspaceVisitor, protected MapCanvas
+  : public AirspaceVisitor, protected AirspacePolygonCanvas
 {
   const AirspaceLook &look;
   const AirspaceWarningCopy &warning_manager;
   const AirspaceRendererSettings &settings;
 
+  Pen outline_pen;
+
 public:
   AirspaceVisitorRenderer(Canvas &_canvas, const WindowProjection &_projection,
+                          AirspaceVertexBuffer *_vertex_buffer,
                           const AirspaceLook &_look,
                           const AirspaceWarningCopy &_warnings,
                           const AirspaceRendererSettings &_settings)
-    :MapCanvas(_canvas, _projection,
-               _projection.GetScreenBounds().Scale(fixed(1.1))),
+    :AirspacePolygonCanvas(_canvas, _projection, _vertex_buffer),
      look(_look), warning_manager(_warnings), settings(_settings)
   {
     glStencilMask(0xff);
@@ -100,9 +175,6 @@ private:
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    if (!PreparePolygon(airspace.GetPoints()))
-      return;
-
     const AirspaceClassRendererSettings &class_settings =
       settings.classes[airspace.GetType()];
 
@@ -117,6 +189,11 @@ private:
       const GLEnable<GL_STENCIL_TEST> stencil;
 
       if (!fill_airspace) {
+        /* the padding is a thick line, which needs screen
+           coordinates */
+        if (!Prepare(airspace))
+          return;
+
         // set stencil for filling (bit 0)
         SetFillStencil();
         DrawPrepared();
@@ -125,9 +202,9 @@ private:
 
       // fill interior without overpainting any previous outlines
       {
-        SetupInterior(airspace, !fill_airspace);
+        const Color color = SetupInterior(airspace, !fill_airspace);
         const GLEnable<GL_BLEND> blend;
-        DrawPrepared();
+        DrawFill(airspace, color);
       }
 
       if (!fill_airspace) {
@@ -140,7 +217,7 @@ private:
 
     // draw outline
     if (SetupOutline(airspace))
-      DrawPrepared();
+      DrawOutline(airspace, outline_pen);
   }
 
 protected:
@@ -161,12 +238,14 @@ private:
     AirspaceClass type = airspace.GetType();
 
     if (settings.black_outline)
-      canvas.SelectBlackPen();
+      outline_pen = Pen(1, COLOR_BLACK);
     else if (settings.classes[type].border_width == 0)
       // Don't draw outlines if border_width == 0
       return false;
     else
-      canvas.Select(look.classes[type].border_pen);
+      outline_pen = look.classes[type].border_pen;
+
+    canvas.Select(outline_pen);
 
     canvas.SelectHollowBrush();
 
@@ -178,8 +257,8 @@ private:
     return true;
   }
 
-  void SetupInterior(const AbstractAirspace &airspace,
-                     bool check_fillstencil = false) {
+  Color SetupInterior(const AbstractAirspace &airspace,
+                      bool check_fillstencil = false) {
     const AirspaceClassLook &class_look = look.classes[airspace.GetType()];
 
     // restrict drawing area and don't paint over previously drawn outlines
@@ -189,8 +268,10 @@ private:
       glStencilFunc(GL_EQUAL, 0, 2);
     glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
 
-    canvas.Select(Brush(class_look.fill_color.WithAlpha(90)));
+    const Color color = class_look.fill_color.WithAlpha(90);
+    canvas.Select(Brush(color));
     canvas.SelectNullPen();
+    return color;
   }
 
   void SetFillStencil() {
@@ -215,19 +296,22 @@ private:
 };
 
 class AirspaceFillRenderer final
-  : public AirspaceVisitor, protected MapCanvas
+  : public AirspaceVisitor, protected AirspacePolygonCanvas
 {
   const AirspaceLook &look;
   const AirspaceWarningCopy &warning_manager;
   const AirspaceRendererSettings &settings;
 
+  Color fill_color;
+  Pen outline_pen;
+
 public:
   AirspaceFillRenderer(Canvas &_canvas, const WindowProjection &_projection,
+                       AirspaceVertexBuffer *_vertex_buffer,
                        const AirspaceLook &_look,
                        const AirspaceWarningCopy &_warnings,
                        const AirspaceRendererSettings &_settings)
-    :MapCanvas(_canvas, _projection,
-               _projection.GetScreenBounds().Scale(fixed(1.1))),
+    :AirspacePolygonCanvas(_canvas, _projection, _vertex_buffer),
      look(_look), warning_manager(_warnings), settings(_settings)
   {
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -249,18 +333,15 @@ private:
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    if (!PreparePolygon(airspace.GetPoints()))
-      return;
-
     if (!warning_manager.IsAcked(airspace) && SetupInterior(airspace)) {
       // fill interior without overpainting any previous outlines
       GLEnable<GL_BLEND> blend;
-      DrawPrepared();
+      DrawFill(airspace, fill_color);
     }
 
     // draw outline
     if (SetupOutline(airspace))
-      DrawPrepared();
+      DrawOutline(airspace, outline_pen);
   }
 
 protected:
@@ -281,12 +362,14 @@ private:
     AirspaceClass type = airspace.GetType();
 
     if (settings.black_outline)
-      canvas.SelectBlackPen();
+      outline_pen = Pen(1, COLOR_BLACK);
     else if (settings.classes[type].border_width == 0)
       // Don't draw outlines if border_width == 0
       return false;
     else
-      canvas.Select(look.classes[type].border_pen);
+      outline_pen = look.classes[type].border_pen;
+
+    canvas.Select(outline_pen);
 
     canvas.SelectHollowBrush();
 
@@ -299,7 +382,8 @@ private:
 
     const AirspaceClassLook &class_look = look.classes[airspace.GetType()];
 
-    canvas.Select(Brush(class_look.fill_color.WithAlpha(48)));
+    fill_color = class_look.fill_color.WithAlpha(48);
+    canvas.Select(Brush(fill_color));
     canvas.SelectNullPen();
 
     return true;
@@ -313,18 +397,35 @@ AirspaceRenderer::DrawInternal(Canvas &canvas,
                                const AirspaceWarningCopy &awc,
                                const AirspacePredicate &visible)
 {
+  if (vertex_buffer != nullptr)
+    vertex_buffer->Update(*airspaces);
+
   if (settings.fill_mode == AirspaceRendererSettings::FillMode::ALL ||
       settings.fill_mode == AirspaceRendererSettings::FillMode::NONE) {
-    AirspaceFillRenderer renderer(canvas, projection, look, awc, settings);
+    AirspaceFillRenderer renderer(canvas, projection, vertex_buffer,
+                                  look, awc, settings);
     airspaces->VisitWithinRange(projection.GetGeoScreenCenter(),
                                 projection.GetScreenDistanceMeters(),
                                 renderer, visible);
   } else {
-    AirspaceVisitorRenderer renderer(canvas, projection, look, awc, settings);
+    AirspaceVisitorRenderer renderer(canvas, projection, vertex_buffer,
+                                     look, awc, settings);
     airspaces->VisitWithinRange(projection.GetGeoScreenCenter(),
                                 projection.GetScreenDistanceMeters(),
                                 renderer, visible);
   }
 }
 
+AirspaceRenderer::~AirspaceRenderer()
+{
+  delete vertex_buffer;
+}
+
+void
+AirspaceRenderer::EnableVertexBuffer()
+{
+  if (vertex_buffer == nullptr)
+    vertex_buffer = new AirspaceVertexBuffer();
+}
+
 #endif /* ENABLE_OPENGL */
@@ -0,0 +1,238 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifdef ENABLE_OPENGL
+
+#include "AirspaceVertexBuffer.hpp"
+#include "Airspace/Airspaces.hpp"
+#include "Airspace/AbstractAirspace.hpp"
+#include "Projection/WindowProjection.hpp"
+#include "Screen/OpenGL/FallbackBuffer.hpp"
+#include "Screen/OpenGL/VertexPointer.hpp"
+#include "Screen/OpenGL/Triangulate.hpp"
+#include "Screen/OpenGL/Geo.hpp"
+#include "Math/Point2D.hpp"
+
+#ifdef USE_GLSL
+#include "Screen/OpenGL/Program.hpp"
+#include "Screen/OpenGL/Shaders.hpp"
+
+#include <glm/gtc/type_ptr.hpp>
+#endif
+
+#include <algorithm>
+
+#include <assert.h>
+
+AirspaceVertexBuffer::AirspaceVertexBuffer()
+  :airspaces(nullptr), array_buffer(nullptr)
+{
+  AddSurfaceListener(*this);
+}
+
+AirspaceVertexBuffer::~AirspaceVertexBuffer()
+{
+  RemoveSurfaceListener(*this);
+
+  delete array_buffer;
+}
+
+void
+AirspaceVertexBuffer::Update(const Airspaces &_airspaces)
+{
+  if (array_buffer != nullptr && &_airspaces == airspaces &&
+      _airspaces.GetSerial() == serial)
+    return;
+
+  Build(_airspaces);
+}
+
+void
+AirspaceVertexBuffer::Build(const Airspaces &_airspaces)
+{
+  airspaces = &_airspaces;
+  serial = _airspaces.GetSerial();
+
+  shapes.clear();
+  indices.clear();
+
+  reference = _airspaces.GetProjection().IsValid()
+    ? _airspaces.GetProjection().GetCenter()
+    : GeoPoint::Invalid();
+
+  unsigned n = 0;
+  for (const auto &i : _airspaces) {
+    const AbstractAirspace &airspace = i.GetAirspace();
+    if (airspace.GetShape() != AbstractAirspace::Shape::POLYGON)
+      continue;
+
+    const unsigned n_vertices = airspace.GetPoints().size();
+    if (n_vertices < 3)
+      continue;
+
+    if (!reference.IsValid())
+      reference = airspace.GetReferenceLocation();
+
+    Shape &shape = shapes[&airspace];
+    shape.offset = n;
+    shape.n_vertices = n_vertices;
+    shape.first_index = 0;
+    shape.n_indices = 0;
+    n += n_vertices;
+  }
+
+  /* project into a temporary buffer first; the triangulation needs
+     to read the vertices, and BeginWrite() may return write-only
+     mapped memory */
+  std::vector<FloatPoint> vertices(n);
+
+  for (const auto &i : _airspaces) {
+    const AbstractAirspace &airspace = i.GetAirspace();
+    auto s = shapes.find(&airspace);
+    if (s == shapes.end())
+      continue;
+
+    Shape &shape = s->second;
+    FloatPoint *p = vertices.data() + shape.offset;
+    for (const auto &point : airspace.GetPoints()) {
+      const GeoPoint relative = point.GetLocation() - reference;
+      *p++ = FloatPoint(float(relative.longitude.Native()),
+                        float(relative.latitude.Native()));
+    }
+
+    /* GLushort indices can't address larger polygons; those are
+       filled by the caller in screen coordinates */
+    if (shape.n_vertices >= 0x10000)
+      continue;
+
+    /* the triangulation is invariant under the affine transformation
+       applied by the modelview matrix, so it needs to be done only
+       once */
+    const unsigned first_index = indices.size();
+    indices.resize(first_index + 3 * (shape.n_vertices - 2));
+    const unsigned n_indices =
+      PolygonToTriangles(vertices.data() + shape.offset, shape.n_vertices,
+                         indices.data() + first_index, 0);
+    indices.resize(first_index + n_indices);
+
+    shape.first_index = first_index;
+    shape.n_indices = n_indices;
+  }
+
+  if (array_buffer == nullptr)
+    array_buffer = new GLFallbackArrayBuffer();
+
+  if (n == 0)
+    return;
+
+  FloatPoint *p = (FloatPoint *)
+    array_buffer->BeginWrite(n * sizeof(*p));
+  assert(p != nullptr);
+
+  std::copy(vertices.begin(), vertices.end(), p);
+  array_buffer->CommitWrite(n * sizeof(*p), p);
+}
+
+void
+AirspaceVertexBuffer::SetProjection(const WindowProjection &_projection)
+{
+#ifdef USE_GLSL
+  matrix = ToGLM(_projection, reference);
+#else
+  projection = &_projection;
+#endif
+}
+
+template<typename F>
+inline void
+AirspaceVertexBuffer::Draw(const Shape &shape, F &&f)
+{
+#ifdef USE_GLSL
+  OpenGL::solid_shader->Use();
+  glUniformMatrix4fv(OpenGL::solid_modelview, 1, GL_FALSE,
+                     glm::value_ptr(matrix));
+#else
+  glPushMatrix();
+  ApplyProjection(*projection, reference);
+#endif
+
+  const FloatPoint *const base = (const FloatPoint *)array_buffer->BeginRead();
+
+  {
+    const ScopeVertexPointer vp(base + shape.offset);
+    f();
+  }
+
+  array_buffer->EndRead();
+
+#ifdef USE_GLSL
+  glUniformMatrix4fv(OpenGL::solid_modelview, 1, GL_FALSE,
+                     glm::value_ptr(glm::mat4()));
+#else
+  glPopMatrix();
+#endif
+}
+
+bool
+AirspaceVertexBuffer::DrawFill(const AbstractAirspace &airspace)
+{
+  const Shape *shape = Find(airspace);
+  if (shape == nullptr || shape->n_indices == 0)
+    return false;
+
+  const GLushort *const triangles = indices.data() + shape->first_index;
+  const unsigned n_indices = shape->n_indices;
+  Draw(*shape, [triangles, n_indices](){
+      glDrawElements(GL_TRIANGLES, n_indices, GL_UNSIGNED_SHORT, triangles);
+    });
+  return true;
+}
+
+bool
+AirspaceVertexBuffer::DrawOutline(const AbstractAirspace &airspace)
+{
+  const Shape *shape = Find(airspace);
+  if (shape == nullptr)
+    return false;
+
+  const unsigned n_vertices = shape->n_vertices;
+  Draw(*shape, [n_vertices](){
+      glDrawArrays(GL_LINE_LOOP, 0, n_vertices);
+    });
+  return true;
+}
+
+void
+AirspaceVertexBuffer::SurfaceCreated()
+{
+}
+
+void
+AirspaceVertexBuffer::SurfaceDestroyed()
+{
+  delete array_buffer;
+  array_buffer = nullptr;
+  shapes.clear();
+}
+
+#endif /* ENABLE_OPENGL */
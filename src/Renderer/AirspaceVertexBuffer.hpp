@@ -0,0 +1,139 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_AIRSPACE_VERTEX_BUFFER_HPP
+#define XCSOAR_AIRSPACE_VERTEX_BUFFER_HPP
+
+#include "Screen/OpenGL/Surface.hpp"
+#include "Screen/OpenGL/System.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "Util/Serial.hpp"
+#include "Compiler.h"
+
+#ifdef USE_GLSL
+#include <glm/glm.hpp>
+#endif
+
+#include <unordered_map>
+#include <vector>
+
+class Airspaces;
+class AbstractAirspace;
+class WindowProjection;
+class GLFallbackArrayBuffer;
+
+/**
+ * Keeps the vertices of all airspace polygons in an OpenGL buffer,
+ * together with their triangulation.  The vertices are stored as
+ * longitude/latitude offsets from a fixed reference point, and the
+ * map projection is applied by the modelview matrix (like
+ * #TopographyFileRenderer does), so panning, zooming and rotating the
+ * map does not touch them.
+ *
+ * The buffer is rebuilt when the #Airspaces serial changes.
+ */
+class AirspaceVertexBuffer final : GLSurfaceListener {
+  struct Shape {
+    /**
+     * The index of the first vertex in #array_buffer.
+     */
+    unsigned offset;
+
+    unsigned n_vertices;
+
+    /**
+     * The triangulation in #indices, relative to #offset.
+     * #n_indices is zero if the polygon could not be triangulated.
+     */
+    unsigned first_index, n_indices;
+  };
+
+  const Airspaces *airspaces;
+  Serial serial;
+
+  GeoPoint reference;
+
+  GLFallbackArrayBuffer *array_buffer;
+
+  std::vector<GLushort> indices;
+
+  std::unordered_map<const AbstractAirspace *, Shape> shapes;
+
+#ifdef USE_GLSL
+  glm::mat4 matrix;
+#else
+  const WindowProjection *projection;
+#endif
+
+public:
+  AirspaceVertexBuffer();
+  ~AirspaceVertexBuffer();
+
+  /**
+   * Rebuild the buffer if the given #Airspaces object is not the one
+   * the buffer was built from, or if it has been modified since.
+   */
+  void Update(const Airspaces &airspaces);
+
+  /**
+   * Prepare drawing with the given projection.  Must be called
+   * before DrawFill() and DrawOutline().
+   */
+  void SetProjection(const WindowProjection &projection);
+
+  /**
+   * Fill the interior of the given airspace with the current solid
+   * color.
+   *
+   * @return false if the airspace is not in the buffer; the caller
+   * should fall back to projecting and drawing it on the #Canvas
+   */
+  bool DrawFill(const AbstractAirspace &airspace);
+
+  /**
+   * Draw the outline of the given airspace with the currently bound
+   * #Pen.  This uses GL_LINE_LOOP, which is only suitable for thin
+   * pens (see Canvas::DrawPolygon()).
+   *
+   * @return false if the airspace is not in the buffer
+   */
+  bool DrawOutline(const AbstractAirspace &airspace);
+
+private:
+  gcc_pure
+  const Shape *Find(const AbstractAirspace &airspace) const {
+    auto i = shapes.find(&airspace);
+    return i != shapes.end() ? &i->second : nullptr;
+  }
+
+  void Build(const Airspaces &airspaces);
+
+  template<typename F>
+  void Draw(const Shape &shape, F &&f);
+
+  /* from GLSurfaceListener */
+  void SurfaceCreated() override;
+  void SurfaceDestroyed() override;
+};
+
+#endif
@@ -62,6 +62,11 @@ public:
   void SetShadingAngle(const WindowProjection &projection,
                        const TerrainRendererSettings &settings,
                        const DerivedInfo &calculated);
+
+  Angle GetShadingAngle() const {
+    return shading_angle;
+  }
+
   void Reset();
   void SetTerrain(const RasterTerrain *terrain);
   void SetWeather(const RasterWeatherCache *weather);
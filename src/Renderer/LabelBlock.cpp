@@ -23,12 +23,6 @@ Copyright_License {
 
 #include "LabelBlock.hpp"
 
-void
-LabelBlock::Bucket::Clear()
-{
-  blocks.clear();
-}
-
 static gcc_pure bool
 CheckRectOverlap(const PixelRect& rc1, const PixelRect& rc2)
 {
@@ -37,10 +31,10 @@ CheckRectOverlap(const PixelRect& rc1, const PixelRect& rc2)
 }
 
 bool
-LabelBlock::Bucket::Check(const PixelRect rc) const
+LabelBlock::Cell::Check(const PixelRect rc, const PixelRect *blocks) const
 {
-  for (auto i = blocks.begin(), end = blocks.end(); i != end; ++i)
-    if (CheckRectOverlap(*i, rc))
+  for (auto i = indices.begin(), end = indices.end(); i != end; ++i)
+    if (CheckRectOverlap(blocks[*i], rc))
       return false;
 
   return true;
@@ -48,29 +42,39 @@ LabelBlock::Bucket::Check(const PixelRect rc) const
 
 void LabelBlock::reset()
 {
-  for (unsigned i = 0; i < BUCKET_COUNT; ++i)
-    buckets[i].Clear();
+  for (const auto &rc : blocks) {
+    const CellRange r = GetCellRange(rc);
+    for (unsigned y = r.top; y <= r.bottom; ++y)
+      for (unsigned x = r.left; x <= r.right; ++x)
+        cells[y][x].Clear();
+  }
+
+  blocks.clear();
 }
 
 bool LabelBlock::check(const PixelRect rc, bool add_no_check)
 {
-  unsigned top = rc.top >> BUCKET_SHIFT;
-  unsigned bottom = rc.bottom >> BUCKET_SHIFT;
-
-  if (top >= BUCKET_COUNT)
-    top = BUCKET_COUNT - 1;
+  const CellRange r = GetCellRange(rc);
 
   if (!add_no_check) {
-    if (bottom < BUCKET_COUNT && !buckets[bottom].Check(rc))
+    if (blocks.full())
       return false;
 
-    if (top < bottom && !buckets[top].Check(rc))
-      return false;
-  }
-
-  buckets[top].Add(rc);
-  if (bottom < BUCKET_COUNT && top != bottom)
-    buckets[bottom].Add(rc);
+    for (unsigned y = r.top; y <= r.bottom; ++y)
+      for (unsigned x = r.left; x <= r.right; ++x)
+        if (cells[y][x].IsFull() ||
+            !cells[y][x].Check(rc, blocks.begin()))
+          return false;
+  } else if (blocks.full())
+    /* draw it, but it cannot be registered */
+    return true;
+
+  const unsigned index = blocks.size();
+  blocks.append(rc);
+
+  for (unsigned y = r.top; y <= r.bottom; ++y)
+    for (unsigned x = r.left; x <= r.right; ++x)
+      cells[y][x].Add(index);
 
   return true;
 }
@@ -28,54 +28,113 @@ Copyright_License {
 #include "Util/StaticArray.hpp"
 #include "Compiler.h"
 
+#include <algorithm>
+
+#include <stdint.h>
+
 /**
  * Simple code to prevent text writing over map city names.
+ *
+ * The screen is divided into a two-dimensional grid of square cells.
+ * Each accepted rectangle is registered in all cells it covers, so a
+ * hit test only needs to look at the few rectangles which are near
+ * the candidate, instead of a whole horizontal band of the screen.
  */
 class LabelBlock {
 #if defined(_WIN32_WCE) && _WIN32_WCE < 0x400
   /* PPC2000 (ancient hardware, expect small screens) */
-  static constexpr unsigned SCREEN_HEIGHT = 1024;
-  static constexpr unsigned BUCKET_SIZE = 32;
+  static constexpr unsigned SCREEN_SIZE = 1024;
+  static constexpr unsigned MAX_BLOCKS = 256;
+  static constexpr unsigned CELL_SIZE = 16;
 #elif defined(_WIN32_WCE) || defined(HAVE_GLES)
   /* embedded (Android or Windows CE) */
-  static constexpr unsigned SCREEN_HEIGHT = 2048;
-  static constexpr unsigned BUCKET_SIZE = 64;
+  static constexpr unsigned SCREEN_SIZE = 2048;
+  static constexpr unsigned MAX_BLOCKS = 512;
+  static constexpr unsigned CELL_SIZE = 32;
 #else
   /* desktop, screen may be huge, lots of memory */
-  static constexpr unsigned SCREEN_HEIGHT = 4096;
-  static constexpr unsigned BUCKET_SIZE = 64;
+  static constexpr unsigned SCREEN_SIZE = 4096;
+  static constexpr unsigned MAX_BLOCKS = 1024;
+  static constexpr unsigned CELL_SIZE = 32;
 #endif
-  static constexpr unsigned BUCKET_SHIFT = 7;
-  static constexpr unsigned BUCKET_HEIGHT = 1 << BUCKET_SHIFT;
-  static constexpr unsigned BUCKET_COUNT = SCREEN_HEIGHT / BUCKET_HEIGHT;
+
+  static constexpr unsigned CELL_SHIFT = 7;
+  static constexpr unsigned GRID_SIZE = SCREEN_SIZE >> CELL_SHIFT;
 
   /**
-   * A bucket is responsible for hit tests in one horizontal section
-   * of the screen.
+   * A cell is responsible for hit tests in one square section of the
+   * screen.  It refers to rectangles in #blocks by their index.
    */
-  class Bucket {
-    typedef StaticArray<PixelRect, BUCKET_SIZE> BlockArray;
-    BlockArray blocks;
+  class Cell {
+    typedef StaticArray<uint16_t, CELL_SIZE> IndexArray;
+    IndexArray indices;
 
   public:
-    void Clear();
+    void Clear() {
+      indices.clear();
+    }
 
     gcc_pure
-    bool Check(const PixelRect rc) const;
+    bool Check(const PixelRect rc, const PixelRect *blocks) const;
 
-    void Add(const PixelRect rc) {
-      if (!blocks.full())
-        blocks.append(rc);
+    /**
+     * Is this cell unable to register another rectangle?  New
+     * labels touching it must be rejected then, because their
+     * overlap could not be detected later.
+     */
+    bool IsFull() const {
+      return indices.full();
     }
+
+    /**
+     * Register a rectangle.  A full cell ignores it; this can only
+     * happen for labels added without a check.
+     */
+    void Add(unsigned index) {
+      if (!indices.full())
+        indices.append(index);
+    }
+  };
+
+  /**
+   * The range of cells covered by a rectangle, clipped to the grid.
+   */
+  struct CellRange {
+    unsigned left, top, right, bottom;
   };
 
-  Bucket buckets[BUCKET_COUNT];
+  StaticArray<PixelRect, MAX_BLOCKS> blocks;
+
+  Cell cells[GRID_SIZE][GRID_SIZE];
+
+  gcc_const
+  static unsigned ToCell(PixelScalar p) {
+    return p <= 0
+      ? 0u
+      : std::min(unsigned(p) >> CELL_SHIFT, GRID_SIZE - 1);
+  }
+
+  gcc_const
+  static CellRange GetCellRange(const PixelRect rc) {
+    return { ToCell(rc.left), ToCell(rc.top),
+        ToCell(rc.right), ToCell(rc.bottom) };
+  }
 
 public:
   /**
+   * Checks whether the rectangle is free, and if so, registers it.
+   * A rectangle is also rejected when there is no room to register
+   * it, so overlapping labels are never let through.
+   *
    * @param add_no_check.  adds the label regardless of overlap
    */
   bool check(const PixelRect rc, bool add_no_check = false);
+
+  /**
+   * Removes all rectangles.  Only the cells which were actually used
+   * are cleared, so the cost is proportional to the number of labels
+   * drawn in the last frame, not to the size of the grid.
+   */
   void reset();
 };
 
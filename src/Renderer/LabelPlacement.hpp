@@ -0,0 +1,120 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_LABEL_PLACEMENT_HPP
+#define XCSOAR_LABEL_PLACEMENT_HPP
+
+#include "Screen/Point.hpp"
+#include "Compiler.h"
+
+/*
+ * Keeps map labels from flickering between frames.  The functions
+ * work on any range of labels which have the attributes "Pos",
+ * "placed" (was the label drawn in the last frame) and "placed_pos"
+ * (where), and a Visible() method, e.g. WaypointLabelList::Label.
+ */
+
+/**
+ * Returns the offset by which most of the labels drawn in the last
+ * frame have moved since then, e.g. because the map was panned.
+ * All labels which moved by the same offset still don't overlap
+ * each other.
+ */
+template<typename R>
+gcc_pure
+RasterPoint
+GetLabelPlacementShift(const R &labels)
+{
+  /* Boyer-Moore majority vote */
+  RasterPoint shift((const RasterPoint){0, 0});
+  unsigned count = 0;
+
+  for (const auto &l : labels) {
+    if (!l.placed)
+      continue;
+
+    const RasterPoint delta((const RasterPoint)
+      { l.Pos.x - l.placed_pos.x, l.Pos.y - l.placed_pos.y });
+
+    if (count == 0) {
+      shift = delta;
+      count = 1;
+    } else if (delta.x == shift.x && delta.y == shift.y)
+      ++count;
+    else
+      --count;
+  }
+
+  return shift;
+}
+
+/**
+ * Was the label drawn in the last frame, and has it moved only by
+ * the given shift since then?  Such a label does not need to be
+ * tested against the LabelBlock again.
+ */
+template<typename L>
+gcc_pure
+bool
+IsLabelPlacementStable(const L &l, RasterPoint shift)
+{
+  return l.placed &&
+    l.Pos.x - l.placed_pos.x == shift.x &&
+    l.Pos.y - l.placed_pos.y == shift.y;
+}
+
+/**
+ * Places the visible labels in two passes.  The labels which were
+ * drawn in the last frame and have moved only with the map did not
+ * overlap each other, so they are drawn first and added to the
+ * LabelBlock without a hit test.  Only new or moved labels are
+ * tested, in priority order, which keeps labels from flickering when
+ * the priorities of nearby waypoints change slightly between frames.
+ *
+ * @param draw a function draw(label, skip_check) which draws the
+ * label (adding it to the LabelBlock, with or without a hit test)
+ * and returns whether it was drawn
+ */
+template<typename R, typename D>
+void
+PlaceLabels(R &labels, D &&draw)
+{
+  const RasterPoint shift = GetLabelPlacementShift(labels);
+
+  for (auto &l : labels) {
+    if (l.Visible() && IsLabelPlacementStable(l, shift)) {
+      draw(l, true);
+      l.placed_pos = l.Pos;
+    } else
+      l.placed = false;
+  }
+
+  for (auto &l : labels) {
+    if (l.Visible() && !l.placed) {
+      l.placed = draw(l, false);
+      l.placed_pos = l.Pos;
+    }
+  }
+}
+
+#endif
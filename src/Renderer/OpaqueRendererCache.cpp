@@ -0,0 +1,104 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "OpaqueRendererCache.hpp"
+#include "Projection/WindowProjection.hpp"
+
+#ifdef ENABLE_OPENGL
+#include "Screen/OpenGL/Globals.hpp"
+#include "Screen/OpenGL/System.hpp"
+#endif
+
+bool
+OpaqueRendererCache::Check(const WindowProjection &projection) const
+{
+  assert(projection.IsValid());
+
+  return buffer.IsDefined() &&
+    buffer.GetWidth() == projection.GetScreenWidth() &&
+    buffer.GetHeight() == projection.GetScreenHeight() &&
+    compare_projection.Compare(projection);
+}
+
+Canvas &
+OpaqueRendererCache::Begin(Canvas &canvas, const WindowProjection &projection)
+{
+  assert(canvas.IsDefined());
+  assert(projection.IsValid());
+
+  const PixelSize size(projection.GetScreenWidth(),
+                       projection.GetScreenHeight());
+
+#ifdef ENABLE_OPENGL
+  if (!buffer.IsDefined())
+    buffer.Create(canvas, size);
+
+  /* on OpenGL, this redirects all drawing into the frame buffer
+     object (and resizes it to match the screen) */
+  buffer.Begin(canvas);
+
+  scissor = OpenGL::frame_buffer_object && OpenGL::render_buffer_stencil &&
+    glIsEnabled(GL_SCISSOR_TEST);
+  if (scissor)
+    glDisable(GL_SCISSOR_TEST);
+#else
+  if (buffer.IsDefined())
+    buffer.Resize(size);
+  else
+    buffer.Create(canvas, size);
+#endif
+
+  compare_projection = CompareProjection(projection);
+  return buffer;
+}
+
+void
+OpaqueRendererCache::Commit(Canvas &canvas, const WindowProjection &projection)
+{
+  assert(canvas.IsDefined());
+  assert(projection.IsValid());
+  assert(buffer.IsDefined());
+
+#ifdef ENABLE_OPENGL
+  if (scissor)
+    glEnable(GL_SCISSOR_TEST);
+
+  buffer.Commit(canvas);
+#else
+  CopyTo(canvas, projection);
+#endif
+}
+
+void
+OpaqueRendererCache::CopyTo(Canvas &canvas, const WindowProjection &projection)
+{
+  assert(canvas.IsDefined());
+  assert(buffer.IsDefined());
+
+#ifdef ENABLE_OPENGL
+  buffer.CopyTo(canvas);
+#else
+  canvas.Copy(0, 0, projection.GetScreenWidth(), projection.GetScreenHeight(),
+              buffer, 0, 0);
+#endif
+}
@@ -0,0 +1,90 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_OPAQUE_RENDERER_CACHE_HPP
+#define XCSOAR_OPAQUE_RENDERER_CACHE_HPP
+
+#include "Projection/CompareProjection.hpp"
+#include "Screen/BufferCanvas.hpp"
+#include "Compiler.h"
+
+class Canvas;
+class WindowProjection;
+
+/**
+ * Helper class for caching a full-screen layer which covers
+ * everything below it, e.g. the terrain and topography background
+ * of the map.  The layer is rendered into an off-screen buffer (a
+ * frame buffer object on OpenGL) and copied to the screen as long
+ * as the projection and the caller's data key do not change.
+ *
+ * Unlike #TransparentRendererCache, this class works on OpenGL,
+ * because no colour keying is needed to compose an opaque layer.
+ */
+class OpaqueRendererCache {
+  CompareProjection compare_projection;
+  BufferCanvas buffer;
+
+#ifdef ENABLE_OPENGL
+  /**
+   * Was GL_SCISSOR_TEST enabled before Begin()?  The caller's scissor
+   * rectangle refers to screen coordinates, which don't apply to the
+   * frame buffer object.
+   */
+  bool scissor;
+#endif
+
+public:
+  void Invalidate() {
+    compare_projection.Clear();
+  }
+
+  /**
+   * Check if the cache can be used.
+   *
+   * @return true if the cache is valid for the given projection; the
+   * caller may skip to CopyTo()
+   */
+  gcc_pure
+  bool Check(const WindowProjection &projection) const;
+
+  /**
+   * Begin drawing to the cache.  Render to the returned Canvas.  Call
+   * Commit() when you're done.
+   */
+  Canvas &Begin(Canvas &canvas, const WindowProjection &projection);
+
+  /**
+   * Finish drawing to the cache, and copy the new contents to the
+   * given #Canvas.
+   */
+  void Commit(Canvas &canvas, const WindowProjection &projection);
+
+  /**
+   * Copy the cache to the given #Canvas.  Must only be called after
+   * Check() has returned true.
+   */
+  void CopyTo(Canvas &canvas, const WindowProjection &projection);
+};
+
+#endif
@@ -33,6 +33,11 @@ Copyright_License {
 #include "Engine/Contest/ContestTrace.hpp"
 #include "Util/Clamp.hpp"
 
+#ifdef USE_GLSL
+#include "Screen/OpenGL/Shaders.hpp"
+#include "Screen/OpenGL/Program.hpp"
+#endif
+
 #include <algorithm>
 
 bool
@@ -109,6 +114,41 @@ GetMinMax(TrailSettings::Type type, const TracePointVector &trace)
   return std::make_pair(value_min, value_max);
 }
 
+inline void
+TrailRenderer::DrawTrailLine(Canvas &canvas, RasterPoint a, RasterPoint b,
+                             const Pen &pen)
+{
+#ifdef ENABLE_OPENGL
+  line_batch.AddLine(a, b, pen);
+#else
+  canvas.Select(pen);
+  canvas.DrawLinePiece(a, b);
+#endif
+}
+
+inline void
+TrailRenderer::DrawTrailDot(Canvas &canvas, RasterPoint center,
+                            unsigned radius,
+                            const Brush &brush, const Pen *pen)
+{
+#ifdef ENABLE_OPENGL
+  /* the outline has the same color as the brush; draw the union of
+     both as one filled circle */
+  if (pen != nullptr)
+    radius += pen->GetWidth() / 2;
+
+  line_batch.AddDot(center, radius, brush.GetColor());
+#else
+  canvas.Select(brush);
+  if (pen != nullptr)
+    canvas.Select(*pen);
+  else
+    canvas.SelectNullPen();
+
+  canvas.DrawCircle(center.x, center.y, radius);
+#endif
+}
+
 void
 TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
                     const WindowProjection &projection, unsigned min_time,
@@ -142,6 +182,10 @@ TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
 
   const GeoBounds bounds = projection.GetScreenBounds().Scale(fixed(4));
 
+  /* the pen of the last segment, which is used to connect the trail
+   with the aircraft */
+  const Pen *last_pen = nullptr;
+
   RasterPoint last_point = RasterPoint(0, 0);
   bool last_valid = false;
   for (auto it = trace.begin(), end = trace.end(); it != end; ++it) {
@@ -159,40 +203,41 @@ TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
 
     if (last_valid) {
       if (settings.type == TrailSettings::Type::SIMPLE) {
-        canvas.Select(look.simple_pen);
-        canvas.DrawLinePiece(last_point, pt);
+        last_pen = &look.simple_pen;
+        DrawTrailLine(canvas, last_point, pt, *last_pen);
       } else if (settings.type == TrailSettings::Type::ALTITUDE) {
         unsigned index = GetAltitudeColorIndex(it->GetAltitude(),
                                                value_min, value_max);
-        canvas.Select(look.trail_pens[index]);
-        canvas.DrawLinePiece(last_point, pt);
+        last_pen = &look.trail_pens[index];
+        DrawTrailLine(canvas, last_point, pt, *last_pen);
       } else {
         unsigned color_index = GetSnailColorIndex(it->GetVario(),
                                                   value_min, value_max);
+        const RasterPoint middle((pt.x + last_point.x) / 2,
+                                 (pt.y + last_point.y) / 2);
+
         if (negative(it->GetVario()) &&
             (settings.type == TrailSettings::Type::VARIO_1_DOTS ||
              settings.type == TrailSettings::Type::VARIO_2_DOTS ||
              settings.type == TrailSettings::Type::VARIO_DOTS_AND_LINES)) {
-          canvas.SelectNullPen();
-          canvas.Select(look.trail_brushes[color_index]);
-          canvas.DrawCircle((pt.x + last_point.x) / 2, (pt.y + last_point.y) / 2,
-                            look.trail_widths[color_index]);
+          last_pen = nullptr;
+          DrawTrailDot(canvas, middle, look.trail_widths[color_index],
+                       look.trail_brushes[color_index], nullptr);
         } else {
           // positive vario case
 
           if (settings.type == TrailSettings::Type::VARIO_DOTS_AND_LINES) {
-            canvas.Select(look.trail_brushes[color_index]);
-            canvas.Select(look.trail_pens[color_index]); //fixed-width pen
-            canvas.DrawCircle((pt.x + last_point.x) / 2, (pt.y + last_point.y) / 2,
-                              look.trail_widths[color_index]);
+            last_pen = &look.trail_pens[color_index]; //fixed-width pen
+            DrawTrailDot(canvas, middle, look.trail_widths[color_index],
+                         look.trail_brushes[color_index], last_pen);
           } else if (scaled_trail)
             // width scaled to vario
-            canvas.Select(look.scaled_trail_pens[color_index]);
+            last_pen = &look.scaled_trail_pens[color_index];
           else
             // fixed-width pen
-            canvas.Select(look.trail_pens[color_index]);
+            last_pen = &look.trail_pens[color_index];
 
-          canvas.DrawLinePiece(last_point, pt);
+          DrawTrailLine(canvas, last_point, pt, *last_pen);
         }
       }
     }
@@ -200,8 +245,18 @@ TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
     last_valid = true;
   }
 
-  if (last_valid)
+#ifdef ENABLE_OPENGL
+#ifdef USE_GLSL
+  OpenGL::solid_shader->Use();
+#endif
+
+  line_batch.Flush();
+#endif
+
+  if (last_valid && last_pen != nullptr) {
+    canvas.Select(*last_pen);
     canvas.DrawLine(last_point, pos);
+  }
 }
 
 void
@@ -27,9 +27,16 @@ Copyright_License {
 #include "Util/AllocatedArray.hpp"
 #include "Engine/Trace/Point.hpp"
 #include "Engine/Trace/Vector.hpp"
+#include "Screen/Features.hpp"
+
+#ifdef ENABLE_OPENGL
+#include "Screen/OpenGL/LineBatch.hpp"
+#endif
 
 struct RasterPoint;
 class Canvas;
+class Pen;
+class Brush;
 class TraceComputer;
 class Projection;
 class WindowProjection;
@@ -46,6 +53,14 @@ class TrailRenderer {
   TracePointVector trace;
   AllocatedArray<RasterPoint> points;
 
+#ifdef ENABLE_OPENGL
+  /**
+   * Collects the segments of the snail trail, to submit them with a
+   * few draw calls.
+   */
+  GLLineBatch line_batch;
+#endif
+
 public:
   TrailRenderer(const TrailLook &_look):look(_look) {}
 
@@ -99,6 +114,16 @@ public:
 private:
   void DrawTraceVector(Canvas &canvas, const Projection &projection,
                        const TracePointVector &trace);
+
+  void DrawTrailLine(Canvas &canvas, RasterPoint a, RasterPoint b,
+                     const Pen &pen);
+
+  /**
+   * Draw a filled vario dot, optionally outlined with the given
+   * #Pen.
+   */
+  void DrawTrailDot(Canvas &canvas, RasterPoint center, unsigned radius,
+                    const Brush &brush, const Pen *pen);
 };
 
 #endif
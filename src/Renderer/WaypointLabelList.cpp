@@ -80,6 +80,11 @@ MapWaypointLabelListCompare(const WaypointLabelList::Label &e1,
   if (!e1.inTask && e2.inTask)
     return false;
 
+  const unsigned reach1 = e1.isLandable ? e1.reachability : 0;
+  const unsigned reach2 = e2.isLandable ? e2.reachability : 0;
+  if (reach1 != reach2)
+    return reach1 > reach2;
+
   if (e1.isAirport && !e2.isAirport)
     return true;
 
@@ -144,7 +149,8 @@ WaypointLabelList::Add(unsigned wp_id,
                        unsigned _anchor_radius,
                        TextInBoxMode Mode, bool bold,
                        RoughAltitude AltArivalAGL, bool inTask,
-                       bool isLandable, bool isAirport, bool isWatchedWaypoint)
+                       bool isLandable, bool isAirport, bool isWatchedWaypoint,
+                       unsigned reachability)
 {
   if ((X < - WPCIRCLESIZE)
       || X > PixelScalar(width + (WPCIRCLESIZE * 3))
@@ -176,6 +182,8 @@ WaypointLabelList::Add(unsigned wp_id,
   l.isLandable = isLandable;
   l.isAirport  = isAirport;
   l.isWatchedWaypoint = isWatchedWaypoint;
+  l.reachability = reachability;
+  l.placed = false;
   l.wp_id = wp_id;
 }
 
@@ -277,7 +285,13 @@ WaypointLabelList::MergeLists(WaypointLabelList &labels_new, bool pre_calc)
     // leave perimeter_size - it will be recalculated
     // if pre_cal, update anchor, else update label.Pos for drag/pan
     if (lab.wp_id == lab_new.wp_id) {
-      //TEMP DEBUG CODE:
+      if (lab.bold != lab_new.bold ||
+          lab.Mode.shape != lab_new.Mode.shape ||
+          !StringIsEqual(lab.Name, lab_new.Name))
+        /* the box has a different size now, it needs to be tested
+           against the LabelBlock again */
+        lab.placed = false;
+
       CopyString(lab.Name, lab_new.Name, NAME_SIZE);
       lab.Mode = lab_new.Mode;
       lab.AltArivalAGL = lab_new.AltArivalAGL;
@@ -286,6 +300,7 @@ WaypointLabelList::MergeLists(WaypointLabelList &labels_new, bool pre_calc)
       lab.isAirport = lab_new.isAirport;
       lab.isLandable = lab_new.isLandable;
       lab.isWatchedWaypoint = lab_new.isWatchedWaypoint;
+      lab.reachability = lab_new.reachability;
       lab.hidden = false;
 
       if (pre_calc) {
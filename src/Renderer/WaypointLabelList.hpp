@@ -87,9 +87,16 @@ public:
     bool isLandable;
     bool isAirport;
     bool isWatchedWaypoint;
+    /* WaypointRenderer::Reachability of the waypoint, higher is better */
+    unsigned reachability;
     bool bold;
     bool hidden;
+    /* was the label drawn in the last frame, and at which position;
+       see PlaceLabels() */
+    bool placed;
+    RasterPoint placed_pos;
     bool Visible() const;
+
     /**
      * return. true if a line should be drawn from the anchor to the label
      * @param p.  sets to the endpoint of the line to be drawn
@@ -126,7 +133,7 @@ public:
            TextInBoxMode Mode, bool bold,
            RoughAltitude AltArivalAGL,
            bool inTask, bool isLandable, bool isAirport,
-           bool isWatchedWaypoint);
+           bool isWatchedWaypoint, unsigned reachability);
 
   /**
    * sets the perimeter_size parameters and max_label_width
@@ -136,7 +143,8 @@ public:
   void SetSize(Canvas &canvas, const Font &font, const Font &font_bold);
 
   /**
-   * Sort by attributes
+   * Sort by attributes.  In-task waypoints come first, followed by
+   * landables ordered by their reachability class.
    */
   void Sort();
   /**
@@ -25,6 +25,7 @@ Copyright_License {
 #include "WaypointRendererSettings.hpp"
 #include "WaypointIconRenderer.hpp"
 #include "WaypointLabelList.hpp"
+#include "LabelPlacement.hpp"
 #include "Projection/MapWindowProjection.hpp"
 #include "Computer/Settings.hpp"
 #include "Task/Visitors/TaskPointVisitor.hpp"
@@ -40,13 +41,13 @@ Copyright_License {
 #include "Engine/Task/Ordered/Points/OrderedTaskPoint.hpp"
 #include "Engine/Task/Ordered/OrderedTask.hpp"
 #include "Task/ProtectedTaskManager.hpp"
-#include "Task/ProtectedRoutePlanner.hpp"
 #include "Screen/Canvas.hpp"
 #include "Units/Units.hpp"
 #include "Util/StaticArray.hpp"
 #include "NMEA/MoreData.hpp"
 #include "NMEA/Derived.hpp"
 #include "Engine/Route/ReachResult.hpp"
+#include "NMEA/WaypointReachInfo.hpp"
 #include "Look/TaskLook.hpp"
 #include "Look/MapLook.hpp"
 #include "UIGlobals.hpp"
@@ -64,6 +65,14 @@ Copyright_License {
 #include <assert.h>
 #include <stdio.h>
 
+static_assert(unsigned(WaypointReachInfo::Reachability::UNREACHABLE) ==
+              WaypointRenderer::Unreachable &&
+              unsigned(WaypointReachInfo::Reachability::STRAIGHT) ==
+              WaypointRenderer::ReachableStraight &&
+              unsigned(WaypointReachInfo::Reachability::TERRAIN) ==
+              WaypointRenderer::ReachableTerrain,
+              "Reachability mismatch");
+
 /**
  * Metadata for a Waypoint that is about to be drawn.
  */
@@ -87,6 +96,19 @@ struct VisibleWaypoint {
     in_task = _in_task;
   }
 
+  /**
+   * @return false if the waypoint is not in the table
+   */
+  bool SetReachability(const WaypointReachInfo &info) {
+    const WaypointReachInfo::Item *item = info.Find(waypoint->id);
+    if (item == nullptr)
+      return false;
+
+    reach = item->reach;
+    reachable = WaypointRenderer::Reachability(item->reachable);
+    return true;
+  }
+
   void CalculateReachabilityDirect(const MoreData &basic,
                                    const SpeedVector &wind,
                                    const MacCready &mac_cready,
@@ -108,29 +130,6 @@ struct VisibleWaypoint {
       reachable = WaypointRenderer::ReachableTerrain;
   }
 
-  void CalculateRouteArrival(const RoutePlannerGlue &route_planner,
-                             const TaskBehaviour &task_behaviour) {
-    const RoughAltitude elevation(waypoint->elevation +
-                                  task_behaviour.safety_height_arrival);
-    const AGeoPoint p_dest (waypoint->location, elevation);
-    if (route_planner.FindPositiveArrival(p_dest, reach))
-      reach.Subtract(elevation);
-  }
-
-  void CalculateReachability(const RoutePlannerGlue &route_planner,
-                             const TaskBehaviour &task_behaviour)
-  {
-    CalculateRouteArrival(route_planner, task_behaviour);
-
-    if (!reach.IsReachableDirect())
-      reachable = WaypointRenderer::Unreachable;
-    else if (task_behaviour.route_planner.IsReachEnabled() &&
-             !reach.IsReachableTerrain())
-      reachable = WaypointRenderer::ReachableStraight;
-    else
-      reachable = WaypointRenderer::ReachableTerrain;
-  }
-
   void DrawSymbol(const struct WaypointRendererSettings &settings,
                   const WaypointLook &look,
                   Canvas &canvas, bool small_icons, Angle screen_rotation) const {
@@ -391,7 +390,7 @@ protected:
         sc.x + radius + Layout::Scale(2), sc.y + radius - half_label_height, sc,
         Layout::Scale(4) + enlarged_icon, text_mode, bold,
         vwp.reach.direct, vwp.in_task, way_point.IsLandable(),
-        way_point.IsAirport(), watchedWaypoint);
+        way_point.IsAirport(), watchedWaypoint, vwp.reachable);
   }
 
   void AddWaypoint(const Waypoint &way_point, bool in_task) {
@@ -434,22 +433,20 @@ public:
     task_valid = true;
   }
 
-  void CalculateRoute(const ProtectedRoutePlanner &route_planner) {
-    const ProtectedRoutePlanner::Lease lease(route_planner);
-
-    for (VisibleWaypoint &vwp : waypoints) {
-      const Waypoint &way_point = *vwp.waypoint;
-
-      if (way_point.IsLandable() || way_point.flags.watched)
-        vwp.CalculateReachability(lease, task_behaviour);
-    }
-  }
-
-  void CalculateDirect(const PolarSettings &polar_settings,
-                       const TaskBehaviour &task_behaviour,
-                       const DerivedInfo &calculated) {
-    if (!basic.location_available || !basic.NavAltitudeAvailable())
-      return;
+  /**
+   * Look up the arrival heights calculated by #WaypointReachComputer.
+   * Waypoints which are not in its table (too far away, or too many
+   * waypoints nearby) get a straight glide, so every visible
+   * landable shows an arrival height.
+   *
+   * @param reach the table of the #WaypointReachComputer; nullptr
+   * if there is none
+   */
+  void Calculate(const PolarSettings &polar_settings,
+                 const DerivedInfo &calculated,
+                 const WaypointReachInfo *reach) {
+    const bool can_glide = basic.location_available &&
+      basic.NavAltitudeAvailable();
 
     const GlidePolar &glide_polar =
       task_behaviour.route_planner.reach_polar_mode == RoutePlannerConfig::Polar::TASK
@@ -460,22 +457,13 @@ public:
     for (VisibleWaypoint &vwp : waypoints) {
       const Waypoint &way_point = *vwp.waypoint;
 
-      if (way_point.IsLandable() || way_point.flags.watched)
+      if ((way_point.IsLandable() || way_point.flags.watched) &&
+          (reach == nullptr || !vwp.SetReachability(*reach)) && can_glide)
         vwp.CalculateReachabilityDirect(basic, calculated.GetWindOrZero(),
                                         mac_cready, task_behaviour);
     }
   }
 
-  void Calculate(const ProtectedRoutePlanner *route_planner,
-                 const PolarSettings &polar_settings,
-                 const TaskBehaviour &task_behaviour,
-                 const DerivedInfo &calculated) {
-    if (route_planner != nullptr && !route_planner->IsReachEmpty())
-      CalculateRoute(*route_planner);
-    else
-      CalculateDirect(polar_settings, task_behaviour, calculated);
-  }
-
   void Draw(Canvas &canvas) {
     for (const VisibleWaypoint &vwp : waypoints)
       DrawWaypoint(canvas, vwp);
@@ -504,25 +492,43 @@ UpdateLabelTextWithEnergy(WaypointLabelList::Label &l)
 }
 #endif
 
-static void
+static bool
 DrawLabel(Canvas &canvas, const WaypointLabelList::Label &l,
           UPixelScalar width, UPixelScalar height, const WaypointLook &look,
-          LabelBlock &label_block)
+          LabelBlock &label_block, bool skip_check)
 {
   canvas.Select(l.bold ? *look.bold_font : *look.font);
-  if (TextInBox(canvas, l.Name, l.Pos.x, l.Pos.y, l.Mode,
-            width, height, &label_block/*, true*/)) {
+  if (!TextInBox(canvas, l.Name, l.Pos.x, l.Pos.y, l.Mode,
+                 width, height, &label_block, skip_check))
+    return false;
+
 //#define DRAW_LINE
 #ifdef DRAW_LINE
-    RasterPoint corner;
-    if (l.GetCornerForLine(corner)) {
-      //corner += (l.anchor - l.Pos_arranged);
-      canvas.SelectBlackPen();
-      canvas.DrawLine(l.Pos + l.anchor - l.Pos_arranged, corner);
-    }
-#endif
+  RasterPoint corner;
+  if (l.GetCornerForLine(corner)) {
+    //corner += (l.anchor - l.Pos_arranged);
+    canvas.SelectBlackPen();
+    canvas.DrawLine(l.Pos + l.anchor - l.Pos_arranged, corner);
   }
+#endif
+  return true;
+}
+
+/**
+ * Draws the visible labels, see PlaceLabels().
+ */
+static void
+DrawLabels(Canvas &canvas, WaypointLabelList &labels,
+           UPixelScalar width, UPixelScalar height, const WaypointLook &look,
+           LabelBlock &label_block)
+{
+  PlaceLabels(labels.GetLabels(),
+              [&](const WaypointLabelList::Label &l, bool skip_check){
+                return DrawLabel(canvas, l, width, height, look,
+                                 label_block, skip_check);
+              });
 }
+
 /**
  * Merges labels_new into labels last, and redisplays combined list without recalculating.
  * The new labels use their default positions by the anchors
@@ -544,19 +550,11 @@ MapWaypointLabelRenderMerge(Canvas &canvas, UPixelScalar width, UPixelScalar hei
   labels_last.Sort();
 
 #ifdef PRINT_AVERAGE_ENERGY
-  for (unsigned i = 0; i < labels_last.GetLabels().size(); ++i) {
-    WaypointLabelList::Label &l = labels_last.GetLabels()[i]; // non-const ref
-#else
-    for (const auto &l : labels_last) {
+  for (auto &l : labels_last.GetLabels())
+    UpdateLabelTextWithEnergy(l); // so they're displayed on map
 #endif
 
-#ifdef PRINT_AVERAGE_ENERGY
-      UpdateLabelTextWithEnergy(l); // so they're displayed on map
-#endif
-    if (l.Visible()) {
-      DrawLabel(canvas, l, width, height, look, label_block);
-    }
-  }
+  DrawLabels(canvas, labels_last, width, height, look, label_block);
 }
 
 /**
@@ -587,17 +585,17 @@ MapWaypointLabelRenderCalculate(Canvas &canvas, UPixelScalar width, UPixelScalar
   label_arranger.Start();
   labels_last.Sort();
 
-  for (unsigned i = 0; i < labels_last.GetLabels().size(); ++i) {
-    WaypointLabelList::Label &l = labels_last.GetLabels()[i]; // non-const ref
-
-    if (l.Visible()) {
 #ifdef PRINT_AVERAGE_ENERGY // defined above MapWaypointLabelRenderMerge
+  for (auto &l : labels_last.GetLabels()) {
+    if (l.Visible()) {
       energy_total += UpdateLabelTextWithEnergy(l);
       ++energy_count;
-#endif
-      DrawLabel(canvas, l, width, height, look, label_block);
     }
   }
+#endif
+
+  DrawLabels(canvas, labels_last, width, height, look, label_block);
+
 #ifdef PRINT_AVERAGE_ENERGY
   LogFormat(_T("Calc count:%u Average Energy:%i"), energy_count, energy_total / energy_count);
 #endif
@@ -616,7 +614,7 @@ WaypointRenderer::render(Canvas &canvas, LabelBlock &label_block,
                          const TaskBehaviour &task_behaviour,
                          const MoreData &basic, const DerivedInfo &calculated,
                          const ProtectedTaskManager *task,
-                         const ProtectedRoutePlanner *route_planner,
+                         const ProtectedWaypointReach *reach,
                          bool mouse_down)
 {
   if (way_points == nullptr || way_points->IsEmpty())
@@ -644,7 +642,11 @@ WaypointRenderer::render(Canvas &canvas, LabelBlock &label_block,
   way_points->VisitWithinRange(projection.GetGeoScreenCenter(),
                                  projection.GetScreenDistanceMeters(), v);
 
-  v.Calculate(route_planner, polar_settings, task_behaviour, calculated);
+  if (reach != nullptr) {
+    ProtectedWaypointReach::Lease lease(*reach);
+    v.Calculate(polar_settings, calculated, &(const WaypointReachInfo &)lease);
+  } else
+    v.Calculate(polar_settings, calculated, nullptr);
 
   v.Draw(canvas);
 
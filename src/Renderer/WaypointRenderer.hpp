@@ -40,7 +40,7 @@ struct TaskBehaviour;
 struct MoreData;
 struct DerivedInfo;
 class ProtectedTaskManager;
-class ProtectedRoutePlanner;
+class ProtectedWaypointReach;
 
 /**
  * Renders way point icons and labels into a #Canvas.
@@ -81,7 +81,7 @@ public:
               const TaskBehaviour &task_behaviour,
               const MoreData &basic, const DerivedInfo &calculated,
               const ProtectedTaskManager *task,
-              const ProtectedRoutePlanner *route_planner,
+              const ProtectedWaypointReach *reach,
               bool mouse_down);
 
   const WaypointLook &GetLook() const {
@@ -67,6 +67,10 @@ struct _XDisplay;
 #include "../Memory/Dither.hpp"
 #endif
 
+#if defined(KOBO) && defined(USE_FB)
+#include "Screen/FB/FrameDamage.hpp"
+#endif
+
 #include <stdint.h>
 
 #ifdef ENABLE_SDL
@@ -181,6 +185,19 @@ class TopCanvas
   uint32_t epd_update_marker;
 #endif
 
+#if defined(KOBO) && defined(USE_FB)
+  /**
+   * The dithered frame, before it is copied to the frame buffer.
+   */
+  AllocatedArray<uint8_t> dithered;
+
+  /**
+   * Finds the regions which need to be sent to the e-paper
+   * controller.
+   */
+  FrameDamage damage;
+#endif
+
 #ifdef KOBO
   /**
    * Runtime flag that can be used to disable dithering at runtime for
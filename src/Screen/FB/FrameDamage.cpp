@@ -0,0 +1,151 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FrameDamage.hpp"
+
+#include <algorithm>
+
+#include <assert.h>
+#include <string.h>
+
+static PixelRect
+UnionRect(const PixelRect &a, const PixelRect &b)
+{
+  return PixelRect(std::min(a.left, b.left), std::min(a.top, b.top),
+                   std::max(a.right, b.right), std::max(a.bottom, b.bottom));
+}
+
+void
+FrameDamage::Resize(unsigned _width, unsigned _height)
+{
+  width = _width;
+  height = _height;
+  shadow.GrowDiscard(width * height);
+  valid = false;
+}
+
+void
+FrameDamage::CopyRect(const uint8_t *src, unsigned src_pitch,
+                      uint8_t *dest, unsigned dest_pitch,
+                      const PixelRect &rc)
+{
+  const unsigned n = rc.right - rc.left;
+
+  for (int y = rc.top; y < rc.bottom; ++y) {
+    const uint8_t *s = src + y * src_pitch + rc.left;
+    std::copy_n(s, n, dest + y * dest_pitch + rc.left);
+    std::copy_n(s, n, shadow.begin() + y * width + rc.left);
+  }
+}
+
+unsigned
+FrameDamage::Update(const uint8_t *src, unsigned src_pitch,
+                    uint8_t *dest, unsigned dest_pitch,
+                    PixelRect *rects)
+{
+  assert(width > 0 && height > 0);
+
+  if (!valid) {
+    rects[0] = PixelRect(0, 0, width, height);
+    CopyRect(src, src_pitch, dest, dest_pitch, rects[0]);
+    valid = true;
+    return 1;
+  }
+
+  unsigned n = 0;
+
+  /* the region being collected; "open" is false if there is none */
+  bool open = false;
+  PixelRect current;
+
+  const uint8_t *old_row = shadow.begin();
+  for (unsigned y = 0; y < height;
+       ++y, src += src_pitch, old_row += width) {
+    if (memcmp(src, old_row, width) == 0) {
+      if (open && y - current.bottom >= MERGE_GAP) {
+        /* the gap is large enough: finish this region */
+        if (n < MAX_RECTS)
+          rects[n++] = current;
+        else
+          rects[n - 1] = UnionRect(rects[n - 1], current);
+        open = false;
+      }
+
+      continue;
+    }
+
+    unsigned left = 0;
+    while (src[left] == old_row[left])
+      ++left;
+
+    unsigned right = width;
+    while (src[right - 1] == old_row[right - 1])
+      --right;
+
+    left -= left % ALIGN;
+    right = std::min(right + (ALIGN - right % ALIGN) % ALIGN, width);
+
+    if (open) {
+      current.left = std::min(current.left, int(left));
+      current.right = std::max(current.right, int(right));
+      current.bottom = y + 1;
+    } else {
+      current = PixelRect(left, y, right, y + 1);
+      open = true;
+    }
+  }
+
+  if (open) {
+    if (n < MAX_RECTS)
+      rects[n++] = current;
+    else
+      rects[n - 1] = UnionRect(rects[n - 1], current);
+  }
+
+  src -= height * src_pitch;
+  for (unsigned i = 0; i < n; ++i)
+    CopyRect(src, src_pitch, dest, dest_pitch, rects[i]);
+
+  return n;
+}
+
+bool
+FrameDamage::CheckFullRefresh(const PixelRect *rects, unsigned n)
+{
+  if (n == 0)
+    return false;
+
+  unsigned area = 0;
+  for (unsigned i = 0; i < n; ++i) {
+    const PixelSize size = rects[i].GetSize();
+    area += size.cx * size.cy;
+  }
+
+  if (area * 2 >= width * height ||
+      ++partial_updates >= FULL_REFRESH_INTERVAL) {
+    partial_updates = 0;
+    return true;
+  }
+
+  return false;
+}
@@ -0,0 +1,117 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SCREEN_FB_FRAME_DAMAGE_HPP
+#define XCSOAR_SCREEN_FB_FRAME_DAMAGE_HPP
+
+#include "Screen/Point.hpp"
+#include "Util/AllocatedArray.hpp"
+
+#include <stdint.h>
+
+/**
+ * Remembers what has been copied to an 8 bit frame buffer, and
+ * copies only the regions of a new frame which differ.  This is
+ * used on e-paper displays, where each update of a region is
+ * expensive and causes visible flicker.
+ */
+class FrameDamage {
+public:
+  /**
+   * The maximum number of regions reported by Update().  Damage
+   * beyond that is merged into the last region.
+   */
+  static constexpr unsigned MAX_RECTS = 8;
+
+  /**
+   * The horizontal alignment of all regions [pixels].
+   */
+  static constexpr unsigned ALIGN = 8;
+
+  /**
+   * Damaged rows which are separated by no more than this number of
+   * unchanged rows are combined into one region.
+   */
+  static constexpr unsigned MERGE_GAP = 16;
+
+  /**
+   * Request a full refresh after this number of partial updates, to
+   * clear the ghosting they leave behind.
+   */
+  static constexpr unsigned FULL_REFRESH_INTERVAL = 32;
+
+private:
+  unsigned width, height;
+
+  /**
+   * A copy of the frame buffer contents.
+   */
+  AllocatedArray<uint8_t> shadow;
+
+  /**
+   * If false, then #shadow is undefined, and the next Update() call
+   * copies the whole frame.
+   */
+  bool valid;
+
+  unsigned partial_updates;
+
+public:
+  FrameDamage():width(0), height(0), valid(false), partial_updates(0) {}
+
+  void Resize(unsigned _width, unsigned _height);
+
+  /**
+   * Forget the frame buffer contents, e.g. because somebody else
+   * has drawn into it.
+   */
+  void Invalidate() {
+    valid = false;
+  }
+
+  /**
+   * Copy the changed regions of a new frame to the frame buffer.
+   *
+   * @param rects an array of #MAX_RECTS elements which receives the
+   * damaged regions
+   * @return the number of damaged regions
+   */
+  unsigned Update(const uint8_t *src, unsigned src_pitch,
+                  uint8_t *dest, unsigned dest_pitch,
+                  PixelRect *rects);
+
+  /**
+   * Decide whether the damaged regions shall be sent as one full
+   * refresh instead of partial updates.  This is the case when they
+   * cover a large part of the screen, or when too many partial
+   * updates have accumulated.
+   */
+  bool CheckFullRefresh(const PixelRect *rects, unsigned n);
+
+private:
+  void CopyRect(const uint8_t *src, unsigned src_pitch,
+                uint8_t *dest, unsigned dest_pitch,
+                const PixelRect &rc);
+};
+
+#endif
@@ -195,6 +195,10 @@ TopCanvas::Create(PixelSize new_size,
   map_pitch = finfo.line_length;
   epd_update_marker = 0;
 
+#ifdef KOBO
+  damage.Resize(::GetWidth(vinfo), ::GetHeight(vinfo));
+#endif
+
 #ifdef KOBO
   ioctl(fd, MXCFB_SET_UPDATE_SCHEME, UPDATE_SCHEME_QUEUE_AND_MERGE);
 #endif
@@ -231,6 +235,11 @@ TopCanvas::CheckResize()
 
   buffer.Free();
   buffer.Allocate(new_width, new_height);
+
+#ifdef KOBO
+  damage.Resize(new_width, new_height);
+#endif
+
   return true;
 }
 
@@ -297,27 +306,12 @@ CopyGreyscaleToRGB565(RGB565Color *gcc_restrict dest,
 
 #endif
 
-#ifdef KOBO
-
-static void
-CopyGreyscale(uint8_t *dest_pixels, unsigned dest_pitch,
-              const uint8_t *src_pixels, unsigned src_pitch,
-              unsigned width, unsigned height)
-{
-  for (unsigned y = 0; y < height;
-       ++y, dest_pixels += dest_pitch, src_pixels += src_pitch)
-    std::copy_n(src_pixels, width, dest_pixels);
-}
-
-#endif
+#ifndef KOBO
 
 static void
 CopyFromGreyscale(
 #ifdef DITHER
                   Dither &dither,
-#endif
-#ifdef KOBO
-                  bool enable_dither,
 #endif
                   void *dest_pixels, unsigned dest_pitch, unsigned dest_bpp,
                   ConstImageBuffer<GreyscalePixelTraits> src)
@@ -326,15 +320,6 @@ CopyFromGreyscale(
 
   const unsigned width = src.width, height = src.height;
 
-#ifdef KOBO
-  if (!enable_dither) {
-    CopyGreyscale((uint8_t *)dest_pixels, dest_pitch,
-                  src_pixels, src.pitch,
-                  width, height);
-    return;
-  }
-#endif
-
 #ifdef DITHER
 
   dither.DitherGreyscale(src_pixels, src.pitch,
@@ -342,7 +327,6 @@ CopyFromGreyscale(
                          dest_pitch,
                          width, height);
 
-#ifndef KOBO
   if (dest_bpp == 4) {
     const unsigned n_pixels = (dest_pitch / dest_bpp)
       * height;
@@ -353,7 +337,6 @@ CopyFromGreyscale(
     while (s != end)
       *--d = *--s;
   }
-#endif
 
 #else
 
@@ -374,6 +357,8 @@ CopyFromGreyscale(
 #endif
 }
 
+#endif /* !KOBO */
+
 #else
 
 static RGB565Color
@@ -423,11 +408,66 @@ CopyFromBGRA(void *_dest_pixels, unsigned _dest_pitch, unsigned dest_bpp,
 
 #endif /* USE_FB */
 
+#ifdef KOBO
+
+static void
+SendEPDUpdate(int fd, uint32_t marker, const PixelRect &rc,
+              uint32_t update_mode, bool monochrome)
+{
+  struct mxcfb_update_data epd_update_data = {
+    {
+      uint32_t(rc.top), uint32_t(rc.left),
+      uint32_t(rc.right - rc.left), uint32_t(rc.bottom - rc.top)
+    },
+
+    WAVEFORM_MODE_AUTO,
+    update_mode,
+    marker,
+    TEMP_USE_AMBIENT,
+    monochrome ? EPDC_FLAG_FORCE_MONOCHROME : 0,
+  };
+
+  ioctl(fd, MXCFB_SEND_UPDATE, &epd_update_data);
+}
+
+#endif
+
 void
 TopCanvas::Flip()
 {
 #ifdef USE_FB
 
+#ifdef KOBO
+  /* convert the frame into a private buffer first; only the regions
+     which differ from what is already on the screen are copied to
+     the frame buffer and sent to the e-paper controller */
+  const uint8_t *src = reinterpret_cast<const uint8_t *>(buffer.data);
+  unsigned src_pitch = buffer.pitch;
+
+  if (enable_dither) {
+    dithered.GrowDiscard(buffer.width * buffer.height);
+    dither.DitherGreyscale(src, src_pitch, dithered.begin(), buffer.width,
+                           buffer.width, buffer.height);
+    src = dithered.begin();
+    src_pitch = buffer.width;
+  }
+
+  PixelRect rects[FrameDamage::MAX_RECTS];
+  const unsigned n = damage.Update(src, src_pitch,
+                                   (uint8_t *)map, map_pitch, rects);
+  if (n == 0)
+    return;
+
+  if (damage.CheckFullRefresh(rects, n)) {
+    SendEPDUpdate(fd, ++epd_update_marker, GetRect(),
+                  UPDATE_MODE_FULL, enable_dither);
+  } else {
+    for (unsigned i = 0; i < n; ++i)
+      SendEPDUpdate(fd, ++epd_update_marker, rects[i],
+                    UPDATE_MODE_PARTIAL, enable_dither);
+  }
+#else
+
 #ifdef GREYSCALE
   CopyFromGreyscale(
 #ifdef DITHER
@@ -442,24 +482,7 @@ TopCanvas::Flip()
   CopyFromBGRA(map, map_pitch, map_bpp, buffer);
 #endif
 
-
-#ifdef KOBO
-  epd_update_marker++;
-
-  struct mxcfb_update_data epd_update_data = {
-    {
-      0, 0, buffer.width, buffer.height
-    },
-
-    WAVEFORM_MODE_AUTO,
-    UPDATE_MODE_FULL, // PARTIAL
-    epd_update_marker,
-    TEMP_USE_AMBIENT,
-    enable_dither ? EPDC_FLAG_FORCE_MONOCHROME : 0,
-  };
-
-  ioctl(fd, MXCFB_SEND_UPDATE, &epd_update_data);
-#endif
+#endif /* !KOBO */
 
 #endif /* USE_FB */
 }
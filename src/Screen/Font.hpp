@@ -29,6 +29,7 @@ Copyright_License {
 
 #ifdef USE_FREETYPE
 typedef struct FT_FaceRec_ *FT_Face;
+class GlyphCache;
 #endif
 
 #ifdef WIN32
@@ -37,6 +38,8 @@ typedef struct FT_FaceRec_ *FT_Face;
 
 #include <tchar.h>
 
+#include <assert.h>
+
 class FontDescription;
 class TextUtil;
 
@@ -47,6 +50,8 @@ class Font {
 protected:
 #ifdef USE_FREETYPE
   FT_Face face;
+
+  GlyphCache *glyphs;
 #elif defined(ANDROID)
   TextUtil *text_util_object;
 
@@ -63,7 +68,7 @@ protected:
 
 public:
 #ifdef USE_FREETYPE
-  Font():face(nullptr) {}
+  Font():face(nullptr), glyphs(nullptr) {}
 #elif defined(ANDROID)
   Font():text_util_object(nullptr) {}
 #else
@@ -113,6 +118,17 @@ public:
   }
 
   void Render(const TCHAR *text, const PixelSize size, void *buffer) const;
+
+  /**
+   * Returns the glyphs of this font, e.g. for drawing from its
+   * #GlyphAtlas.  With OpenGL, this may only be used in the OpenGL
+   * thread; it is not protected by the FreeType mutex.
+   */
+  GlyphCache &GetGlyphCache() const {
+    assert(IsDefined());
+
+    return *glyphs;
+  }
 #elif defined(ANDROID)
   int TextTextureGL(const TCHAR *text, PixelSize &size,
                     PixelSize &allocated_size) const;
@@ -26,16 +26,13 @@ Copyright_License {
 #include "Screen/Custom/Files.hpp"
 #include "Look/FontDescription.hpp"
 #include "Init.hpp"
+#include "GlyphCache.hpp"
 #include "Asset.hpp"
 
 #ifndef ENABLE_OPENGL
 #include "Thread/Mutex.hpp"
 #endif
 
-#ifndef _UNICODE
-#include "Util/UTF8.hpp"
-#endif
-
 #if defined(__clang__) && defined(__arm__)
 /* work around warning: 'register' storage class specifier is
    deprecated */
@@ -79,27 +76,10 @@ IsMono()
 #endif
 }
 
-static constexpr inline FT_Long
-FT_FLOOR(FT_Long x)
-{
-  return (x & -64) / 64;
-}
-
 static constexpr inline FT_Long
 FT_CEIL(FT_Long x)
 {
-  return FT_FLOOR(x + 63);
-}
-
-gcc_pure
-static std::pair<unsigned, const TCHAR *>
-NextChar(const TCHAR *p)
-{
-#ifdef _UNICODE
-  return std::make_pair(unsigned(*p), p + 1);
-#else
-  return NextUTF8(p);
-#endif
+  return ((x + 63) & -64) / 64;
 }
 
 void
@@ -180,6 +160,7 @@ Font::LoadFile(const char *file, unsigned ptsize, bool bold, bool italic)
   // TODO: handle bold/italic
 
   face = new_face;
+  glyphs = new GlyphCache(face, load_flags, render_mode, height);
   return true;
 }
 
@@ -225,93 +206,33 @@ Font::Destroy()
 
   assert(IsScreenInitialized());
 
+  delete glyphs;
+  glyphs = nullptr;
+
   ::FT_Done_Face(face);
   face = nullptr;
 }
 
 template<typename F>
-static void
-ForEachChar(const TCHAR *text, F &&f)
-{
-  assert(text != nullptr);
-#ifndef _UNICODE
-  assert(ValidateUTF8(text));
-#endif
-
-  while (true) {
-      const auto n = NextChar(text);
-      if (n.first == 0)
-        break;
-
-      text = n.second;
-      f(n.first);
-    }
-}
-
-template<typename T, typename F>
-static void
-ForEachGlyph(const FT_Face face, unsigned ascent_height, T &&text,
+static unsigned
+ForEachGlyph(GlyphCache &glyphs, unsigned ascent_height, const TCHAR *text,
              F &&f)
 {
-  const bool use_kerning = FT_HAS_KERNING(face);
-
-  int x = 0;
-  unsigned prev_index = 0;
-
 #ifndef ENABLE_OPENGL
   const ScopeLock protect(freetype_mutex);
 #endif
 
-  ForEachChar(std::forward<T>(text),
-              [face, ascent_height, &f, use_kerning,
-               &x, &prev_index](unsigned ch){
-      const FT_UInt i = FT_Get_Char_Index(face, ch);
-      if (i == 0)
-        return;
-
-      const FT_Error error = FT_Load_Glyph(face, i, load_flags);
-      if (error)
-        return;
-
-      const FT_GlyphSlot glyph = face->glyph;
-      const FT_Glyph_Metrics &metrics = glyph->metrics;
-
-      if (use_kerning) {
-        if (prev_index != 0 && i != 0) {
-          FT_Vector delta;
-          FT_Get_Kerning(face, prev_index, i, ft_kerning_default,
-                         &delta);
-          x += delta.x >> 6;
-        }
-
-        prev_index = i;
-      }
-
-      f(x + FT_FLOOR(metrics.horiBearingX),
-        ascent_height - FT_FLOOR(metrics.horiBearingY),
-        glyph);
-
-      x += FT_CEIL(metrics.horiAdvance);
-    });
+  return glyphs.ForEach(text, ascent_height, std::forward<F>(f));
 }
 
 PixelSize
 Font::TextSize(const TCHAR *text) const
 {
-  int maxx = 0;
-
-  ForEachGlyph(face, ascent_height, text,
-               [&maxx](int x, int y, const FT_GlyphSlot glyph){
-      const FT_Glyph_Metrics &metrics = glyph->metrics;
-      const int glyph_minx = FT_FLOOR(metrics.horiBearingX);
-      const int glyph_maxx = glyph_minx + FT_CEIL(metrics.width);
+  const unsigned width =
+    ForEachGlyph(*glyphs, ascent_height, text,
+                 [](int x, int y, const FreeTypeGlyph &glyph){});
 
-      int z = x + glyph_maxx;
-      if (z > maxx)
-        maxx = z;
-    });
-
-  return PixelSize{unsigned(maxx), height};
+  return PixelSize{width, height};
 }
 
 static void
@@ -324,11 +245,11 @@ MixLine(uint8_t *dest, const uint8_t *src, size_t n)
 
 static void
 RenderGlyph(uint8_t *buffer, unsigned buffer_width, unsigned buffer_height,
-            const FT_Bitmap &bitmap, int x, int y)
+            const FreeTypeGlyph &glyph, int x, int y)
 {
-  const uint8_t *src = (const uint8_t *)bitmap.buffer;
-  int width = bitmap.width, height = bitmap.rows;
-  int pitch = bitmap.pitch;
+  const uint8_t *src = glyph.data;
+  int width = glyph.width, height = glyph.height;
+  const int pitch = glyph.width;
 
   if (x < 0) {
     src -= x;
@@ -360,59 +281,14 @@ RenderGlyph(uint8_t *buffer, unsigned buffer_width, unsigned buffer_height,
     MixLine(buffer, src, width);
 }
 
-static void
-ConvertMono(unsigned char *dest, const unsigned char *src, unsigned n)
-{
-  for (; n >= 8; n -= 8, ++src) {
-    for (unsigned i = 0x80; i != 0; i >>= 1)
-      *dest++ = (*src & i) ? 0xff : 0x00;
-  }
-
-  for (unsigned i = 0x80; n > 0; i >>= 1, --n)
-    *dest++ = (*src & i) ? 0xff : 0x00;
-}
-
-static void
-ConvertMono(FT_Bitmap &dest, const FT_Bitmap &src)
-{
-  dest = src;
-  dest.pitch = dest.width;
-  dest.buffer = new unsigned char[dest.pitch * dest.rows];
-
-  unsigned char *d = dest.buffer, *s = src.buffer;
-  for (unsigned y = 0; y < unsigned(dest.rows);
-       ++y, d += dest.pitch, s += src.pitch)
-    ConvertMono(d, s, dest.width);
-}
-
-static void
-RenderGlyph(uint8_t *buffer, size_t width, size_t height,
-            FT_GlyphSlot glyph, int x, int y)
-{
-  FT_Error error = FT_Render_Glyph(glyph, render_mode);
-  if (error)
-    return;
-
-  if (IsMono()) {
-    /* with anti-aliasing disabled, FreeType writes each pixel in one
-       bit; hack: convert it to 1 byte per pixel and then render it */
-    FT_Bitmap bitmap;
-    ConvertMono(bitmap, glyph->bitmap);
-    RenderGlyph(buffer, width, height, bitmap, x, y);
-    delete[] bitmap.buffer;
-  } else
-    RenderGlyph(buffer, width, height, glyph->bitmap, x, y);
-}
-
 void
 Font::Render(const TCHAR *text, const PixelSize size, void *_buffer) const
 {
   uint8_t *buffer = (uint8_t *)_buffer;
   std::fill_n(buffer, BufferSize(size), 0);
 
-  ForEachGlyph(face, ascent_height, text,
-               [size, buffer](int x, int y, const FT_GlyphSlot glyph){
-      RenderGlyph(buffer, size.cx, size.cy, glyph,
-                  x, y);
+  ForEachGlyph(*glyphs, ascent_height, text,
+               [size, buffer](int x, int y, const FreeTypeGlyph &glyph){
+      RenderGlyph(buffer, size.cx, size.cy, glyph, x, y);
     });
 }
@@ -0,0 +1,153 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+#include "GlyphCache.hpp"
+
+#if defined(__clang__) && defined(__arm__)
+/* work around warning: 'register' storage class specifier is
+   deprecated */
+#define register
+#endif
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <string.h>
+
+static constexpr inline FT_Long
+FT_FLOOR(FT_Long x)
+{
+  return (x & -64) / 64;
+}
+
+static constexpr inline FT_Long
+FT_CEIL(FT_Long x)
+{
+  return FT_FLOOR(x + 63);
+}
+
+GlyphCache::GlyphCache(FT_Face _face, int32_t _load_flags, int _render_mode,
+                       gcc_unused unsigned font_height)
+  :face(_face), load_flags(_load_flags), render_mode(_render_mode),
+   use_kerning(FT_HAS_KERNING(face))
+#ifdef ENABLE_OPENGL
+  , atlas(font_height)
+#endif
+{
+}
+
+GlyphCache::~GlyphCache()
+{
+  for (auto &i : glyphs)
+    delete[] i.second.data;
+}
+
+static void
+ConvertMono(unsigned char *dest, const unsigned char *src, unsigned n)
+{
+  for (; n >= 8; n -= 8, ++src) {
+    for (unsigned i = 0x80; i != 0; i >>= 1)
+      *dest++ = (*src & i) ? 0xff : 0x00;
+  }
+
+  for (unsigned i = 0x80; n > 0; i >>= 1, --n)
+    *dest++ = (*src & i) ? 0xff : 0x00;
+}
+
+/**
+ * Copy the rendered FreeType bitmap into a new buffer with one byte
+ * per pixel and no padding.
+ */
+static uint8_t *
+CopyBitmap(const FT_Bitmap &bitmap)
+{
+  const unsigned width = bitmap.width, height = bitmap.rows;
+  uint8_t *data = new uint8_t[width * height];
+
+  const unsigned char *src = bitmap.buffer;
+  uint8_t *dest = data;
+  for (unsigned y = 0; y < height; ++y, src += bitmap.pitch, dest += width) {
+    if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+      /* with anti-aliasing disabled, FreeType writes each pixel in
+         one bit */
+      ConvertMono(dest, src, width);
+    else
+      memcpy(dest, src, width);
+  }
+
+  return data;
+}
+
+FreeTypeGlyph &
+GlyphCache::Get(unsigned ch)
+{
+  auto i = glyphs.emplace(ch, FreeTypeGlyph());
+  FreeTypeGlyph &glyph = i.first->second;
+  if (!i.second)
+    return glyph;
+
+  glyph.index = 0;
+  glyph.width = glyph.height = 0;
+  glyph.data = nullptr;
+
+  const FT_UInt index = FT_Get_Char_Index(face, ch);
+  if (index == 0)
+    return glyph;
+
+  FT_Error error = FT_Load_Glyph(face, index, load_flags);
+  if (error)
+    return glyph;
+
+  const FT_GlyphSlot slot = face->glyph;
+  const FT_Glyph_Metrics &metrics = slot->metrics;
+
+  glyph.index = index;
+  glyph.left = FT_FLOOR(metrics.horiBearingX);
+  glyph.top = FT_FLOOR(metrics.horiBearingY);
+  glyph.metrics_width = FT_CEIL(metrics.width);
+  glyph.advance = FT_CEIL(metrics.horiAdvance);
+
+  error = FT_Render_Glyph(slot, FT_Render_Mode(render_mode));
+  if (!error && slot->bitmap.width > 0 && slot->bitmap.rows > 0) {
+    glyph.width = slot->bitmap.width;
+    glyph.height = slot->bitmap.rows;
+    glyph.data = CopyBitmap(slot->bitmap);
+  }
+
+  return glyph;
+}
+
+int
+GlyphCache::GetKerning(unsigned previous, unsigned next)
+{
+  const uint64_t key = (uint64_t(previous) << 32) | next;
+  auto i = kerning.find(key);
+  if (i != kerning.end())
+    return i->second;
+
+  FT_Vector delta;
+  FT_Get_Kerning(face, previous, next, ft_kerning_default, &delta);
+
+  const int value = delta.x >> 6;
+  kerning.emplace(key, value);
+  return value;
+}
@@ -0,0 +1,216 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+#ifndef XCSOAR_SCREEN_FREETYPE_GLYPH_CACHE_HPP
+#define XCSOAR_SCREEN_FREETYPE_GLYPH_CACHE_HPP
+
+#include "GlyphPacker.hpp"
+#include "Compiler.h"
+
+#ifdef ENABLE_OPENGL
+#include "Screen/OpenGL/GlyphAtlas.hpp"
+#endif
+
+#ifndef _UNICODE
+#include "Util/UTF8.hpp"
+#endif
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+#include <assert.h>
+#include <stdint.h>
+#include <tchar.h>
+
+typedef struct FT_FaceRec_ *FT_Face;
+
+/**
+ * A rendered glyph and its metrics.  See #GlyphCache.
+ */
+struct FreeTypeGlyph {
+  /**
+   * The FreeType glyph index; 0 means the font doesn't have this
+   * character.
+   */
+  unsigned index;
+
+  /**
+   * The bitmap position relative to the pen position and the
+   * baseline (FreeType's rounded "horiBearing").
+   */
+  int left, top;
+
+  /**
+   * The rounded glyph width according to the metrics, which is used
+   * to calculate the text size.  It may differ from the #width of
+   * the bitmap.
+   */
+  unsigned metrics_width;
+
+  unsigned advance;
+
+  /**
+   * An alpha bitmap with one byte per pixel and no padding.
+   */
+  unsigned width, height;
+  uint8_t *data;
+
+  /**
+   * The position of this glyph in the atlas texture; only used with
+   * OpenGL.  See AddToAtlas().
+   */
+  GlyphPacker::Slot slot;
+};
+
+/**
+ * Per-font cache of rendered glyphs and kerning values.  With it,
+ * calculating the size of a string and rendering it does not need
+ * to ask FreeType again, and the cost is proportional to the number
+ * of glyphs instead of the number of distinct strings.
+ *
+ * This class is not thread-safe.
+ */
+class GlyphCache {
+  const FT_Face face;
+  const int32_t load_flags;
+  const int render_mode;
+  const bool use_kerning;
+
+  std::unordered_map<unsigned, FreeTypeGlyph> glyphs;
+  std::unordered_map<uint64_t, int> kerning;
+
+#ifdef ENABLE_OPENGL
+  GlyphAtlas atlas;
+#endif
+
+public:
+  GlyphCache(FT_Face face, int32_t load_flags, int render_mode,
+             unsigned font_height);
+  ~GlyphCache();
+
+  GlyphCache(const GlyphCache &) = delete;
+  GlyphCache &operator=(const GlyphCache &) = delete;
+
+  /**
+   * Returns the glyph for the given character, loading and
+   * rendering it on the first call.
+   */
+  FreeTypeGlyph &Get(unsigned ch);
+
+  /**
+   * Returns the horizontal kerning in pixels between two glyph
+   * indices.
+   */
+  int GetKerning(unsigned previous, unsigned next);
+
+#ifdef ENABLE_OPENGL
+  GlyphAtlas &GetAtlas() {
+    return atlas;
+  }
+#endif
+
+  /**
+   * Lay out the string and invoke f(x, y, glyph) for each glyph.  The
+   * coordinates are the top left corner of the glyph's bitmap,
+   * relative to the top left corner of the text.
+   *
+   * @return the width of the text, as reported by Font::TextSize()
+   */
+  template<typename F>
+  unsigned ForEach(const TCHAR *text, unsigned ascent_height, F &&f) {
+    assert(text != nullptr);
+#ifndef _UNICODE
+    assert(ValidateUTF8(text));
+#endif
+
+    int x = 0, max_x = 0;
+    unsigned previous = 0;
+
+    while (true) {
+#ifdef _UNICODE
+      const auto n = std::make_pair(unsigned(*text), text + 1);
+#else
+      const auto n = NextUTF8(text);
+#endif
+      if (n.first == 0)
+        break;
+
+      text = n.second;
+
+      FreeTypeGlyph &glyph = Get(n.first);
+      if (glyph.index == 0)
+        continue;
+
+      if (use_kerning) {
+        if (previous != 0)
+          x += GetKerning(previous, glyph.index);
+
+        previous = glyph.index;
+      }
+
+      const int left = x + glyph.left;
+
+      /* the bearing is counted twice; that is how the text size has
+         always been calculated, and changing it would move text on
+         the screen */
+      max_x = std::max(max_x, left + glyph.left + int(glyph.metrics_width));
+
+      f(left, int(ascent_height) - glyph.top, glyph);
+
+      x += glyph.advance;
+    }
+
+    return max_x;
+  }
+
+  /**
+   * Make sure that all glyphs of the string have a valid #slot in
+   * the atlas (a #GlyphAtlas or anything else with the same IsValid(),
+   * Add() and Clear() methods).  If the atlas runs full, it is
+   * cleared and filled again, once.
+   *
+   * @return false if the glyphs don't fit into the empty atlas
+   */
+  template<typename A>
+  bool AddToAtlas(const TCHAR *text, A &atlas) {
+    for (unsigned attempt = 0; attempt < 2; ++attempt) {
+      bool full = false;
+
+      ForEach(text, 0, [&atlas, &full](int, int, FreeTypeGlyph &glyph){
+          if (!full && glyph.data != nullptr &&
+              !atlas.IsValid(glyph.slot) &&
+              !atlas.Add(glyph.slot, glyph.width, glyph.height, glyph.data))
+            full = true;
+        });
+
+      if (!full)
+        return true;
+
+      atlas.Clear();
+    }
+
+    return false;
+  }
+};
+
+#endif
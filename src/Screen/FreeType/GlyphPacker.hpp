@@ -0,0 +1,111 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SCREEN_FREETYPE_GLYPH_PACKER_HPP
+#define XCSOAR_SCREEN_FREETYPE_GLYPH_PACKER_HPP
+
+#include <algorithm>
+
+/**
+ * Allocates rectangles for glyph bitmaps in a square texture, packed
+ * into rows ("shelves").  When it is full, it is cleared, which
+ * invalidates all #Slot instances handed out before.
+ *
+ * This class does only the bookkeeping; #GlyphAtlas owns the
+ * texture.
+ */
+class GlyphPacker {
+public:
+  struct Slot {
+    unsigned x, y;
+
+    /**
+     * The packer generation this slot was allocated in; 0 means no
+     * slot.
+     */
+    unsigned generation;
+
+    constexpr Slot():x(0), y(0), generation(0) {}
+  };
+
+private:
+  /**
+   * The width and height of the texture.
+   */
+  const unsigned size;
+
+  unsigned shelf_x, shelf_y, shelf_height;
+
+  unsigned generation;
+
+public:
+  explicit constexpr GlyphPacker(unsigned _size)
+    :size(_size), shelf_x(0), shelf_y(0), shelf_height(0),
+     generation(1) {}
+
+  unsigned GetSize() const {
+    return size;
+  }
+
+  bool IsValid(const Slot &slot) const {
+    return slot.generation == generation;
+  }
+
+  /**
+   * Reserve room for a bitmap of the given size, with one pixel of
+   * padding to the right and below.
+   *
+   * @return false if the texture is full
+   */
+  bool Allocate(Slot &slot, unsigned width, unsigned height) {
+    const unsigned padded_width = width + 1, padded_height = height + 1;
+
+    if (shelf_x + padded_width > size) {
+      /* start a new shelf */
+      shelf_x = 0;
+      shelf_y += shelf_height;
+      shelf_height = 0;
+    }
+
+    if (shelf_x + padded_width > size || shelf_y + padded_height > size)
+      return false;
+
+    slot.x = shelf_x;
+    slot.y = shelf_y;
+    slot.generation = generation;
+
+    shelf_x += padded_width;
+    shelf_height = std::max(shelf_height, padded_height);
+    return true;
+  }
+
+  /**
+   * Forget all slots.
+   */
+  void Clear() {
+    shelf_x = shelf_y = shelf_height = 0;
+    ++generation;
+  }
+};
+
+#endif
@@ -30,10 +30,6 @@ Copyright_License {
 #include "Util/StringAPI.hxx"
 #include "Util/StringUtil.hpp"
 
-#ifdef __ARM_NEON__
-#include "NEON.hpp"
-#endif
-
 #ifndef NDEBUG
 #include "Util/UTF8.hpp"
 #endif
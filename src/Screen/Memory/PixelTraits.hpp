@@ -139,12 +139,12 @@ struct GreyscalePixelTraits {
     return p + CalcIncrement(delta);
   }
 
-  static constexpr pointer_type NextByte(pointer_type p, int delta) {
+  static pointer_type NextByte(pointer_type p, int delta) {
     return pointer_type((uint8_t *)p + delta);
   }
 
-  static constexpr const_pointer_type NextByte(const_pointer_type p,
-                                               int delta) {
+  static const_pointer_type NextByte(const_pointer_type p,
+                                     int delta) {
     return const_pointer_type((const uint8_t *)p + delta);
   }
 
@@ -153,13 +153,13 @@ struct GreyscalePixelTraits {
    *
    * @param pitch the number of bytes per row
    */
-  static constexpr pointer_type NextRow(pointer_type p,
-                                        unsigned pitch, int delta) {
+  static pointer_type NextRow(pointer_type p,
+                              unsigned pitch, int delta) {
     return NextByte(p, int(pitch) * delta);
   }
 
-  static constexpr const_pointer_type NextRow(const_pointer_type p,
-                                              unsigned pitch, int delta) {
+  static const_pointer_type NextRow(const_pointer_type p,
+                                    unsigned pitch, int delta) {
     return NextByte(p, int(pitch) * delta);
   }
 
@@ -168,13 +168,13 @@ struct GreyscalePixelTraits {
    *
    * @param pitch the number of bytes per row
    */
-  static constexpr pointer_type At(pointer_type p, unsigned pitch,
-                                   int x, int y) {
+  static pointer_type At(pointer_type p, unsigned pitch,
+                         int x, int y) {
     return Next(NextRow(p, pitch, y), x);
   }
 
-  static constexpr const_pointer_type At(const_pointer_type p, unsigned pitch,
-                                         int x, int y) {
+  static const_pointer_type At(const_pointer_type p, unsigned pitch,
+                               int x, int y) {
     return Next(NextRow(p, pitch, y), x);
   }
 
@@ -337,32 +337,32 @@ struct BGRAPixelTraits {
     return p + CalcIncrement(delta);
   }
 
-  static constexpr pointer_type NextByte(pointer_type p, int delta) {
+  static pointer_type NextByte(pointer_type p, int delta) {
     return pointer_type((uint8_t *)p + delta);
   }
 
-  static constexpr const_pointer_type NextByte(const_pointer_type p,
-                                               int delta) {
+  static const_pointer_type NextByte(const_pointer_type p,
+                                     int delta) {
     return const_pointer_type((const uint8_t *)p + delta);
   }
 
-  static constexpr pointer_type NextRow(pointer_type p,
-                                        unsigned pitch, int delta) {
+  static pointer_type NextRow(pointer_type p,
+                              unsigned pitch, int delta) {
     return NextByte(p, int(pitch) * delta);
   }
 
-  static constexpr const_pointer_type NextRow(const_pointer_type p,
-                                              unsigned pitch, int delta) {
+  static const_pointer_type NextRow(const_pointer_type p,
+                                    unsigned pitch, int delta) {
     return NextByte(p, int(pitch) * delta);
   }
 
-  static constexpr pointer_type At(pointer_type p, unsigned pitch,
-                                   int x, int y) {
+  static pointer_type At(pointer_type p, unsigned pitch,
+                         int x, int y) {
     return Next(NextRow(p, pitch, y), x);
   }
 
-  static constexpr const_pointer_type At(const_pointer_type p, unsigned pitch,
-                                         int x, int y) {
+  static const_pointer_type At(const_pointer_type p, unsigned pitch,
+                               int x, int y) {
     return Next(NextRow(p, pitch, y), x);
   }
 
@@ -383,6 +383,13 @@ struct BGRAPixelTraits {
     const integer_type ci = ToInteger(c);
 
 #if defined(__GNUC__) && defined(__x86_64__)
+    if (n < 64) {
+      /* "rep stosq" has a high startup cost; for short spans, a
+         loop which the compiler can vectorise is faster */
+      std::fill_n(pi, n, ci);
+      return;
+    }
+
     const uint64_t cl = (uint64_t(ci) << 32) | uint64_t(ci);
 
     gcc_unused size_t dummy0, dummy1;
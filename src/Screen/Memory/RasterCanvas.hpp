@@ -30,6 +30,12 @@ Copyright_License {
 #include "Util/AllocatedArray.hpp"
 #include "Compiler.h"
 
+#ifdef __ARM_NEON__
+#include "NEON.hpp"
+#elif defined(__SSE2__)
+#include "SSE2.hpp"
+#endif
+
 #include <assert.h>
 
 /*
@@ -830,24 +836,66 @@ public:
                   GetPixelTraits());
   }
 
+  /**
+   * Scale a row by exactly 2 with a SIMD kernel.  This is only
+   * possible for plain copies, not for other pixel operations.
+   *
+   * @return the number of source pixels which were scaled; the
+   * caller is responsible for the remainder
+   */
+  template<typename PixelOperations, typename D, typename S>
+  static unsigned ScalePixelsTwice(D dest, S src, unsigned src_size,
+                                   PixelOperations operations) {
+    return 0;
+  }
+
+#if defined(__ARM_NEON__) && defined(GREYSCALE)
+  static unsigned ScalePixelsTwice(Luminosity8 *gcc_restrict dest,
+                                   const Luminosity8 *gcc_restrict src,
+                                   unsigned src_size,
+                                   GreyscalePixelTraits operations) {
+    NEONBytesTwice neon;
+    neon.CopyPixels(dest, src, src_size);
+    return src_size & ~0xf;
+  }
+#elif defined(__SSE2__)
+  static unsigned ScalePixelsTwice(Luminosity8 *gcc_restrict dest,
+                                   const Luminosity8 *gcc_restrict src,
+                                   unsigned src_size,
+                                   GreyscalePixelTraits operations) {
+    SSE2PixelsTwice sse2;
+    sse2.CopyPixels(dest, src, src_size);
+    return src_size & ~0xf;
+  }
+
+#ifndef GREYSCALE
+  static unsigned ScalePixelsTwice(BGRA8Color *gcc_restrict dest,
+                                   const BGRA8Color *gcc_restrict src,
+                                   unsigned src_size,
+                                   BGRAPixelTraits operations) {
+    SSE2PixelsTwice sse2;
+    sse2.CopyPixels(dest, src, src_size);
+    return src_size & ~0x3;
+  }
+#endif
+#endif
+
+public:
   template<typename PixelOperations, typename SPT=PixelTraits>
   void ScalePixels(rpointer_type dest, unsigned dest_size,
                    typename SPT::const_rpointer_type src,
                    unsigned src_size,
                    PixelOperations operations) const {
-#if defined(__ARM_NEON__) && defined(GREYSCALE)
     if (dest_size == src_size * 2) {
-      /* NEON-optimised special case */
-      NEONBytesTwice neon;
-      neon.CopyPixels(dest, src, src_size);
+      /* SIMD-optimised special case */
+      const unsigned n = ScalePixelsTwice(dest, src, src_size, operations);
 
       /* use the portable version for the remainder */
-      src += src_size & ~0xf;
-      dest += (src_size & ~0xf) * 2;
-      src_size &= 0xf;
+      src += n;
+      dest += n * 2;
+      src_size -= n;
       dest_size = src_size * 2;
     }
-#endif
 
     unsigned j = 0;
     for (unsigned i = 0; i < dest_size; ++i) {
@@ -0,0 +1,212 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SCREEN_SSE2_HPP
+#define XCSOAR_SCREEN_SSE2_HPP
+
+#include "Screen/PortableColor.hpp"
+
+#ifndef __SSE2__
+#error SSE2 required
+#endif
+
+#include <emmintrin.h>
+
+#if CLANG_OR_GCC_VERSION(4,8)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wcast-align"
+#endif
+
+/**
+ * Implementation of AlphaPixelOperations using Intel SSE2
+ * instructions.  It processes 16 bytes at a time, i.e. 16 greyscale
+ * pixels or 4 BGRA pixels.  The color channels are rounded like
+ * #MMXAlphaPixelOperations; the alpha channel of BGRA pixels is left
+ * unchanged, like #PortableAlphaPixelOperations does.
+ */
+class SSE2AlphaPixelOperations {
+  uint8_t alpha;
+
+public:
+  constexpr SSE2AlphaPixelOperations(uint8_t _alpha):alpha(_alpha) {}
+
+  gcc_hot gcc_always_inline
+  static __m128i FillPixel(__m128i x, __m128i v_alpha, __m128i v_color) {
+    x = _mm_mullo_epi16(x, v_alpha);
+    x = _mm_add_epi16(x, v_color);
+    return _mm_srli_epi16(x, 8);
+  }
+
+  /**
+   * @param n the number of 16 byte blocks
+   * @param inverse_alpha the weight of the destination for each
+   * channel
+   * @param v_color the premultiplied color for each channel
+   */
+  gcc_hot gcc_flatten gcc_nonnull_all
+  static void FillPixels(__m128i *p, unsigned n,
+                         __m128i inverse_alpha, __m128i v_color) {
+    const __m128i zero = _mm_setzero_si128();
+
+    for (unsigned i = 0; i < n; ++i) {
+      __m128i x = _mm_loadu_si128(p + i);
+
+      __m128i lo = FillPixel(_mm_unpacklo_epi8(x, zero),
+                             inverse_alpha, v_color);
+      __m128i hi = FillPixel(_mm_unpackhi_epi8(x, zero),
+                             inverse_alpha, v_color);
+
+      _mm_storeu_si128(p + i, _mm_packus_epi16(lo, hi));
+    }
+  }
+
+  /**
+   * The weights of two BGRA pixels in one vector of 16 bit
+   * integers.  A weight of 0x100 for the destination alpha channel
+   * (and 0 for the source) keeps it unchanged.
+   */
+  static __m128i BGRAWeights(uint16_t color_weight, uint16_t alpha_weight) {
+    return _mm_setr_epi16(color_weight, color_weight, color_weight,
+                          alpha_weight, color_weight, color_weight,
+                          color_weight, alpha_weight);
+  }
+
+  gcc_hot gcc_flatten gcc_nonnull_all
+  void FillPixels(Luminosity8 *p, unsigned n, Luminosity8 c) const {
+    FillPixels((__m128i *)p, n / 16, _mm_set1_epi16(alpha ^ 0xff),
+               _mm_set1_epi16(c.GetLuminosity() * alpha));
+  }
+
+  gcc_hot gcc_flatten gcc_nonnull_all
+  void FillPixels(BGRA8Color *p, unsigned n, BGRA8Color c) const {
+    const __m128i v_color = _mm_setr_epi16(c.Blue(), c.Green(),
+                                           c.Red(), c.Alpha(),
+                                           c.Blue(), c.Green(),
+                                           c.Red(), c.Alpha());
+
+    FillPixels((__m128i *)p, n / 4, BGRAWeights(alpha ^ 0xff, 0x100),
+               _mm_mullo_epi16(v_color, BGRAWeights(alpha, 0)));
+  }
+
+  gcc_hot gcc_always_inline
+  static __m128i AlphaBlend8(__m128i p, __m128i q,
+                             __m128i alpha, __m128i inverse_alpha) {
+    p = _mm_mullo_epi16(p, inverse_alpha);
+    q = _mm_mullo_epi16(q, alpha);
+    return _mm_srli_epi16(_mm_add_epi16(p, q), 8);
+  }
+
+  /**
+   * @param n the number of bytes (multiple of 16)
+   * @param v_alpha the weight of the source for each channel
+   * @param inverse_alpha the weight of the destination for each
+   * channel
+   */
+  gcc_hot gcc_flatten
+  static void CopyPixels(uint8_t *gcc_restrict p,
+                         const uint8_t *gcc_restrict q, unsigned n,
+                         __m128i v_alpha, __m128i inverse_alpha) {
+    const __m128i zero = _mm_setzero_si128();
+
+    __m128i *p2 = (__m128i *)p;
+    const __m128i *q2 = (const __m128i *)q;
+
+    for (unsigned i = 0; i < n / 16; ++i) {
+      __m128i pv = _mm_loadu_si128(p2 + i);
+      __m128i qv = _mm_loadu_si128(q2 + i);
+
+      __m128i lo = AlphaBlend8(_mm_unpacklo_epi8(pv, zero),
+                               _mm_unpacklo_epi8(qv, zero),
+                               v_alpha, inverse_alpha);
+
+      __m128i hi = AlphaBlend8(_mm_unpackhi_epi8(pv, zero),
+                               _mm_unpackhi_epi8(qv, zero),
+                               v_alpha, inverse_alpha);
+
+      _mm_storeu_si128(p2 + i, _mm_packus_epi16(lo, hi));
+    }
+  }
+
+  void CopyPixels(Luminosity8 *p, const Luminosity8 *q, unsigned n) const {
+    CopyPixels((uint8_t *)p, (const uint8_t *)q, n,
+               _mm_set1_epi16(alpha), _mm_set1_epi16(alpha ^ 0xff));
+  }
+
+  void CopyPixels(BGRA8Color *p, const BGRA8Color *q, unsigned n) const {
+    CopyPixels((uint8_t *)p, (const uint8_t *)q, n * 4,
+               BGRAWeights(alpha, 0), BGRAWeights(alpha ^ 0xff, 0x100));
+  }
+};
+
+/**
+ * Read pixels and emit each pixel twice.  This class reads 16 bytes
+ * at a time, and writes 32 bytes at a time.  It is the SSE2 version
+ * of #NEONBytesTwice, and it supports BGRA pixels, too.
+ */
+struct SSE2PixelsTwice {
+  gcc_always_inline
+  static void Copy16(__m128i *gcc_restrict p, const __m128i *gcc_restrict q) {
+    const __m128i a = _mm_loadu_si128(q);
+    _mm_storeu_si128(p, _mm_unpacklo_epi8(a, a));
+    _mm_storeu_si128(p + 1, _mm_unpackhi_epi8(a, a));
+  }
+
+  gcc_always_inline
+  static void Copy4(__m128i *gcc_restrict p, const __m128i *gcc_restrict q) {
+    const __m128i a = _mm_loadu_si128(q);
+    _mm_storeu_si128(p, _mm_unpacklo_epi32(a, a));
+    _mm_storeu_si128(p + 1, _mm_unpackhi_epi32(a, a));
+  }
+
+  /**
+   * @param n the number of source pixels (multiple of 16)
+   */
+  gcc_flatten
+  void CopyPixels(Luminosity8 *gcc_restrict p,
+                  const Luminosity8 *gcc_restrict q, unsigned n) const {
+    __m128i *p2 = (__m128i *)p;
+    const __m128i *q2 = (const __m128i *)q;
+
+    for (unsigned i = 0; i < n / 16; ++i, p2 += 2, ++q2)
+      Copy16(p2, q2);
+  }
+
+  /**
+   * @param n the number of source pixels (multiple of 4)
+   */
+  gcc_flatten
+  void CopyPixels(BGRA8Color *gcc_restrict p,
+                  const BGRA8Color *gcc_restrict q, unsigned n) const {
+    __m128i *p2 = (__m128i *)p;
+    const __m128i *q2 = (const __m128i *)q;
+
+    for (unsigned i = 0; i < n / 4; ++i, p2 += 2, ++q2)
+      Copy4(p2, q2);
+  }
+};
+
+#if CLANG_OR_GCC_VERSION(4,8)
+#pragma GCC diagnostic pop
+#endif
+
+#endif
@@ -153,4 +153,11 @@ public:
 class GLArrayBuffer : public GLBuffer<GL_ARRAY_BUFFER, GL_STATIC_DRAW> {
 };
 
+/**
+ * An array buffer which is rewritten (orphaned) for every frame.
+ */
+class GLDynamicArrayBuffer
+  : public GLBuffer<GL_ARRAY_BUFFER, GL_DYNAMIC_DRAW> {
+};
+
 #endif
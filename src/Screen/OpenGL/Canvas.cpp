@@ -51,6 +51,16 @@ Copyright_License {
 #include "Util/ConvertString.hpp"
 #endif
 
+#ifdef USE_FREETYPE
+#include "Screen/Font.hpp"
+#include "Screen/FreeType/GlyphCache.hpp"
+#include "GlyphAtlas.hpp"
+#include "Util/StringAPI.hxx"
+
+#include <algorithm>
+#include <limits>
+#endif
+
 #ifndef NDEBUG
 #include "Util/UTF8.hpp"
 #endif
@@ -608,6 +618,133 @@ PrepareColoredAlphaTexture(Color color)
 #endif
 }
 
+#ifdef USE_FREETYPE
+
+static AllocatedArray<RasterPoint> glyph_vertices;
+static AllocatedArray<GLfloat> glyph_coords;
+
+/**
+ * Lay out the text with the font's #GlyphCache and fill
+ * #glyph_vertices and #glyph_coords with two triangles per glyph,
+ * referring to the font's #GlyphAtlas.  Glyphs are clipped to the
+ * given rectangle.
+ *
+ * @param width_r receives the width of the text (just like
+ * Font::TextSize())
+ * @return the number of vertices, or -1 if the #GlyphAtlas is too
+ * small for this text
+ */
+static int
+LayoutGlyphs(const Font &font, int x, int y, const TCHAR *text,
+             int clip_right, int clip_bottom, unsigned &width_r)
+{
+  GlyphCache &glyphs = font.GetGlyphCache();
+  GlyphAtlas &atlas = glyphs.GetAtlas();
+
+  /* there can't be more glyphs than characters */
+  const size_t max_vertices = StringLength(text) * 6;
+  glyph_vertices.GrowDiscard(max_vertices);
+  glyph_coords.GrowDiscard(max_vertices * 2);
+
+  if (!glyphs.AddToAtlas(text, atlas))
+    return -1;
+
+  const GLfloat scale = 1.f / atlas.GetSize();
+
+  RasterPoint *v = glyph_vertices.begin();
+  GLfloat *c = glyph_coords.begin();
+
+  width_r = glyphs.ForEach(text, font.GetAscentHeight(),
+                           [&](int gx, int gy, const FreeTypeGlyph &glyph){
+    if (glyph.data == nullptr)
+      return;
+
+    int left = x + gx, top = y + gy;
+    int right = std::min(left + int(glyph.width), clip_right);
+    int bottom = std::min(top + int(glyph.height), clip_bottom);
+    int src_x = glyph.slot.x, src_y = glyph.slot.y;
+
+    if (left < x) {
+      src_x += x - left;
+      left = x;
+    }
+
+    if (top < y) {
+      src_y += y - top;
+      top = y;
+    }
+
+    if (left >= right || top >= bottom)
+      return;
+
+    const GLfloat x0 = src_x * scale, y0 = src_y * scale;
+    const GLfloat x1 = (src_x + right - left) * scale;
+    const GLfloat y1 = (src_y + bottom - top) * scale;
+
+    *v++ = { left, top };
+    *v++ = { right, top };
+    *v++ = { left, bottom };
+    *v++ = { left, bottom };
+    *v++ = { right, top };
+    *v++ = { right, bottom };
+
+    const GLfloat coord[] = {
+      x0, y0,
+      x1, y0,
+      x0, y1,
+      x0, y1,
+      x1, y0,
+      x1, y1,
+    };
+
+    c = std::copy_n(coord, ARRAY_SIZE(coord), c);
+  });
+
+  return v - glyph_vertices.begin();
+}
+
+/**
+ * Draw the triangles generated by LayoutGlyphs() with one draw call.
+ */
+static void
+DrawGlyphs(const Font &font, unsigned n_vertices, Color color)
+{
+  if (n_vertices == 0)
+    return;
+
+  PrepareColoredAlphaTexture(color);
+
+#ifndef USE_GLSL
+  const GLEnable<GL_TEXTURE_2D> scope;
+#endif
+
+  const GLBlend blend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+  font.GetGlyphCache().GetAtlas().Bind();
+
+  const ScopeVertexPointer vp(glyph_vertices.begin());
+
+#ifdef USE_GLSL
+  glEnableVertexAttribArray(OpenGL::Attribute::TEXCOORD);
+  glVertexAttribPointer(OpenGL::Attribute::TEXCOORD, 2, GL_FLOAT, GL_FALSE,
+                        0, glyph_coords.begin());
+#else
+  glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+  glTexCoordPointer(2, GL_FLOAT, 0, glyph_coords.begin());
+#endif
+
+  glDrawArrays(GL_TRIANGLES, 0, n_vertices);
+
+#ifdef USE_GLSL
+  glDisableVertexAttribArray(OpenGL::Attribute::TEXCOORD);
+  OpenGL::solid_shader->Use();
+#else
+  glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+#endif
+}
+
+#endif
+
 void
 Canvas::DrawText(int x, int y, const TCHAR *text)
 {
@@ -626,6 +763,21 @@ Canvas::DrawText(int x, int y, const TCHAR *text)
   if (font == nullptr)
     return;
 
+#ifdef USE_FREETYPE
+  unsigned width;
+  const int n_vertices =
+    LayoutGlyphs(*font, x, y, text, std::numeric_limits<int>::max(),
+                 y + int(font->GetHeight()), width);
+  if (n_vertices >= 0) {
+    if (background_mode == OPAQUE && width > 0)
+      DrawFilledRectangle(x, y, x + width, y + font->GetHeight(),
+                          background_color);
+
+    DrawGlyphs(*font, n_vertices, text_color);
+    return;
+  }
+#endif
+
   GLTexture *texture = TextCache::Get(*font, text2);
   if (texture == nullptr)
     return;
@@ -665,6 +817,17 @@ Canvas::DrawTransparentText(int x, int y, const TCHAR *text)
   if (font == nullptr)
     return;
 
+#ifdef USE_FREETYPE
+  unsigned width;
+  const int n_vertices =
+    LayoutGlyphs(*font, x, y, text, std::numeric_limits<int>::max(),
+                 y + int(font->GetHeight()), width);
+  if (n_vertices >= 0) {
+    DrawGlyphs(*font, n_vertices, text_color);
+    return;
+  }
+#endif
+
   GLTexture *texture = TextCache::Get(*font, text2);
   if (texture == nullptr)
     return;
@@ -701,6 +864,17 @@ Canvas::DrawClippedText(int x, int y,
   if (font == nullptr)
     return;
 
+#ifdef USE_FREETYPE
+  unsigned text_width;
+  const int n_vertices =
+    LayoutGlyphs(*font, x, y, text, x + int(width),
+                 y + int(std::min(height, font->GetHeight())), text_width);
+  if (n_vertices >= 0) {
+    DrawGlyphs(*font, n_vertices, text_color);
+    return;
+  }
+#endif
+
   GLTexture *texture = TextCache::Get(*font, text2);
   if (texture == nullptr)
     return;
@@ -245,14 +245,14 @@ public:
 };
 
 struct ScopeColorPointer {
-  ScopeColorPointer(const Color *p) {
+  ScopeColorPointer(const Color *p, GLsizei stride=0) {
 #ifdef USE_GLSL
     glEnableVertexAttribArray(OpenGL::Attribute::COLOR);
     glVertexAttribPointer(OpenGL::Attribute::COLOR, 4, Color::TYPE,
-                          GL_FALSE, 0, p);
+                          GL_FALSE, stride, p);
 #else
     glEnableClientState(GL_COLOR_ARRAY);
-    glColorPointer(4, Color::TYPE, 0, p);
+    glColorPointer(4, Color::TYPE, stride, p);
 #endif
   }
 
@@ -51,6 +51,23 @@ namespace GLExt {
 #endif
   }
 
+  static inline bool HaveMultiDrawArrays() {
+#ifdef HAVE_DYNAMIC_MULTI_DRAW_ARRAYS
+    return multi_draw_arrays != nullptr;
+#else
+    return true;
+#endif
+  }
+
+  template<typename... Args>
+  static inline void MultiDrawArrays(Args... args) {
+#ifdef HAVE_DYNAMIC_MULTI_DRAW_ARRAYS
+    multi_draw_arrays(args...);
+#else
+    glMultiDrawArraysEXT(args...);
+#endif
+  }
+
   template<typename... Args>
   static inline void MultiDrawElements(Args... args) {
 #ifdef HAVE_DYNAMIC_MULTI_DRAW_ARRAYS
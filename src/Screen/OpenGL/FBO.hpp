@@ -37,6 +37,7 @@ namespace FBO {
 
   static constexpr GLenum RENDERBUFFER = GL_RENDERBUFFER_OES;
   static constexpr GLenum FRAMEBUFFER = GL_FRAMEBUFFER_OES;
+  static constexpr GLenum FRAMEBUFFER_BINDING = GL_FRAMEBUFFER_BINDING_OES;
   static constexpr GLenum COLOR_ATTACHMENT0 = GL_COLOR_ATTACHMENT0_OES;
   static constexpr GLenum DEPTH_ATTACHMENT = GL_DEPTH_ATTACHMENT_OES;
   static constexpr GLenum STENCIL_ATTACHMENT = GL_STENCIL_ATTACHMENT_OES;
@@ -66,12 +67,14 @@ namespace FBO {
 #ifdef HAVE_GLES2
   static constexpr GLenum RENDERBUFFER = GL_RENDERBUFFER;
   static constexpr GLenum FRAMEBUFFER = GL_FRAMEBUFFER;
+  static constexpr GLenum FRAMEBUFFER_BINDING = GL_FRAMEBUFFER_BINDING;
   static constexpr GLenum COLOR_ATTACHMENT0 = GL_COLOR_ATTACHMENT0;
   static constexpr GLenum DEPTH_ATTACHMENT = GL_DEPTH_ATTACHMENT;
   static constexpr GLenum STENCIL_ATTACHMENT = GL_STENCIL_ATTACHMENT;
 #else
   static constexpr GLenum RENDERBUFFER = GL_RENDERBUFFER_EXT;
   static constexpr GLenum FRAMEBUFFER = GL_FRAMEBUFFER_EXT;
+  static constexpr GLenum FRAMEBUFFER_BINDING = GL_FRAMEBUFFER_BINDING_EXT;
   static constexpr GLenum COLOR_ATTACHMENT0 = GL_COLOR_ATTACHMENT0_EXT;
   static constexpr GLenum DEPTH_ATTACHMENT = GL_DEPTH_ATTACHMENT_EXT;
   static constexpr GLenum STENCIL_ATTACHMENT = GL_STENCIL_ATTACHMENT_EXT;
@@ -0,0 +1,103 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+#include "GlyphAtlas.hpp"
+#include "Texture.hpp"
+#include "Compiler.h"
+
+gcc_const
+static unsigned
+CalculateAtlasSize(unsigned font_height)
+{
+  /* enough room for roughly 150 glyphs */
+  const unsigned wanted = font_height * 12;
+
+  unsigned size = 256;
+  while (size < wanted && size < 1024)
+    size <<= 1;
+
+  return size;
+}
+
+GlyphAtlas::GlyphAtlas(unsigned font_height)
+  :texture(nullptr), packer(CalculateAtlasSize(font_height))
+{
+  AddSurfaceListener(*this);
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+  RemoveSurfaceListener(*this);
+  delete texture;
+}
+
+GLTexture &
+GlyphAtlas::Bind()
+{
+  if (texture == nullptr) {
+    const unsigned size = packer.GetSize();
+    uint8_t *zero = new uint8_t[size * size]();
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    texture = new GLTexture(GL_ALPHA, size, size,
+                            GL_ALPHA, GL_UNSIGNED_BYTE, zero);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    delete[] zero;
+
+    /* glyphs are always drawn 1:1; don't let neighbours bleed in */
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  } else
+    texture->Bind();
+
+  return *texture;
+}
+
+bool
+GlyphAtlas::Add(Slot &slot, unsigned width, unsigned height,
+                const uint8_t *data)
+{
+  if (!packer.Allocate(slot, width, height))
+    return false;
+
+  Bind();
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, slot.x, slot.y, width, height,
+                  GL_ALPHA, GL_UNSIGNED_BYTE, data);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+  return true;
+}
+
+void
+GlyphAtlas::SurfaceCreated()
+{
+}
+
+void
+GlyphAtlas::SurfaceDestroyed()
+{
+  delete texture;
+  texture = nullptr;
+
+  Clear();
+}
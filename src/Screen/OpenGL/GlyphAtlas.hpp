@@ -0,0 +1,92 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+#ifndef XCSOAR_SCREEN_OPENGL_GLYPH_ATLAS_HPP
+#define XCSOAR_SCREEN_OPENGL_GLYPH_ATLAS_HPP
+
+#include "Surface.hpp"
+#include "Screen/FreeType/GlyphPacker.hpp"
+
+#include <stdint.h>
+
+class GLTexture;
+
+/**
+ * A GL_ALPHA texture which stores the glyphs of one font, packed
+ * by a #GlyphPacker.  When it is full, it is cleared, which
+ * invalidates all #Slot instances handed out before.
+ */
+class GlyphAtlas final : private GLSurfaceListener {
+public:
+  typedef GlyphPacker::Slot Slot;
+
+private:
+  GLTexture *texture;
+
+  /**
+   * Allocates the glyph positions.  Its size (the width and height
+   * of the texture) is a power of two.
+   */
+  GlyphPacker packer;
+
+public:
+  explicit GlyphAtlas(unsigned font_height);
+  ~GlyphAtlas();
+
+  GlyphAtlas(const GlyphAtlas &) = delete;
+  GlyphAtlas &operator=(const GlyphAtlas &) = delete;
+
+  unsigned GetSize() const {
+    return packer.GetSize();
+  }
+
+  bool IsValid(const Slot &slot) const {
+    return packer.IsValid(slot);
+  }
+
+  /**
+   * Copy an alpha bitmap (one byte per pixel, no padding) into the
+   * atlas.
+   *
+   * @return false if the atlas is full
+   */
+  bool Add(Slot &slot, unsigned width, unsigned height, const uint8_t *data);
+
+  /**
+   * Forget all glyphs.
+   */
+  void Clear() {
+    packer.Clear();
+  }
+
+  /**
+   * Bind the texture, creating it if necessary.
+   */
+  GLTexture &Bind();
+
+private:
+  /* virtual methods from class GLSurfaceListener */
+  void SurfaceCreated() override;
+  void SurfaceDestroyed() override;
+};
+
+#endif
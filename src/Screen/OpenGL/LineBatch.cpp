@@ -0,0 +1,178 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+#include "LineBatch.hpp"
+#include "Buffer.hpp"
+#include "FallbackBuffer.hpp"
+#include "VertexPointer.hpp"
+#include "Triangulate.hpp"
+#include "Shapes.hpp"
+#include "Screen/Pen.hpp"
+#include "Math/FastTrig.hpp"
+
+#include <algorithm>
+
+#include <stddef.h>
+#include <stdint.h>
+
+GLLineBatch::GLLineBatch()
+{
+  AddSurfaceListener(*this);
+}
+
+GLLineBatch::~GLLineBatch()
+{
+  RemoveSurfaceListener(*this);
+
+  delete buffer;
+}
+
+GLLineBatch::Vertex *
+GLLineBatch::Append(GLenum mode, unsigned width, unsigned n)
+{
+  const unsigned start = vertices.size();
+  vertices.resize(start + n);
+
+  if (runs.empty() || runs.back().mode != mode || runs.back().width != width)
+    runs.push_back({mode, width, start, n});
+  else
+    runs.back().count += n;
+
+  return vertices.data() + start;
+}
+
+void
+GLLineBatch::AddLine(RasterPoint a, RasterPoint b, const Pen &pen)
+{
+  const Color color = pen.GetColor();
+  const unsigned width = pen.GetWidth();
+
+  if (width <= 2) {
+    Vertex *v = Append(GL_LINES, width, 2);
+    v[0] = Vertex(a, color);
+    v[1] = Vertex(b, color);
+    return;
+  }
+
+  const RasterPoint line[] = { a, b };
+  const unsigned strip_len = LineToTriangles(line, 2, strip, width,
+                                             false, true);
+  if (strip_len < 3)
+    return;
+
+  /* convert the triangle strip to separate triangles, so it can be
+     merged with its neighbours */
+  Vertex *v = Append(GL_TRIANGLES, 0, (strip_len - 2) * 3);
+  for (unsigned i = 2; i < strip_len; ++i) {
+    *v++ = Vertex(strip[i - 2], color);
+    *v++ = Vertex(strip[i - 1], color);
+    *v++ = Vertex(strip[i], color);
+  }
+}
+
+void
+GLLineBatch::AddDot(RasterPoint center, unsigned radius, Color color)
+{
+  const unsigned n = radius < 16
+    ? OpenGL::SMALL_CIRCLE_SIZE
+    : OpenGL::CIRCLE_SIZE;
+  const unsigned step = 4096 / n;
+
+  RasterPoint previous(center.x + GLvalue(radius), center.y);
+
+  Vertex *v = Append(GL_TRIANGLES, 0, n * 3);
+  for (unsigned i = 1; i <= n; ++i) {
+    const unsigned angle = (i * step) & 0xfff;
+    const RasterPoint p(center.x +
+                        GLvalue(ISINETABLE[(angle + 1024) & 0xfff] *
+                                int(radius) / 1024),
+                        center.y +
+                        GLvalue(ISINETABLE[angle] * int(radius) / 1024));
+
+    *v++ = Vertex(center, color);
+    *v++ = Vertex(previous, color);
+    *v++ = Vertex(p, color);
+    previous = p;
+  }
+}
+
+static void
+SetLineWidth(unsigned width)
+{
+#if defined(HAVE_GLES) && !defined(HAVE_GLES2)
+  glLineWidthx(width << 16);
+#else
+  glLineWidth(width);
+#endif
+}
+
+void
+GLLineBatch::Flush()
+{
+  if (vertices.empty())
+    return;
+
+  if (buffer == nullptr)
+    buffer = new GLFallbackBuffer<GLDynamicArrayBuffer>();
+
+  /* stream the whole batch into one buffer; BeginWrite() orphans the
+     previous contents, so the driver does not have to wait for the
+     last frame's draw calls */
+  const size_t size = vertices.size() * sizeof(vertices.front());
+  void *p = buffer->BeginWrite(size);
+  std::copy(vertices.begin(), vertices.end(), (Vertex *)p);
+  buffer->CommitWrite(size, p);
+
+  const uint8_t *const base = (const uint8_t *)buffer->BeginRead();
+
+  ScopeVertexPointer vp;
+  vp.Update(GL_VALUE, sizeof(Vertex), base + offsetof(Vertex, point));
+
+  const ScopeColorPointer cp((const Color *)(base + offsetof(Vertex, color)),
+                             sizeof(Vertex));
+
+  unsigned line_width = 0;
+  for (const Run &run : runs) {
+    if (run.mode == GL_LINES && run.width != line_width) {
+      line_width = run.width;
+      SetLineWidth(line_width);
+    }
+
+    glDrawArrays(run.mode, run.start, run.count);
+  }
+
+  buffer->EndRead();
+
+  Clear();
+}
+
+void
+GLLineBatch::SurfaceCreated()
+{
+}
+
+void
+GLLineBatch::SurfaceDestroyed()
+{
+  delete buffer;
+  buffer = nullptr;
+}
@@ -0,0 +1,127 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+#ifndef XCSOAR_SCREEN_OPENGL_LINE_BATCH_HPP
+#define XCSOAR_SCREEN_OPENGL_LINE_BATCH_HPP
+
+#include "Surface.hpp"
+#include "Point.hpp"
+#include "Color.hpp"
+#include "Util/AllocatedArray.hpp"
+
+#include <vector>
+
+class Pen;
+class GLDynamicArrayBuffer;
+template<class B> class GLFallbackBuffer;
+
+/**
+ * Collects line segments and filled dots with per-vertex colors, and
+ * submits them with a few draw calls from a streamed vertex buffer
+ * object.  This replaces one state change and one draw call per
+ * segment, which is expensive for the long, multi-colored snail
+ * trail.
+ *
+ * Segments are drawn in the order they were added.  Consecutive
+ * segments are merged into one draw call as long as they share the
+ * same primitive type: thin lines (up to 2 pixels) become GL_LINES
+ * of the same width, thicker lines and dots become GL_TRIANGLES.
+ */
+class GLLineBatch final : GLSurfaceListener {
+  struct Vertex {
+    RasterPoint point;
+    Color color;
+
+    Vertex() = default;
+    constexpr Vertex(RasterPoint _point, Color _color)
+      :point(_point), color(_color) {}
+  };
+
+  /**
+   * A range of #vertices which can be drawn with one call.
+   */
+  struct Run {
+    GLenum mode;
+
+    /**
+     * The line width for GL_LINES; 0 for GL_TRIANGLES.
+     */
+    unsigned width;
+
+    unsigned start, count;
+  };
+
+  std::vector<Vertex> vertices;
+  std::vector<Run> runs;
+
+  /**
+   * Scratch buffer for LineToTriangles().
+   */
+  AllocatedArray<RasterPoint> strip;
+
+  /**
+   * Allocated on the first Flush() call, when the OpenGL context is
+   * known to be available, and freed when the surface is destroyed.
+   */
+  GLFallbackBuffer<GLDynamicArrayBuffer> *buffer = nullptr;
+
+public:
+  GLLineBatch();
+  GLLineBatch(const GLLineBatch &) = delete;
+  ~GLLineBatch();
+
+  bool IsEmpty() const {
+    return vertices.empty();
+  }
+
+  void Clear() {
+    vertices.clear();
+    runs.clear();
+  }
+
+  /**
+   * Add a line segment with the color and width of the given #Pen,
+   * like Canvas::DrawLinePiece() would draw it.  Dash styles are not
+   * supported.
+   */
+  void AddLine(RasterPoint a, RasterPoint b, const Pen &pen);
+
+  /**
+   * Add a filled circle.
+   */
+  void AddDot(RasterPoint center, unsigned radius, Color color);
+
+  /**
+   * Draw all collected segments and clear the batch.  The caller is
+   * responsible for selecting the shader program (#OpenGL::solid_shader).
+   */
+  void Flush();
+
+private:
+  Vertex *Append(GLenum mode, unsigned width, unsigned n);
+
+  /* virtual methods from class GLSurfaceListener */
+  void SurfaceCreated() override;
+  void SurfaceDestroyed() override;
+};
+
+#endif
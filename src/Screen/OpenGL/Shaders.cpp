@@ -41,6 +41,12 @@ namespace OpenGL {
 
   GLProgram *alpha_shader;
   GLint alpha_projection, alpha_texture;
+
+  GLProgram *terrain_shader;
+  GLint terrain_heights, terrain_colors, terrain_texel,
+    terrain_size, terrain_height_scale, terrain_contour_scale,
+    terrain_quantisation, terrain_slope_factor, terrain_sun,
+    terrain_contrast;
 }
 
 #ifdef HAVE_GLES
@@ -118,6 +124,108 @@ static constexpr char alpha_fragment_shader[] =
   "  gl_FragColor = vec4(colorvar.rgb, texture2D(texture, texcoordvar).a);"
   "}";
 
+static constexpr char terrain_vertex_shader[] =
+  GLSL_VERSION
+  "attribute vec4 position;"
+  "attribute vec2 texcoord;"
+  "varying vec2 texcoordvar;"
+  "void main() {"
+  "  gl_Position = position;"
+  "  texcoordvar = texcoord;"
+  "}";
+
+/* this is RasterRenderer::GenerateSlopeImage() for one pixel; the
+   integer arithmetics need more than the 10 bit mantissa of
+   "mediump" */
+static constexpr char terrain_fragment_shader[] =
+  GLSL_VERSION
+#ifdef HAVE_GLES
+  "#ifdef GL_FRAGMENT_PRECISION_HIGH\n"
+  "precision highp float;\n"
+  "#else\n"
+  "precision mediump float;\n"
+  "#endif\n"
+#endif
+  "uniform sampler2D heights;"
+  "uniform sampler2D colors;"
+  "uniform vec2 texel;"
+  "uniform vec2 size;"
+  "uniform float height_scale;"
+  "uniform float contour_scale;"
+  "uniform float quantisation;"
+  "uniform float slope_factor;"
+  "uniform vec3 sun;"
+  "uniform float contrast;"
+  "varying vec2 texcoordvar;"
+  "float Height(vec2 p) {"
+  "  vec4 t = texture2D(heights, (p + 0.5) * texel);"
+  "  return floor(t.a * 255.0 + 0.5) * 256.0"
+  "    + floor(t.r * 255.0 + 0.5) - 32768.0;"
+  "}"
+  "bool IsSpecial(float h) {"
+  "  return h <= -30000.0;"
+  "}"
+  "float Trunc(float x) {"
+  "  return sign(x) * floor(abs(x));"
+  "}"
+  "float ContourInterval(float h) {"
+  "  if (IsSpecial(h) || h <= 0.0) return 0.0;"
+  "  return min(254.0, floor(h / contour_scale));"
+  "}"
+  "vec4 Lookup(float h, float illum) {"
+  "  return texture2D(colors, vec2((h + 0.5) / 256.0,"
+  "                                (illum + 64.5) / 128.0));"
+  "}"
+  "void main() {"
+  "  vec2 p = floor(texcoordvar);"
+  "  float h = Height(p);"
+  "  if (h == -32768.0) {"
+  "    gl_FragColor = vec4(1.0);"
+  "    return;"
+  "  }"
+  "  if (IsSpecial(h)) {"
+  "    gl_FragColor = Lookup(255.0, 0.0);"
+  "    return;"
+  "  }"
+  "  h = max(h, 0.0);"
+  "  float contour = ContourInterval(h);"
+  "  float color_index = min(254.0, floor(h / height_scale));"
+  "  vec2 plus = min(vec2(quantisation), size - 1.0 - p);"
+  "  vec2 minus = min(vec2(quantisation), p);"
+  "  float h_above = Height(p - vec2(0.0, minus.y));"
+  "  float h_below = Height(p + vec2(0.0, plus.y));"
+  "  float h_left = Height(p - vec2(minus.x, 0.0));"
+  "  float h_right = Height(p + vec2(plus.x, 0.0));"
+  "  if (quantisation > 0.0 &&"
+  "      (IsSpecial(h_above) || IsSpecial(h_below) ||"
+  "       IsSpecial(h_left) || IsSpecial(h_right))) {"
+  "    gl_FragColor = Lookup(color_index, 0.0);"
+  "    return;"
+  "  }"
+  "  if ((p.x > 0.0 &&"
+  "       contour != ContourInterval(Height(p - vec2(1.0, 0.0)))) ||"
+  "      (p.y > 0.0 &&"
+  "       contour != ContourInterval(Height(p - vec2(0.0, 1.0))))) {"
+  "    gl_FragColor = Lookup(color_index, -64.0);"
+  "    return;"
+  "  }"
+  "  if (quantisation <= 0.0) {"
+  "    gl_FragColor = Lookup(color_index, 0.0);"
+  "    return;"
+  "  }"
+  "  float p20 = plus.x + minus.x;"
+  "  float p31 = plus.y + minus.y;"
+  "  float dd0 = clamp(h_right - h_left, -512.0, 512.0) * p31;"
+  "  float dd1 = p20 * clamp(h_above - h_below, -512.0, 512.0);"
+  "  float dd2 = p20 * p31 * slope_factor;"
+  "  float num = dd2 * sun.z + dd0 * sun.x + dd1 * sun.y;"
+  "  float mag = floor(sqrt(dd0 * dd0 + dd1 * dd1 + dd2 * dd2));"
+  "  mag += 1.0 - mod(mag, 2.0);"
+  "  float sval = Trunc(num / mag);"
+  "  float illum = Trunc((sval - sun.z) * contrast / 128.0);"
+  "  gl_FragColor = Lookup(color_index, clamp(illum, -63.0, 63.0));"
+  "}";
+
 static void
 CompileAttachShader(GLProgram &program, GLenum type, const char *code)
 {
@@ -218,6 +326,27 @@ OpenGL::InitShaders()
   alpha_shader->Use();
   glUniform1i(alpha_texture, 0);
 
+  terrain_shader = CompileProgram(terrain_vertex_shader,
+                                  terrain_fragment_shader);
+  terrain_shader->BindAttribLocation(Attribute::POSITION, "position");
+  terrain_shader->BindAttribLocation(Attribute::TEXCOORD, "texcoord");
+  LinkProgram(*terrain_shader);
+
+  terrain_heights = terrain_shader->GetUniformLocation("heights");
+  terrain_colors = terrain_shader->GetUniformLocation("colors");
+  terrain_texel = terrain_shader->GetUniformLocation("texel");
+  terrain_size = terrain_shader->GetUniformLocation("size");
+  terrain_height_scale = terrain_shader->GetUniformLocation("height_scale");
+  terrain_contour_scale = terrain_shader->GetUniformLocation("contour_scale");
+  terrain_quantisation = terrain_shader->GetUniformLocation("quantisation");
+  terrain_slope_factor = terrain_shader->GetUniformLocation("slope_factor");
+  terrain_sun = terrain_shader->GetUniformLocation("sun");
+  terrain_contrast = terrain_shader->GetUniformLocation("contrast");
+
+  terrain_shader->Use();
+  glUniform1i(terrain_heights, 0);
+  glUniform1i(terrain_colors, 1);
+
   glVertexAttrib4f(Attribute::TRANSLATE, 0, 0, 0, 0);
 }
 
@@ -61,6 +61,17 @@ namespace OpenGL {
   extern GLProgram *alpha_shader;
   extern GLint alpha_projection, alpha_texture;
 
+  /**
+   * A shader that colours and slope-shades a terrain height texture
+   * (see #GLTerrainImage).  Its vertices are in clip space, its
+   * texture coordinates in height texels.
+   */
+  extern GLProgram *terrain_shader;
+  extern GLint terrain_heights, terrain_colors, terrain_texel,
+    terrain_size, terrain_height_scale, terrain_contour_scale,
+    terrain_quantisation, terrain_slope_factor, terrain_sun,
+    terrain_contrast;
+
   void InitShaders();
   void DeinitShaders();
 
@@ -101,6 +101,8 @@ Copyright_License {
 #include "Android/Nook.hpp"
 #include <windef.h>
 #include "IO/FileLineReader.hpp"
+#include "IO/TextWriter.hpp"
+#include "JSON/TracingWriter.hpp"
 #include "Dialogs/Settings/Panels/StartupConfigPanel.hpp"
 #include "OS/Args.hpp"
 #include "Util/StaticString.hxx"
@@ -816,5 +818,14 @@ Shutdown()
 
   StartupLogFreeRamAndStorage();
 
+#ifdef HAVE_CMDLINE_TRACE
+  if (CommandLine::trace_path.length() > 0) {
+    LogFormat("Write trace to %s", CommandLine::trace_path.c_str());
+    TextWriter writer(CommandLine::trace_path.c_str());
+    if (writer.IsOpen())
+      JSON::WriteTracing(writer);
+  }
+#endif
+
   LogFormat("Finished shutdown");
 }
@@ -0,0 +1,297 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+#ifdef USE_GLSL
+
+#include "GLTerrainImage.hpp"
+#include "HeightMatrix.hpp"
+#include "Screen/RawBitmap.hpp"
+#include "Screen/OpenGL/Texture.hpp"
+#include "Screen/OpenGL/FrameBuffer.hpp"
+#include "Screen/OpenGL/VertexPointer.hpp"
+#include "Screen/OpenGL/Shaders.hpp"
+#include "Screen/OpenGL/Program.hpp"
+#include "Screen/OpenGL/Globals.hpp"
+
+#include <assert.h>
+
+GLTerrainImage::GLTerrainImage(const BGRColor *_color_table)
+  :color_table(_color_table), width(0), height(0),
+   height_texture(nullptr), color_texture(nullptr), image(nullptr),
+   frame_buffer(nullptr),
+   heights_dirty(false), colors_dirty(true), image_dirty(false)
+{
+  AddSurfaceListener(*this);
+}
+
+GLTerrainImage::~GLTerrainImage()
+{
+  RemoveSurfaceListener(*this);
+  SurfaceDestroyed();
+}
+
+bool
+GLTerrainImage::IsAvailable()
+{
+  if (!OpenGL::frame_buffer_object)
+    return false;
+
+#ifdef HAVE_GLES
+  /* the shader does integer arithmetics with floats, which needs the
+     24 bit mantissa of "highp"; it is optional in fragment shaders */
+  GLint range[2], precision;
+  glGetShaderPrecisionFormat(GL_FRAGMENT_SHADER, GL_HIGH_FLOAT,
+                             range, &precision);
+  if (precision < 23)
+    return false;
+#endif
+
+  return true;
+}
+
+void
+GLTerrainImage::SetHeights(const HeightMatrix &matrix)
+{
+  width = matrix.GetWidth();
+  height = matrix.GetHeight();
+
+  const unsigned n = width * height;
+  heights.GrowDiscard(n * 2);
+
+  const short *src = matrix.GetData();
+  uint8_t *dest = heights.begin();
+  for (unsigned i = 0; i < n; ++i) {
+    const unsigned value = uint16_t(src[i]) ^ 0x8000;
+    *dest++ = value;
+    *dest++ = value >> 8;
+  }
+
+  heights_dirty = image_dirty = true;
+}
+
+void
+GLTerrainImage::Generate(unsigned height_scale,
+                         unsigned contour_height_scale,
+                         unsigned quantisation, unsigned slope_factor,
+                         int sx, int sy, int sz, int contrast)
+{
+  parameters.height_scale = height_scale;
+  parameters.contour_height_scale = contour_height_scale;
+  parameters.quantisation = quantisation;
+  parameters.slope_factor = slope_factor;
+  parameters.sx = sx;
+  parameters.sy = sy;
+  parameters.sz = sz;
+  parameters.contrast = contrast;
+
+  image_dirty = true;
+}
+
+/**
+ * Disable interpolation of the currently bound texture; the shader
+ * looks up individual texels.
+ */
+static void
+DisableInterpolation()
+{
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+}
+
+inline void
+GLTerrainImage::UploadHeights()
+{
+  /* rows are 2*width bytes long */
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+
+  if (height_texture == nullptr ||
+      height_texture->GetWidth() < width ||
+      height_texture->GetHeight() < height) {
+    delete height_texture;
+    height_texture = new GLTexture(GL_LUMINANCE_ALPHA, width, height,
+                                   GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE,
+                                   heights.begin());
+    DisableInterpolation();
+  } else {
+    height_texture->Bind();
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height,
+                    GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, heights.begin());
+  }
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+inline void
+GLTerrainImage::UploadColors()
+{
+#ifdef HAVE_GLES
+  /* 16 bit 5/6/5 on Android */
+  static constexpr GLenum format = GL_RGB, type = GL_UNSIGNED_SHORT_5_6_5;
+#else
+  /* 32 bit R/G/B/A on full OpenGL */
+  static constexpr GLenum format = GL_BGRA, type = GL_UNSIGNED_BYTE;
+#endif
+
+  if (color_texture == nullptr) {
+    color_texture = new GLTexture(GL_RGB, 256, 128, format, type,
+                                  color_table);
+    DisableInterpolation();
+  } else {
+    color_texture->Bind();
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 256, 128,
+                    format, type, color_table);
+  }
+}
+
+inline void
+GLTerrainImage::Render()
+{
+  if (image == nullptr) {
+    image = new GLTexture(width, height);
+    image->EnableInterpolation();
+  } else
+    image->ResizeDiscard({width, height});
+
+  if (frame_buffer == nullptr)
+    frame_buffer = new GLFrameBuffer();
+
+  /* this may be called while drawing into another frame buffer
+     (e.g. a #BufferCanvas); save the state we are going to modify */
+  GLint old_frame_buffer, old_viewport[4];
+  glGetIntegerv(FBO::FRAMEBUFFER_BINDING, &old_frame_buffer);
+  glGetIntegerv(GL_VIEWPORT, old_viewport);
+
+  const bool scissor = glIsEnabled(GL_SCISSOR_TEST);
+  if (scissor)
+    glDisable(GL_SCISSOR_TEST);
+
+  frame_buffer->Bind();
+  image->AttachFramebuffer(FBO::COLOR_ATTACHMENT0);
+  glViewport(0, 0, width, height);
+
+  const PixelSize allocated = height_texture->GetAllocatedSize();
+
+  OpenGL::terrain_shader->Use();
+  glUniform2f(OpenGL::terrain_texel,
+              1.f / allocated.cx, 1.f / allocated.cy);
+  glUniform2f(OpenGL::terrain_size, width, height);
+  glUniform1f(OpenGL::terrain_height_scale,
+              1u << parameters.height_scale);
+  glUniform1f(OpenGL::terrain_contour_scale,
+              1u << parameters.contour_height_scale);
+  glUniform1f(OpenGL::terrain_quantisation, parameters.quantisation);
+  glUniform1f(OpenGL::terrain_slope_factor, parameters.slope_factor);
+  glUniform3f(OpenGL::terrain_sun,
+              parameters.sx, parameters.sy, parameters.sz);
+  glUniform1f(OpenGL::terrain_contrast, parameters.contrast);
+
+  glActiveTexture(GL_TEXTURE1);
+  color_texture->Bind();
+  glActiveTexture(GL_TEXTURE0);
+  height_texture->Bind();
+
+  /* row 0 of the height matrix ends up in row 0 of the image, just
+     like #RawBitmap */
+  const GLfloat w = width, h = height;
+  const GLfloat position[] = {
+    -1, -1,
+    1, -1,
+    -1, 1,
+    1, 1,
+  };
+
+  const GLfloat coord[] = {
+    0, 0,
+    w, 0,
+    0, h,
+    w, h,
+  };
+
+  const ScopeVertexPointer vp(GL_FLOAT, position);
+  glEnableVertexAttribArray(OpenGL::Attribute::TEXCOORD);
+  glVertexAttribPointer(OpenGL::Attribute::TEXCOORD, 2, GL_FLOAT, GL_FALSE,
+                        0, coord);
+
+  glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+  glDisableVertexAttribArray(OpenGL::Attribute::TEXCOORD);
+  OpenGL::solid_shader->Use();
+
+  FBO::BindFramebuffer(FBO::FRAMEBUFFER, old_frame_buffer);
+  glViewport(old_viewport[0], old_viewport[1],
+             old_viewport[2], old_viewport[3]);
+
+  if (scissor)
+    glEnable(GL_SCISSOR_TEST);
+
+  image_dirty = false;
+}
+
+GLTexture &
+GLTerrainImage::BindAndGetTexture()
+{
+  assert(width > 0);
+  assert(height > 0);
+
+  if (heights_dirty) {
+    UploadHeights();
+    heights_dirty = false;
+  }
+
+  if (colors_dirty) {
+    UploadColors();
+    colors_dirty = false;
+  }
+
+  if (image_dirty)
+    Render();
+
+  image->Bind();
+  return *image;
+}
+
+void
+GLTerrainImage::SurfaceCreated()
+{
+  /* the textures will be recreated by BindAndGetTexture() */
+}
+
+void
+GLTerrainImage::SurfaceDestroyed()
+{
+  delete frame_buffer;
+  frame_buffer = nullptr;
+
+  delete image;
+  image = nullptr;
+
+  delete color_texture;
+  color_texture = nullptr;
+
+  delete height_texture;
+  height_texture = nullptr;
+
+  colors_dirty = true;
+  heights_dirty = image_dirty = width > 0;
+}
+
+#endif
@@ -0,0 +1,122 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+#ifndef XCSOAR_TERRAIN_GL_TERRAIN_IMAGE_HPP
+#define XCSOAR_TERRAIN_GL_TERRAIN_IMAGE_HPP
+
+#include "Screen/OpenGL/Surface.hpp"
+#include "Screen/OpenGL/System.hpp"
+#include "Util/AllocatedArray.hpp"
+#include "Util/NonCopyable.hpp"
+#include "Compiler.h"
+
+#include <stdint.h>
+
+struct BGRColor;
+class HeightMatrix;
+class GLTexture;
+class GLFrameBuffer;
+
+/**
+ * Generates the terrain image from a #HeightMatrix on the GPU.  The
+ * heights are uploaded into a texture, and
+ * #OpenGL::terrain_shader renders the colours, contours and slope
+ * shading (just like RasterRenderer::GenerateSlopeImage()) into a
+ * texture which has the size of the #HeightMatrix.
+ *
+ * Rendering is deferred until BindAndGetTexture() is called; this
+ * also restores the image after the OpenGL surface was lost.
+ */
+class GLTerrainImage final : private GLSurfaceListener, private NonCopyable {
+  /**
+   * The colour lookup table (256 heights by 128 illumination
+   * levels), owned by #RasterRenderer.
+   */
+  const BGRColor *const color_table;
+
+  /**
+   * Two bytes per height (luminance = low byte, alpha = high byte)
+   * with the sign bit flipped, ready to be uploaded.
+   */
+  AllocatedArray<uint8_t> heights;
+  unsigned width, height;
+
+  GLTexture *height_texture, *color_texture, *image;
+  GLFrameBuffer *frame_buffer;
+
+  struct Parameters {
+    unsigned height_scale, contour_height_scale;
+    unsigned quantisation, slope_factor;
+    int sx, sy, sz, contrast;
+  } parameters;
+
+  bool heights_dirty, colors_dirty, image_dirty;
+
+public:
+  explicit GLTerrainImage(const BGRColor *_color_table);
+  ~GLTerrainImage();
+
+  /**
+   * Can this class be used with the current OpenGL driver?
+   */
+  gcc_pure
+  static bool IsAvailable();
+
+  /**
+   * The colour table has been modified.
+   */
+  void InvalidateColors() {
+    colors_dirty = image_dirty = true;
+  }
+
+  /**
+   * Copy the new #HeightMatrix contents.
+   */
+  void SetHeights(const HeightMatrix &matrix);
+
+  /**
+   * Schedule rendering with the given parameters.
+   *
+   * @param quantisation the slope step size in height matrix
+   * pixels; 0 disables slope shading
+   */
+  void Generate(unsigned height_scale, unsigned contour_height_scale,
+                unsigned quantisation, unsigned slope_factor,
+                int sx, int sy, int sz, int contrast);
+
+  /**
+   * Render the image if needed and bind it.  The image starts at
+   * texture coordinate (0,0) and has the size of the #HeightMatrix.
+   */
+  GLTexture &BindAndGetTexture();
+
+private:
+  void UploadHeights();
+  void UploadColors();
+  void Render();
+
+  /* virtual methods from class GLSurfaceListener */
+  void SurfaceCreated() override;
+  void SurfaceDestroyed() override;
+};
+
+#endif
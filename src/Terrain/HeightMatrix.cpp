@@ -28,6 +28,7 @@ Copyright_License {
 #include "Geo/GeoBounds.hpp"
 #else
 #include "Projection/WindowProjection.hpp"
+#include "Thread/ThreadPool.hpp"
 #endif
 
 #include <assert.h>
@@ -79,7 +80,8 @@ HeightMatrix::Fill(const RasterMap &map, const GeoBounds &bounds,
 
 void
 HeightMatrix::Fill(const RasterMap &map, const WindowProjection &projection,
-                   unsigned quantisation_pixels, bool interpolate)
+                   unsigned quantisation_pixels, bool interpolate,
+                   ThreadPool *pool)
 {
   const unsigned screen_width = projection.GetScreenWidth();
   const unsigned screen_height = projection.GetScreenHeight();
@@ -87,13 +89,27 @@ HeightMatrix::Fill(const RasterMap &map, const WindowProjection &projection,
   SetSize((screen_width + quantisation_pixels - 1) / quantisation_pixels,
           (screen_height + quantisation_pixels - 1) / quantisation_pixels);
 
-  short *p = data.begin();
-  for (unsigned y = 0; y < screen_height;
-       y += quantisation_pixels, p += width) {
-    map.ScanLine(projection.ScreenToGeo(0, y),
-                 projection.ScreenToGeo(screen_width, y),
-                 p, width, interpolate);
+  const auto fill_rows = [&](unsigned start_row, unsigned end_row){
+    short *p = data.begin() + start_row * width;
+    for (unsigned row = start_row; row < end_row; ++row, p += width) {
+      const unsigned y = row * quantisation_pixels;
+      map.ScanLine(projection.ScreenToGeo(0, y),
+                   projection.ScreenToGeo(screen_width, y),
+                   p, width, interpolate);
+    }
+  };
+
+  if (pool == nullptr) {
+    fill_rows(0, height);
+    return;
   }
+
+  /* the cost of a row depends on the terrain tiles it crosses; use
+     more bands than threads to balance the load */
+  const unsigned n_tiles = pool->GetConcurrency() * 4;
+  pool->ForEach(n_tiles, [&](unsigned i){
+      fill_rows(height * i / n_tiles, height * (i + 1) / n_tiles);
+    });
 }
 
 #endif
@@ -34,6 +34,7 @@ class RasterMap;
 class GeoBounds;
 #else
 class WindowProjection;
+class ThreadPool;
 #endif
 
 class HeightMatrix : private NonCopyable {
@@ -58,9 +59,12 @@ public:
 #else
   /**
    * @param interpolate true enables interpolation of sub-pixel values
+   * @param pool if not nullptr, then the rows are scanned
+   * concurrently by the threads of this pool
    */
   void Fill(const RasterMap &map, const WindowProjection &map_projection,
-            unsigned quantisation_pixels, bool interpolate);
+            unsigned quantisation_pixels, bool interpolate,
+            ThreadPool *pool=nullptr);
 #endif
 
   unsigned GetWidth() const {
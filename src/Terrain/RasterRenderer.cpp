@@ -32,6 +32,10 @@ Copyright_License {
 #include "Asset.hpp"
 #include "Event/Idle.hpp"
 
+#ifdef USE_GLSL
+#include "GLTerrainImage.hpp"
+#endif
+
 #include <assert.h>
 #include <stdint.h>
 
@@ -97,7 +101,13 @@ RasterRenderer::RasterRenderer()
    bounds(GeoBounds::Invalid()),
 #endif
    image(NULL),
+#ifdef USE_GLSL
+   gpu_image(nullptr), heights_dirty(true),
+#endif
    contour_column_base(NULL)
+#ifndef ENABLE_OPENGL
+  , thread_pool(ThreadPool::GetDefaultThreads())
+#endif
 {
   // scale quantisation_pixels so resolution is not too high on old hardware
   // with large displays
@@ -109,6 +119,9 @@ RasterRenderer::RasterRenderer()
 RasterRenderer::~RasterRenderer()
 {
   delete image;
+#ifdef USE_GLSL
+  delete gpu_image;
+#endif
   delete[] contour_column_base;
 }
 
@@ -137,6 +150,18 @@ RasterRenderer::UpdateQuantisation()
   return quantisation_pixels < last_quantisation_pixels;
 }
 
+#ifdef USE_GLSL
+
+const GLTexture &
+RasterRenderer::BindAndGetTexture() const
+{
+  return gpu_image != nullptr
+    ? gpu_image->BindAndGetTexture()
+    : image->BindAndGetTexture();
+}
+
+#endif
+
 #endif
 
 void
@@ -184,11 +209,43 @@ RasterRenderer::ScanMap(const RasterMap &map, const WindowProjection &projection
                      true);
 
   last_quantisation_pixels = quantisation_pixels;
+
+#ifdef USE_GLSL
+  heights_dirty = true;
+#endif
 #else
-  height_matrix.Fill(map, projection, quantisation_pixels, true);
+  height_matrix.Fill(map, projection, quantisation_pixels, true,
+                     &thread_pool);
 #endif
 }
 
+/**
+ * Calculate the light vector for slope shading.
+ */
+static void
+CalculateSunVector(int brightness, const Angle sunazimuth,
+                   int &sx, int &sy, int &sz)
+{
+  const Angle fudgeelevation = Angle::Degrees(10) +
+    Angle::Degrees(80.0 / 255.0) * brightness;
+
+  sx = (int)(255 * fudgeelevation.fastcosine() * -sunazimuth.fastsine());
+  sy = (int)(255 * fudgeelevation.fastcosine() * -sunazimuth.fastcosine());
+  sz = (int)(255 * fudgeelevation.fastsine());
+}
+
+unsigned
+RasterRenderer::GetHeightSlopeFactor() const
+{
+  assert(quantisation_effective > 0);
+
+  return Clamp((unsigned)pixel_size, 1u,
+               /* this upper limit avoids integer overflows in the
+                  "mag" formula; it effectively limits "dd2" so
+                  calculating its square will not overflow */
+               8192u / (quantisation_effective * quantisation_effective));
+}
+
 void
 RasterRenderer::GenerateImage(bool do_shading,
                               unsigned height_scale,
@@ -196,6 +253,42 @@ RasterRenderer::GenerateImage(bool do_shading,
                               const Angle sunazimuth,
                               bool do_contour)
 {
+#ifdef USE_GLSL
+  if (gpu_image == nullptr && image == nullptr &&
+      GLTerrainImage::IsAvailable())
+    gpu_image = new GLTerrainImage(color_table);
+
+  if (gpu_image != nullptr) {
+    if (heights_dirty) {
+      gpu_image->SetHeights(height_matrix);
+      heights_dirty = false;
+    }
+
+    if (quantisation_effective == 0) {
+      do_shading = false;
+      do_contour = false;
+    }
+
+    int sx = 0, sy = 0, sz = 0;
+    if (do_shading)
+      CalculateSunVector(brightness, sunazimuth, sx, sy, sz);
+
+    gpu_image->Generate(height_scale, do_contour ? height_scale * 2 : 16,
+                        do_shading ? quantisation_effective : 0,
+                        do_shading ? GetHeightSlopeFactor() : 1,
+                        sx, sy, sz, contrast);
+    return;
+  }
+#endif
+
+#ifdef ENABLE_OPENGL
+  const unsigned n_tiles = 1;
+#else
+  /* one horizontal band per CPU core; each band needs its own
+     contour state */
+  const unsigned n_tiles = thread_pool.GetConcurrency();
+#endif
+
   if (image == NULL ||
       height_matrix.GetWidth() > image->GetWidth() ||
       height_matrix.GetHeight() > image->GetHeight()) {
@@ -203,7 +296,7 @@ RasterRenderer::GenerateImage(bool do_shading,
     image = new RawBitmap(height_matrix.GetWidth(), height_matrix.GetHeight());
 
     delete[] contour_column_base;
-    contour_column_base = new unsigned char[height_matrix.GetWidth()];
+    contour_column_base = new unsigned char[image->GetWidth() * n_tiles];
   }
 
   if (quantisation_effective == 0) {
@@ -213,31 +306,52 @@ RasterRenderer::GenerateImage(bool do_shading,
 
   const unsigned contour_height_scale = do_contour? height_scale * 2 : 16;
 
-  ContourStart(contour_height_scale);
-
+  int sx = 0, sy = 0, sz = 0;
   if (do_shading)
-    GenerateSlopeImage(height_scale, contrast, brightness,
-                       sunazimuth, contour_height_scale);
-  else
-    GenerateUnshadedImage(height_scale, contour_height_scale);
+    CalculateSunVector(brightness, sunazimuth, sx, sy, sz);
+
+  const unsigned height = height_matrix.GetHeight();
+  const auto generate_tile = [&](unsigned i){
+    const unsigned start_y = height * i / n_tiles;
+    const unsigned end_y = height * (i + 1) / n_tiles;
+    unsigned char *column_base = contour_column_base + image->GetWidth() * i;
+
+    ContourStart(start_y, column_base, contour_height_scale);
+
+    if (do_shading)
+      GenerateSlopeImage(height_scale, contrast, sx, sy, sz,
+                         contour_height_scale,
+                         start_y, end_y, column_base);
+    else
+      GenerateUnshadedImage(height_scale, contour_height_scale,
+                            start_y, end_y, column_base);
+  };
+
+#ifdef ENABLE_OPENGL
+  generate_tile(0);
+#else
+  thread_pool.ForEach(n_tiles, generate_tile);
+#endif
 
   image->SetDirty();
 }
 
 void
 RasterRenderer::GenerateUnshadedImage(unsigned height_scale,
-                                      const unsigned contour_height_scale)
+                                      const unsigned contour_height_scale,
+                                      unsigned start_y, unsigned end_y,
+                                      unsigned char *column_base)
 {
-  const short *src = height_matrix.GetData();
+  const short *src = height_matrix.GetRow(start_y);
   const BGRColor *oColorBuf = color_table + 64 * 256;
-  BGRColor *dest = image->GetTopRow();
+  BGRColor *dest = image->GetRow(start_y);
 
-  for (unsigned y = height_matrix.GetHeight(); y > 0; --y) {
+  for (unsigned y = start_y; y < end_y; ++y) {
     BGRColor *p = dest;
     dest = image->GetNextRow(dest);
 
     unsigned contour_row_base = ContourInterval(*src, contour_height_scale);
-    unsigned char *contour_this_column_base = contour_column_base;
+    unsigned char *contour_this_column_base = column_base;
 
     for (unsigned x = height_matrix.GetWidth(); x > 0; --x) {
       int h = *src++;
@@ -292,7 +406,9 @@ void
 RasterRenderer::GenerateSlopeImage(unsigned height_scale,
                                    int contrast,
                                    const int sx, const int sy, const int sz,
-                                   const unsigned contour_height_scale)
+                                   const unsigned contour_height_scale,
+                                   unsigned start_y, unsigned end_y,
+                                   unsigned char *column_base)
 {
   assert(quantisation_effective > 0);
 
@@ -302,19 +418,14 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
   border.right = height_matrix.GetWidth() - quantisation_effective;
   border.bottom = height_matrix.GetHeight() - quantisation_effective;
 
-  const unsigned height_slope_factor =
-    Clamp((unsigned)pixel_size, 1u,
-          /* this upper limit avoids integer overflows in the "mag"
-             formula; it effectively limits "dd2" so calculating its
-             square will not overflow */
-          8192u / (quantisation_effective * quantisation_effective));
+  const unsigned height_slope_factor = GetHeightSlopeFactor();
 
-  const short *src = height_matrix.GetData();
+  const short *src = height_matrix.GetRow(start_y);
   const BGRColor *oColorBuf = color_table + 64 * 256;
 
-  BGRColor *dest = image->GetTopRow();
+  BGRColor *dest = image->GetRow(start_y);
 
-  for (unsigned y = 0; y < height_matrix.GetHeight(); ++y) {
+  for (unsigned y = start_y; y < end_y; ++y) {
     const unsigned row_plus_index = y < (unsigned)border.bottom
       ? quantisation_effective
       : height_matrix.GetHeight() - 1 - y;
@@ -330,7 +441,7 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
     dest = image->GetNextRow(dest);
 
     unsigned contour_row_base = ContourInterval(*src, contour_height_scale);
-    unsigned char *contour_this_column_base = contour_column_base;
+    unsigned char *contour_this_column_base = column_base;
 
     for (unsigned x = 0; x < height_matrix.GetWidth(); ++x, ++src) {
       int h = *src;
@@ -424,23 +535,6 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
   }
 }
 
-void
-RasterRenderer::GenerateSlopeImage(unsigned height_scale,
-                                   int contrast, int brightness,
-                                   const Angle sunazimuth,
-                                   const unsigned contour_height_scale)
-{
-  const Angle fudgeelevation = Angle::Degrees(10) +
-    Angle::Degrees(80.0 / 255.0) * brightness;
-
-  const int sx = (int)(255 * fudgeelevation.fastcosine() * -sunazimuth.fastsine());
-  const int sy = (int)(255 * fudgeelevation.fastcosine() * -sunazimuth.fastcosine());
-  const int sz = (int)(255 * fudgeelevation.fastsine());
-
-  GenerateSlopeImage(height_scale, contrast,
-                     sx, sy, sz, contour_height_scale);
-}
-
 void
 RasterRenderer::PrepareColorTable(const ColorRamp *color_ramp, bool do_water,
                                   unsigned height_scale, int interp_levels)
@@ -470,14 +564,23 @@ RasterRenderer::PrepareColorTable(const ColorRamp *color_ramp, bool do_water,
       color_table[i + (mag + 64) * 256] = color;
     }
   }
+
+#ifdef USE_GLSL
+  if (gpu_image != nullptr)
+    gpu_image->InvalidateColors();
+#endif
 }
 
 void
-RasterRenderer::ContourStart(const unsigned contour_height_scale)
+RasterRenderer::ContourStart(unsigned start_y, unsigned char *column_base,
+                             const unsigned contour_height_scale)
 {
-  // initialise column to first row
-  const short *src = height_matrix.GetData();
-  unsigned char *col_base = contour_column_base;
+  /* initialise column to the row above the first one (or to the
+     first row at the top of the image); this approximates the state
+     of a single pass over the whole image, apart from pixels below
+     water or outside the terrain */
+  const short *src = height_matrix.GetRow(start_y > 0 ? start_y - 1 : 0);
+  unsigned char *col_base = column_base;
   for (unsigned x = height_matrix.GetWidth(); x > 0; --x)
     *col_base++ = ContourInterval(*src++, contour_height_scale);
 }
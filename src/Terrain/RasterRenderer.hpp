@@ -31,12 +31,15 @@ Copyright_License {
 
 #ifdef ENABLE_OPENGL
 #include "Geo/GeoBounds.hpp"
+#else
+#include "Thread/ThreadPool.hpp"
 #endif
 
 #define NUM_COLOR_RAMP_LEVELS 13
 
 class Angle;
 class Canvas;
+class GLTerrainImage;
 class RasterMap;
 class WindowProjection;
 struct ColorRamp;
@@ -71,8 +74,33 @@ class RasterRenderer : private NonCopyable {
   HeightMatrix height_matrix;
   RawBitmap *image;
 
+#ifdef USE_GLSL
+  /**
+   * Renders the image on the GPU.  This is nullptr if the OpenGL
+   * driver cannot do it; #image is used then.
+   */
+  GLTerrainImage *gpu_image;
+
+  /**
+   * Has #height_matrix been modified since it was passed to
+   * #gpu_image?
+   */
+  bool heights_dirty;
+#endif
+
+  /**
+   * One row of contour state for each tile of GenerateImage().
+   */
   unsigned char *contour_column_base;
 
+#ifndef ENABLE_OPENGL
+  /**
+   * Scans the map and generates the image in horizontal bands on all
+   * CPU cores.
+   */
+  ThreadPool thread_pool;
+#endif
+
   fixed pixel_size;
 
   BGRColor color_table[256 * 128];
@@ -110,9 +138,13 @@ public:
     return bounds;
   }
 
+#ifdef USE_GLSL
+  const GLTexture &BindAndGetTexture() const;
+#else
   const GLTexture &BindAndGetTexture() const {
     return image->BindAndGetTexture();
   }
+#endif
 #endif
 
   /**
@@ -129,7 +161,9 @@ public:
   void ScanMap(const RasterMap &map, const WindowProjection &projection);
 
   /**
-   * Convert the height matrix into the image.
+   * Convert the height matrix into the image.  This may be called
+   * again without ScanMap(), e.g. when only the sun azimuth has
+   * changed.
    */
   void GenerateImage(bool do_shading,
                      unsigned height_scale, int contrast, int brightness,
@@ -142,29 +176,34 @@ public:
 
 protected:
   /**
-   * Convert the height matrix into the image, without shading.
+   * Returns the vertical exaggeration for the slope calculation.
    */
-  void GenerateUnshadedImage(unsigned height_scale,
-                             const unsigned contour_height_scale);
+  gcc_pure
+  unsigned GetHeightSlopeFactor() const;
 
   /**
-   * Convert the height matrix into the image, with slope shading.
+   * Convert the given rows of the height matrix into the image,
+   * without shading.
    */
-  void GenerateSlopeImage(unsigned height_scale, int contrast,
-                          const int sx, const int sy, const int sz,
-                          const unsigned contour_height_scale);
+  void GenerateUnshadedImage(unsigned height_scale,
+                             const unsigned contour_height_scale,
+                             unsigned start_y, unsigned end_y,
+                             unsigned char *column_base);
 
   /**
-   * Convert the height matrix into the image, with slope shading.
+   * Convert the given rows of the height matrix into the image, with
+   * slope shading.
    */
-  void GenerateSlopeImage(unsigned height_scale,
-                          int contrast, int brightness,
-                          const Angle sunazimuth,
-                          const unsigned contour_height_scale);
+  void GenerateSlopeImage(unsigned height_scale, int contrast,
+                          const int sx, const int sy, const int sz,
+                          const unsigned contour_height_scale,
+                          unsigned start_y, unsigned end_y,
+                          unsigned char *column_base);
 
 private:
 
-  void ContourStart(const unsigned contour_height_scale);
+  void ContourStart(unsigned start_y, unsigned char *column_base,
+                    const unsigned contour_height_scale);
 };
 
 #endif
@@ -359,11 +359,14 @@ TerrainRenderer::Generate(const WindowProjection &map_projection,
   const GeoBounds &new_bounds = map_projection.GetScreenBounds();
   assert(new_bounds.IsValid());
 
-  if (old_bounds.IsValid() && old_bounds.IsInside(new_bounds) &&
-      !IsLargeSizeDifference(old_bounds, new_bounds) &&
-      terrain_serial == terrain.GetSerial() &&
-      sunazimuth.CompareRoughly(last_sun_azimuth) &&
-      !raster_renderer.UpdateQuantisation())
+  /* can the height matrix be reused? */
+  const bool same_area = old_bounds.IsValid() &&
+    old_bounds.IsInside(new_bounds) &&
+    !IsLargeSizeDifference(old_bounds, new_bounds) &&
+    terrain_serial == terrain.GetSerial() &&
+    !raster_renderer.UpdateQuantisation();
+
+  if (same_area && sunazimuth.CompareRoughly(last_sun_azimuth))
     /* no change since previous frame */
     return;
 
@@ -397,6 +400,11 @@ TerrainRenderer::Generate(const WindowProjection &map_projection,
     last_color_ramp = color_ramp;
   }
 
+#ifdef ENABLE_OPENGL
+  /* only the sun has moved: the slope shading needs to be redone,
+     but the terrain doesn't need to be scanned again */
+  if (!same_area)
+#endif
   {
     RasterTerrain::Lease map(terrain);
     raster_renderer.ScanMap(map, map_projection);
@@ -24,6 +24,7 @@ Copyright_License {
 #include "Thread/Thread.hpp"
 #include "Name.hpp"
 #include "Util.hpp"
+#include "Tracing.hpp"
 
 #ifdef ANDROID
 #include "Java/Global.hxx"
@@ -152,8 +153,10 @@ Thread::ThreadProc(void *p)
   thread->defined = true;
 #endif
 
-  if (thread->name != nullptr)
+  if (thread->name != nullptr) {
     SetThreadName(thread->name);
+    Tracing::SetThreadName(thread->name);
+  }
 
   thread->Run();
 
@@ -171,6 +174,9 @@ Thread::ThreadProc(LPVOID lpParameter)
 {
   Thread *thread = (Thread *)lpParameter;
 
+  if (thread->name != nullptr)
+    Tracing::SetThreadName(thread->name);
+
   thread->Run();
   return 0;
 }
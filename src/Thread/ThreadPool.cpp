@@ -0,0 +1,108 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+#ifdef HAVE_POSIX
+#include <unistd.h>
+#endif
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+void
+ThreadPool::Worker::Tick()
+{
+  mutex.Unlock();
+  pool.Work();
+  mutex.Lock();
+}
+
+ThreadPool::ThreadPool(unsigned n_threads)
+{
+  if (n_threads > MAX_THREADS)
+    n_threads = MAX_THREADS;
+
+  for (unsigned i = 0; i < n_threads; ++i)
+    workers.append(new Worker(*this));
+}
+
+ThreadPool::~ThreadPool()
+{
+  for (auto *worker : workers) {
+    worker->LockStop();
+    delete worker;
+  }
+}
+
+unsigned
+ThreadPool::GetDefaultThreads()
+{
+#if defined(HAVE_POSIX) && defined(_SC_NPROCESSORS_ONLN)
+  const long n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+#elif defined(WIN32) && !defined(_WIN32_WCE)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  const long n_cpus = info.dwNumberOfProcessors;
+#else
+  const long n_cpus = 1;
+#endif
+
+  return n_cpus > 1
+    ? std::min(unsigned(n_cpus - 1), unsigned(MAX_THREADS))
+    : 0;
+}
+
+inline void
+ThreadPool::Work()
+{
+  unsigned i;
+  while ((i = next.fetch_add(1)) < n)
+    (*function)(i);
+}
+
+void
+ThreadPool::ForEach(unsigned _n, const std::function<void(unsigned)> &f)
+{
+  if (workers.empty() || _n <= 1) {
+    for (unsigned i = 0; i < _n; ++i)
+      f(i);
+    return;
+  }
+
+  function = &f;
+  n = _n;
+  next = 0;
+
+  const unsigned n_workers = std::min(_n - 1, workers.size());
+  for (unsigned i = 0; i < n_workers; ++i)
+    workers[i]->LockTrigger();
+
+  Work();
+
+  for (unsigned i = 0; i < n_workers; ++i)
+    workers[i]->LockWaitDone();
+}
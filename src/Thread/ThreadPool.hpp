@@ -0,0 +1,114 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_POOL_HPP
+#define XCSOAR_THREAD_POOL_HPP
+
+#include "Thread/StandbyThread.hpp"
+#include "Util/StaticArray.hpp"
+#include "Util/NonCopyable.hpp"
+
+#include <functional>
+#include <atomic>
+
+/**
+ * A small set of threads which run the iterations of a loop
+ * concurrently, e.g. to render the tiles of an image on all CPU
+ * cores.  The calling thread takes part in the work, so a pool
+ * without threads just runs the loop.
+ *
+ * This class is not thread-safe; only one thread may call
+ * ForEach() at a time.
+ */
+class ThreadPool : private NonCopyable {
+  static constexpr unsigned MAX_THREADS = 3;
+
+  class Worker final : private StandbyThread {
+    ThreadPool &pool;
+
+  public:
+    explicit Worker(ThreadPool &_pool)
+      :StandbyThread("Pool"), pool(_pool) {}
+
+    using StandbyThread::LockTrigger;
+    using StandbyThread::LockWaitDone;
+    using StandbyThread::LockStop;
+
+  private:
+    /* virtual methods from class StandbyThread*/
+    void Tick() override;
+  };
+
+  StaticArray<Worker *, MAX_THREADS> workers;
+
+  /**
+   * The job of the current ForEach() call.
+   */
+  const std::function<void(unsigned)> *function;
+
+  /**
+   * The number of iterations of the current ForEach() call.
+   */
+  unsigned n;
+
+  /**
+   * The next iteration which has not been started yet.
+   */
+  std::atomic<unsigned> next;
+
+public:
+  /**
+   * @param n_threads the number of threads to be launched in
+   * addition to the calling thread; will be clipped to a sane limit
+   */
+  explicit ThreadPool(unsigned n_threads);
+
+  ~ThreadPool();
+
+  /**
+   * Determine the number of additional threads which makes use of
+   * all CPU cores.  Returns 0 on single-core machines.
+   */
+  gcc_pure
+  static unsigned GetDefaultThreads();
+
+  /**
+   * The maximum number of iterations which run at the same time.
+   * Callers may use this to decide how to split their work.
+   */
+  unsigned GetConcurrency() const {
+    return workers.size() + 1;
+  }
+
+  /**
+   * Call the function for each value in the range [0, n), and
+   * return after all of them have finished.  The calls may run in
+   * any order and concurrently.
+   */
+  void ForEach(unsigned n, const std::function<void(unsigned)> &f);
+
+private:
+  void Work();
+};
+
+#endif
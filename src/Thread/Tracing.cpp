@@ -0,0 +1,185 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Tracing.hpp"
+#include "Local.hpp"
+#include "Mutex.hpp"
+
+#include <algorithm>
+#include <list>
+
+namespace Tracing {
+  /**
+   * A single-producer ring buffer.  Only the owning thread writes;
+   * Collect() may read concurrently.  Like a seqlock, the writer
+   * announces each slot in #started before it stores the event, and
+   * Collect() uses that counter to discard events which may have
+   * been overwritten (or were being overwritten) while copying.
+   */
+  struct Ring {
+    unsigned id;
+    const char *name;
+
+    /**
+     * The number of events ever written.
+     */
+    std::atomic<unsigned> head;
+
+    /**
+     * The number of events whose write has begun.  This is either
+     * equal to #head or one more while Record() is storing an event.
+     */
+    std::atomic<unsigned> started;
+
+    /**
+     * The value of #head at the last Clear() call.
+     */
+    std::atomic<unsigned> cleared;
+
+    Event events[RING_SIZE];
+
+    Ring(unsigned _id, const char *_name)
+      :id(_id), name(_name), head(0), started(0), cleared(0) {}
+  };
+
+  std::atomic<bool> enabled(false);
+
+  static Mutex mutex;
+
+  /**
+   * All ring buffers, protected by #mutex.  They are never freed,
+   * because Collect() shall see events of threads which have
+   * already exited.
+   */
+  static std::list<Ring> rings;
+
+  static ThreadLocalObject<Ring *> thread_ring;
+  static ThreadLocalObject<const char *> thread_name;
+
+  /**
+   * Set when #MAX_THREADS has been reached, to avoid locking #mutex
+   * again and again.
+   */
+  static std::atomic<bool> full(false);
+
+  static Ring *
+  GetThreadRing()
+  {
+    Ring *ring = thread_ring;
+    if (ring != nullptr || full.load(std::memory_order_relaxed))
+      return ring;
+
+    const char *name = thread_name;
+    if (name == nullptr)
+      name = "main";
+
+    const ScopeLock protect(mutex);
+    if (rings.size() >= MAX_THREADS) {
+      full.store(true, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    rings.emplace_back(rings.size() + 1, name);
+    ring = &rings.back();
+    thread_ring = ring;
+    return ring;
+  }
+}
+
+void
+Tracing::Enable(bool value)
+{
+  enabled.store(value, std::memory_order_relaxed);
+}
+
+void
+Tracing::SetThreadName(const char *name)
+{
+  thread_name = name;
+}
+
+void
+Tracing::Record(const char *name, uint64_t start_us, uint64_t end_us)
+{
+  Ring *ring = GetThreadRing();
+  if (ring == nullptr)
+    return;
+
+  const unsigned i = ring->head.load(std::memory_order_relaxed);
+  ring->started.store(i + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  Event &event = ring->events[i % RING_SIZE];
+  event.name = name;
+  event.start_us = start_us;
+  event.duration_us = unsigned(std::min<uint64_t>(end_us - start_us,
+                                                  0xffffffff));
+  ring->head.store(i + 1, std::memory_order_release);
+}
+
+void
+Tracing::Clear()
+{
+  const ScopeLock protect(mutex);
+  for (Ring &ring : rings)
+    ring.cleared.store(ring.head.load(std::memory_order_acquire),
+                       std::memory_order_relaxed);
+}
+
+std::vector<Tracing::ThreadEvents>
+Tracing::Collect()
+{
+  std::vector<ThreadEvents> result;
+
+  const ScopeLock protect(mutex);
+  result.reserve(rings.size());
+
+  for (const Ring &ring : rings) {
+    result.emplace_back();
+    ThreadEvents &te = result.back();
+    te.id = ring.id;
+    te.name = ring.name;
+
+    const unsigned head = ring.head.load(std::memory_order_acquire);
+    unsigned n = std::min(head - ring.cleared.load(std::memory_order_relaxed),
+                          RING_SIZE);
+
+    te.events.reserve(n);
+    for (unsigned i = head - n; i != head; ++i)
+      te.events.push_back(ring.events[i % RING_SIZE]);
+
+    /* drop the events which the writer has overwritten (or was
+       overwriting) while we were copying; the oldest ones are reused
+       first */
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const unsigned started = ring.started.load(std::memory_order_relaxed);
+    const unsigned reused = started - head;
+    const unsigned unused = RING_SIZE - n;
+    const unsigned overwritten = reused > unused
+      ? std::min(reused - unused, n)
+      : 0;
+    te.events.erase(te.events.begin(), te.events.begin() + overwritten);
+  }
+
+  return result;
+}
@@ -0,0 +1,136 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_TRACING_HPP
+#define XCSOAR_THREAD_TRACING_HPP
+
+#include "OS/Clock.hpp"
+
+#include <atomic>
+#include <vector>
+
+#include <stdint.h>
+
+/**
+ * A lightweight facility which records the duration of code
+ * sections.  Each thread writes into its own fixed-size ring buffer,
+ * which is allocated on the first event.  While tracing is disabled,
+ * a #ScopeTrace costs only one relaxed atomic load.
+ */
+namespace Tracing {
+  /**
+   * The number of events kept per thread; older ones are
+   * overwritten.
+   */
+  static constexpr unsigned RING_SIZE = 4096;
+
+  /**
+   * The maximum number of threads which get a ring buffer.  Events
+   * from additional threads are discarded.
+   */
+  static constexpr unsigned MAX_THREADS = 32;
+
+  struct Event {
+    /**
+     * A string literal describing the event.
+     */
+    const char *name;
+
+    /**
+     * See MonotonicClockUS().
+     */
+    uint64_t start_us;
+
+    unsigned duration_us;
+  };
+
+  struct ThreadEvents {
+    unsigned id;
+
+    const char *name;
+
+    /**
+     * The recorded events, oldest first.
+     */
+    std::vector<Event> events;
+  };
+
+  extern std::atomic<bool> enabled;
+
+  static inline bool IsEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  void Enable(bool value);
+
+  /**
+   * Set the name of the current thread, which is used when its
+   * ring buffer is created.  This is called automatically by
+   * #Thread.
+   *
+   * @param name a string which must remain valid forever
+   */
+  void SetThreadName(const char *name);
+
+  /**
+   * Record an event in the current thread's ring buffer.
+   */
+  void Record(const char *name, uint64_t start_us, uint64_t end_us);
+
+  /**
+   * Discard all events recorded so far.
+   */
+  void Clear();
+
+  /**
+   * Copy the events of all threads.  Events which are overwritten
+   * while copying are omitted.
+   */
+  std::vector<ThreadEvents> Collect();
+}
+
+/**
+ * Records the lifetime of this object as an event.
+ */
+class ScopeTrace {
+  const char *name;
+  uint64_t start;
+
+public:
+  /**
+   * @param _name a string literal describing the code section
+   */
+  explicit ScopeTrace(const char *_name)
+    :name(_name),
+     start(Tracing::IsEnabled() ? MonotonicClockUS() : 0) {}
+
+  ~ScopeTrace() {
+    if (start != 0)
+      Tracing::Record(name, start, MonotonicClockUS());
+  }
+
+  ScopeTrace(const ScopeTrace &) = delete;
+  ScopeTrace &operator=(const ScopeTrace &) = delete;
+};
+
+#endif
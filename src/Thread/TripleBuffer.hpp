@@ -0,0 +1,140 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_TRIPLE_BUFFER_HPP
+#define XCSOAR_THREAD_TRIPLE_BUFFER_HPP
+
+#include <atomic>
+
+/**
+ * Hands off snapshots of a value from one producer thread to one
+ * consumer thread without a mutex.
+ *
+ * The producer fills Back() and calls Publish(); the consumer calls
+ * Update() and then reads Front().  The three slots are only
+ * exchanged by index, so neither side ever waits for the other, and
+ * the consumer's snapshot stays consistent until its next Update()
+ * call.
+ */
+template<typename T>
+class TripleBuffer {
+  static constexpr unsigned INDEX_MASK = 0x3;
+
+  /**
+   * Set in #middle when it holds a snapshot which the consumer has
+   * not seen yet.
+   */
+  static constexpr unsigned FRESH = 0x4;
+
+  T slots[3];
+
+  /**
+   * The slot which is currently owned by the producer.
+   */
+  unsigned back;
+
+  /**
+   * The slot which is exchanged between producer and consumer.
+   */
+  std::atomic<unsigned> middle;
+
+  /**
+   * The slot which is currently owned by the consumer.
+   */
+  unsigned front;
+
+public:
+  TripleBuffer():back(0), middle(1), front(2) {}
+
+  TripleBuffer(const TripleBuffer &) = delete;
+  TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+  /**
+   * Initialise all slots with the given value.  This is not
+   * thread-safe; it may only be called before the producer and the
+   * consumer start.
+   */
+  void Reset(const T &value) {
+    for (auto &i : slots)
+      i = value;
+
+    middle.store(middle.load(std::memory_order_relaxed) & INDEX_MASK,
+                 std::memory_order_relaxed);
+  }
+
+  /**
+   * Returns the slot to be filled by the producer.
+   */
+  T &Back() {
+    return slots[back];
+  }
+
+  /**
+   * Make the contents of Back() available to the consumer.  Snapshots
+   * which the consumer has not picked up yet are discarded.
+   */
+  void Publish() {
+    back = middle.exchange(back | FRESH, std::memory_order_acq_rel)
+      & INDEX_MASK;
+  }
+
+  /**
+   * Copy the value into Back() and publish it.
+   */
+  void Publish(const T &value) {
+    Back() = value;
+    Publish();
+  }
+
+  /**
+   * Has the producer published a snapshot which was not yet picked up
+   * by Update()?
+   */
+  bool IsFresh() const {
+    return (middle.load(std::memory_order_relaxed) & FRESH) != 0;
+  }
+
+  /**
+   * Pick up the latest published snapshot, if any.  Called by the
+   * consumer.
+   *
+   * @return true if Front() has changed
+   */
+  bool Update() {
+    if (!IsFresh())
+      return false;
+
+    front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+    return true;
+  }
+
+  /**
+   * Returns the consumer's snapshot.  It remains valid and unmodified
+   * until the next Update() call.
+   */
+  const T &Front() const {
+    return slots[front];
+  }
+};
+
+#endif
@@ -24,6 +24,7 @@ Copyright_License {
 #include "Thread.hpp"
 #include "TopographyStore.hpp"
 #include "Thread/Util.hpp"
+#include "Thread/Tracing.hpp"
 
 TopographyThread::TopographyThread(TopographyStore &_store,
                                    std::function<void()> &&_callback)
@@ -71,6 +72,8 @@ TopographyThread::Tick()
 
   bool again = true;
   while (next_projection.IsValid() && again && !IsStopped()) {
+    const ScopeTrace trace("TopographyThread::Tick");
+
     const WindowProjection projection = next_projection;
 
     mutex.Unlock();
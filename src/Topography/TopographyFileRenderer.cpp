@@ -267,6 +267,16 @@ TopographyFileRenderer::Paint(Canvas &canvas,
 #ifdef GL_EXT_multi_draw_arrays
   std::vector<GLsizei> polygon_counts;
   std::vector<GLshort> polygon_indices;
+
+  /* line strips are collected here and submitted with one
+     glMultiDrawArrays() / glMultiDrawElements() call each */
+  std::vector<GLint> line_firsts;
+  std::vector<GLsizei> line_counts;
+  std::vector<GLsizei> line_index_counts;
+  std::vector<GLushort> line_indices;
+
+  const bool multi_draw_lines = GLExt::HaveMultiDrawArrays() &&
+    GLExt::HaveMultiDrawElements();
 #endif
 #endif
 
@@ -307,17 +317,52 @@ TopographyFileRenderer::Paint(Canvas &canvas,
     case MS_SHAPE_LINE:
       {
 #ifdef ENABLE_OPENGL
-        vp.Update(GL_FLOAT, points);
-
         const GLushort *indices, *count;
         if (level == 0 ||
             (indices = shape.get_indices(level, min_distance, count)) == nullptr) {
+#ifdef GL_EXT_multi_draw_arrays
+          if (multi_draw_lines) {
+            /* postpone, the strips are drawn from the shared array
+               buffer after the loop */
+            GLint first = shape.GetOffset();
+            for (unsigned n : lines) {
+              line_firsts.push_back(first);
+              line_counts.push_back(n);
+              first += n;
+            }
+            break;
+          }
+#endif
+
+          vp.Update(GL_FLOAT, points);
+
           unsigned offset = 0;
           for (unsigned n : lines) {
             glDrawArrays(GL_LINE_STRIP, offset, n);
             offset += n;
           }
         } else {
+#ifdef GL_EXT_multi_draw_arrays
+          unsigned end = shape.GetOffset();
+          for (unsigned n : lines)
+            end += n;
+
+          if (multi_draw_lines && end <= 0x10000) {
+            const unsigned offset = shape.GetOffset();
+            for (unsigned n : ConstBuffer<GLushort>(count, lines.size)) {
+              line_index_counts.push_back(n);
+              const size_t size = line_indices.size();
+              line_indices.resize(size + n, offset);
+              for (unsigned i = 0; i < n; ++i)
+                line_indices[size + i] += indices[i];
+              indices += n;
+            }
+            break;
+          }
+#endif
+
+          vp.Update(GL_FLOAT, points);
+
           for (unsigned n : ConstBuffer<GLushort>(count, lines.size)) {
             glDrawElements(GL_LINE_STRIP, n, GL_UNSIGNED_SHORT, indices);
             indices += n;
@@ -404,6 +449,27 @@ TopographyFileRenderer::Paint(Canvas &canvas,
 #ifdef ENABLE_OPENGL
 
 #ifdef GL_EXT_multi_draw_arrays
+  if (!line_counts.empty()) {
+    vp.Update(GL_FLOAT, buffer);
+    GLExt::MultiDrawArrays(GL_LINE_STRIP, line_firsts.data(),
+                           line_counts.data(), line_counts.size());
+  }
+
+  if (!line_index_counts.empty()) {
+    std::vector<const GLushort *> line_pointers;
+    unsigned i = 0;
+    for (auto count : line_index_counts) {
+      line_pointers.push_back(line_indices.data() + i);
+      i += count;
+    }
+
+    vp.Update(GL_FLOAT, buffer);
+    GLExt::MultiDrawElements(GL_LINE_STRIP, line_index_counts.data(),
+                             GL_UNSIGNED_SHORT,
+                             (const GLvoid **)line_pointers.data(),
+                             line_index_counts.size());
+  }
+
   if (!polygon_indices.empty()) {
     assert(GLExt::HaveMultiDrawElements());
 
@@ -414,7 +480,7 @@ TopographyFileRenderer::Paint(Canvas &canvas,
       i += count;
     }
 
-    vp.Update(GL_FLOAT, nullptr);
+    vp.Update(GL_FLOAT, buffer);
 
     GLExt::MultiDrawElements(GL_TRIANGLE_STRIP, polygon_counts.data(),
                              GL_UNSIGNED_SHORT,
@@ -94,44 +94,38 @@ void WaypointList::SortByElevation() {
   std::sort(begin(), end(), WaypointElevationCompare());
 }
 
-class WaypointArrivalAltitudeCompare
-{
-  const MoreData &more_data;
-  const DerivedInfo &calculated;
-  const GeoPoint &location;
-  const ComputerSettings &settings;
-
-public:
-  WaypointArrivalAltitudeCompare(const GeoPoint &_location)
-  :more_data(CommonInterface::Basic()),
-   calculated(CommonInterface::Calculated()),
-   location(_location),
-   settings(CommonInterface::GetComputerSettings()) { }
-
-  fixed CalcAltitudeDifferential(const WaypointListItem &a) const
-  {
-    // altitude differential
-    const GlideState glide_state(
-      location.DistanceBearing(a.waypoint->location),
-      a.waypoint->elevation + settings.task.safety_height_arrival,
-      more_data.nav_altitude,
-      calculated.GetWindOrZero());
-
-    const GlideResult &result =
-      MacCready::Solve(settings.task.glide,
-                       settings.polar.glide_polar_task,
-                       glide_state);
-    return result.SelectAltitudeDifference(settings.task.glide);
-  }
-
-
-  bool operator()(const WaypointListItem &a,
-                  const WaypointListItem &b) const {
-
-    return CalcAltitudeDifferential(a) > CalcAltitudeDifferential(b);
-  }
-};
-
 void WaypointList::SortByArrivalAltitude(const GeoPoint &location) {
-  std::sort(begin(), end(), WaypointArrivalAltitudeCompare(location));
+  const MoreData &more_data = CommonInterface::Basic();
+  const DerivedInfo &calculated = CommonInterface::Calculated();
+  const ComputerSettings &settings = CommonInterface::GetComputerSettings();
+
+  /* solve each glide only once, not in every comparison */
+  std::vector<GlideState> tasks;
+  tasks.reserve(size());
+  for (const auto &i : *this)
+    tasks.emplace_back(location.DistanceBearing(i.waypoint->location),
+                       i.waypoint->elevation +
+                       settings.task.safety_height_arrival,
+                       more_data.nav_altitude,
+                       calculated.GetWindOrZero());
+
+  std::vector<GlideResult> results(tasks.size());
+  const MacCready mac_cready(settings.task.glide,
+                             settings.polar.glide_polar_task);
+  mac_cready.Solve(tasks.data(), results.data(), tasks.size());
+
+  std::vector<std::pair<fixed, WaypointListItem>> items;
+  items.reserve(size());
+  for (unsigned i = 0; i < size(); ++i)
+    items.emplace_back(results[i].SelectAltitudeDifference(settings.task.glide),
+                       (*this)[i]);
+
+  std::sort(items.begin(), items.end(),
+            [](const std::pair<fixed, WaypointListItem> &a,
+               const std::pair<fixed, WaypointListItem> &b) {
+              return a.first > b.first;
+            });
+
+  for (unsigned i = 0; i < size(); ++i)
+    (*this)[i] = items[i].second;
 }
@@ -73,6 +73,9 @@ static const char *const Usage = "\n"
   "  -fly            bypass startup-screen, use fly mode directly\n"
 #endif
   "  -profile=fname  load profile from file fname\n"
+#if !defined(_WIN32_WCE)
+  "  -trace=fname    record thread timings, write them to fname on exit\n"
+#endif
 #if !defined(_WIN32_WCE)
   "  -WIDTHxHEIGHT   use screen resolution WIDTH x HEIGHT\n"
   "  -portrait       use a 480x640 screen resolution\n"
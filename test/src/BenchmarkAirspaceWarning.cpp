@@ -0,0 +1,188 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Flies straight tracks across a dense synthetic airspace file and
+ * reports the latency distribution of AirspaceWarningManager::Update()
+ * per fix, with glide, filter and task predictions all active.
+ *
+ * Usage: BenchmarkAirspaceWarning [FIXES]
+ *
+ * Run it built with DEBUG=n.
+ */
+
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspacePolygon.hpp"
+#include "Engine/Airspace/AirspaceCircle.hpp"
+#include "Engine/Airspace/AirspaceWarningManager.hpp"
+#include "Engine/Airspace/AirspaceWarningConfig.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+#include "Engine/Task/Stats/TaskStats.hpp"
+#include "Geo/GeoVector.hpp"
+#include "Math/Angle.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static AirspaceAltitude
+MakeAltitude(fixed altitude)
+{
+  AirspaceAltitude result;
+  result.altitude = altitude;
+  result.reference = AltitudeReference::MSL;
+  return result;
+}
+
+/**
+ * Fills the area between 7E..11E and 50N..53N with overlapping
+ * polygons and circles of various classes and altitude bands.
+ */
+static void
+Populate(Airspaces &airspaces)
+{
+  srand(1);
+
+  for (unsigned i = 0; i < 3000; ++i) {
+    const GeoPoint center(Angle::Degrees(7 + (rand() % 4000) / 1000.),
+                          Angle::Degrees(50 + (rand() % 3000) / 1000.));
+    const fixed base((rand() % 8) * 300);
+    const fixed top = base + fixed(1000 + (rand() % 4) * 500);
+    const AirspaceClass type = AirspaceClass(rand() % 8);
+
+    AbstractAirspace *airspace;
+    if (i % 4 == 0) {
+      airspace = new AirspaceCircle(center, fixed(2000 + rand() % 6000));
+    } else {
+      const unsigned n = 20 + rand() % 130;
+      const double radius = 0.02 + (rand() % 60) / 1000.;
+
+      std::vector<GeoPoint> points;
+      points.reserve(n);
+      for (unsigned j = 0; j < n; ++j) {
+        const Angle a = Angle::FullCircle() * (fixed(j) / n);
+        const double r = radius * (1 + 0.2 * (double)a.sin() * (double)a.cos());
+        points.emplace_back(center.longitude + Angle::Degrees(r * (double)a.cos()),
+                            center.latitude + Angle::Degrees(r * (double)a.sin()));
+      }
+
+      airspace = new AirspacePolygon(points);
+    }
+
+    airspace->SetProperties(_T("Benchmark"), type,
+                            MakeAltitude(base), MakeAltitude(top));
+    airspaces.Add(airspace);
+  }
+
+  airspaces.Optimise();
+}
+
+int
+main(int argc, char **argv)
+{
+  const unsigned n_fixes = argc > 1 ? atoi(argv[1]) : 20000;
+
+  Airspaces airspaces;
+  Populate(airspaces);
+
+  AirspaceWarningConfig config;
+  config.SetDefaults();
+  for (auto &i : config.class_warnings)
+    i = true;
+
+  AirspaceWarningManager warnings(airspaces);
+  warnings.SetConfig(config);
+
+  const GlidePolar glide_polar(fixed(1));
+  const GeoPoint start(Angle::Degrees(7.2), Angle::Degrees(50.2));
+  const GeoPoint finish(Angle::Degrees(10.8), Angle::Degrees(52.8));
+  const GeoVector leg(start, finish);
+  const fixed speed(35);
+
+  AircraftState state;
+  state.Reset();
+  state.location = start;
+  state.altitude = fixed(1500);
+  state.ground_speed = speed;
+  state.true_airspeed = speed;
+  state.track = leg.bearing;
+  state.vario = fixed(-1);
+  state.netto_vario = fixed(-1);
+  state.flying = true;
+  warnings.Reset(state);
+
+  TaskStats task_stats;
+  task_stats.reset();
+  task_stats.task_valid = true;
+
+  std::vector<double> latencies;
+  latencies.reserve(n_fixes);
+  unsigned n_found = 0;
+
+  for (unsigned i = 0; i < n_fixes; ++i) {
+    /* fly back and forth along the leg, weaving up and down */
+    const fixed distance = fmod(speed * i, leg.distance * 2);
+    const fixed along = distance < leg.distance
+      ? distance : leg.distance * 2 - distance;
+    state.location = start.IntermediatePoint(finish, along);
+    state.track = distance < leg.distance
+      ? leg.bearing : leg.bearing.Reciprocal();
+    state.altitude = fixed(1500) + fixed(800) * (Angle::Degrees(i) * 2).sin();
+    state.time = fixed(i);
+
+    const GeoPoint target = distance < leg.distance ? finish : start;
+    ElementStat &current_leg = task_stats.current_leg;
+    current_leg.location_remaining = target;
+    GlideResult &solution = current_leg.solution_remaining;
+    solution.Reset();
+    solution.validity = GlideResult::Validity::OK;
+    solution.vector = GeoVector(state.location, target);
+    solution.height_glide = solution.vector.distance / 40;
+    solution.time_elapsed = solution.vector.distance / speed;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    if (warnings.Update(state, glide_polar, task_stats, i % 3 == 0, 1))
+      ++n_found;
+    const auto t1 = std::chrono::steady_clock::now();
+
+    latencies.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+
+  double total = 0;
+  for (const double i : latencies)
+    total += i;
+
+  printf("%u airspaces, %u fixes, %u updates with changes, %u warnings\n",
+         airspaces.GetSize(), n_fixes, n_found, (unsigned)warnings.size());
+  printf("Update: mean %.1f us, median %.1f us, p99 %.1f us, max %.1f us\n",
+         total / n_fixes, latencies[n_fixes / 2],
+         latencies[n_fixes * 99 / 100], latencies.back());
+
+  return 0;
+}
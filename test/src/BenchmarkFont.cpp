@@ -0,0 +1,100 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2015 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measures Font::TextSize() plus Font::Render(), i.e. what a
+ * TextCache miss costs, with many distinct numeric strings like the
+ * ones shown in InfoBoxes.
+ *
+ * Usage: BenchmarkFont [FONT.ttf [SIZE]]
+ */
+
+#include "Screen/Font.hpp"
+#include "Screen/Debug.hpp"
+#include "Screen/Custom/Files.hpp"
+#include "OS/Clock.hpp"
+
+#include <memory>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static constexpr unsigned NUM_STRINGS = 20000;
+
+int main(int argc, char **argv)
+{
+  Font::Initialise();
+  ScreenInitialized();
+
+  char *path = argc > 1
+    ? strdup(argv[1])
+    : FindDefaultFont();
+  const unsigned size = argc > 2 ? atoi(argv[2]) : 24;
+
+  int result = EXIT_SUCCESS;
+
+  Font font;
+  if (path == nullptr || !font.LoadFile(path, size)) {
+    fprintf(stderr, "Failed to load a font\n");
+    result = EXIT_FAILURE;
+  } else {
+    std::unique_ptr<uint8_t[]> buffer;
+    size_t buffer_size = 0;
+    unsigned long checksum = 0;
+
+    const uint64_t start = MonotonicClockUS();
+    for (unsigned i = 0; i < NUM_STRINGS; ++i) {
+      char text[32];
+      snprintf(text, sizeof(text), "%u.%u", i / 10, i % 10);
+
+      const PixelSize text_size = font.TextSize(text);
+      const size_t n = Font::BufferSize(text_size);
+      if (n > buffer_size) {
+        buffer.reset(new uint8_t[n]);
+        buffer_size = n;
+      }
+
+      font.Render(text, text_size, buffer.get());
+
+      /* prevent gcc from optimizing the rendering away */
+      checksum += text_size.cx + buffer[n / 2];
+    }
+
+    const uint64_t duration = MonotonicClockUS() - start;
+    printf("%u strings at %u px: %.2f us/string  (checksum %lu)\n",
+           NUM_STRINGS, size, double(duration) / NUM_STRINGS, checksum);
+  }
+
+  font.Destroy();
+
+  if (argc > 1)
+    free(path);
+  else
+    delete[] path;
+
+  ScreenDeinitialized();
+  Font::Deinitialise();
+
+  return result;
+}
@@ -0,0 +1,236 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Places the labels of a (dense) waypoint file on a simulated map
+ * with the LabelBlock for a number of frames, while the map is
+ * slowly panned, and reports the time per frame and the number of
+ * labels which flicker, i.e. appear or disappear between two frames
+ * while staying on the screen.  A simulated aircraft crosses the map,
+ * so the arrival altitudes and thus the drawing order change.  The
+ * "scratch" run tests every label in every frame, the "seeded" run
+ * places the labels with PlaceLabels(), like WaypointRenderer does.
+ */
+
+#include "Renderer/LabelBlock.hpp"
+#include "Renderer/LabelPlacement.hpp"
+#include "Projection/Projection.hpp"
+#include "Waypoint/WaypointReader.hpp"
+#include "Waypoint/Factory.hpp"
+#include "Waypoint/Waypoints.hpp"
+#include "Operation/Operation.hpp"
+#include "OS/Args.hpp"
+#include "OS/Clock.hpp"
+#include "Util/StringAPI.hxx"
+
+#include <vector>
+#include <algorithm>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static constexpr int SCREEN_WIDTH = 1024;
+static constexpr int SCREEN_HEIGHT = 768;
+static constexpr unsigned FRAMES = 1000;
+
+/* approximate metrics of the waypoint label font */
+static constexpr int GLYPH_WIDTH = 7;
+static constexpr int LABEL_HEIGHT = 14;
+
+struct BenchmarkLabel {
+  GeoPoint location;
+  unsigned priority;
+  fixed arrival;
+  int width;
+
+  /* the attributes used by PlaceLabels() */
+  RasterPoint Pos;
+  bool on_screen;
+  bool placed, was_placed;
+  RasterPoint placed_pos;
+
+  bool Visible() const {
+    return on_screen;
+  }
+
+  PixelRect GetRect() const {
+    return PixelRect(Pos.x, Pos.y, Pos.x + width, Pos.y + LABEL_HEIGHT);
+  }
+};
+
+static unsigned
+GetPriority(const Waypoint &wp)
+{
+  if (wp.IsAirport())
+    return 2;
+  if (wp.IsLandable())
+    return 1;
+  return 0;
+}
+
+/**
+ * Labels are drawn in priority order, like WaypointLabelList::Sort().
+ * The arrival altitude changes while the aircraft moves, which
+ * reorders nearby labels in every frame.
+ */
+static void
+Sort(std::vector<BenchmarkLabel> &labels, const GeoPoint &aircraft)
+{
+  for (auto &l : labels)
+    l.arrival = -aircraft.DistanceS(l.location);
+
+  std::sort(labels.begin(), labels.end(),
+            [](const BenchmarkLabel &a, const BenchmarkLabel &b) {
+              if (a.priority != b.priority)
+                return a.priority > b.priority;
+              return a.arrival > b.arrival;
+            });
+}
+
+static void
+UpdatePositions(std::vector<BenchmarkLabel> &labels,
+                const Projection &projection)
+{
+  for (auto &l : labels) {
+    const RasterPoint p = projection.GeoToScreen(l.location);
+    l.Pos.x = p.x + 6;
+    l.Pos.y = p.y - LABEL_HEIGHT / 2;
+    l.on_screen = p.x >= 0 && p.x < SCREEN_WIDTH &&
+      p.y >= 0 && p.y < SCREEN_HEIGHT;
+  }
+}
+
+static void
+PlaceScratch(std::vector<BenchmarkLabel> &labels, LabelBlock &label_block)
+{
+  for (auto &l : labels)
+    l.placed = l.on_screen && label_block.check(l.GetRect());
+}
+
+/**
+ * Places the labels like WaypointRenderer does.
+ */
+static void
+PlaceSeeded(std::vector<BenchmarkLabel> &labels, LabelBlock &label_block)
+{
+  PlaceLabels(labels, [&label_block](const BenchmarkLabel &l, bool skip_check){
+      return label_block.check(l.GetRect(), skip_check);
+    });
+}
+
+static void
+Run(const char *name, std::vector<BenchmarkLabel> &labels,
+    Projection projection,
+    void (*place)(std::vector<BenchmarkLabel> &labels, LabelBlock &label_block))
+{
+  static LabelBlock label_block;
+
+  for (auto &l : labels)
+    l.placed = l.was_placed = false;
+
+  unsigned flicker = 0, placed = 0;
+  uint64_t duration = 0;
+
+  const RasterPoint origin = projection.GetScreenOrigin();
+
+  for (unsigned frame = 0; frame < FRAMES; ++frame) {
+    /* pan by one pixel every fourth frame, the other frames are
+       redrawn without movement (e.g. new GPS fix) */
+    projection.SetScreenOrigin(origin.x + frame / 4, origin.y + frame / 8);
+    UpdatePositions(labels, projection);
+    Sort(labels, projection.ScreenToGeo(SCREEN_WIDTH / 4 + frame / 2,
+                                        SCREEN_HEIGHT / 4 + frame / 3));
+
+    const uint64_t start = MonotonicClockUS();
+    label_block.reset();
+    place(labels, label_block);
+    duration += MonotonicClockUS() - start;
+
+    for (auto &l : labels) {
+      if (l.placed)
+        ++placed;
+      if (frame > 0 && l.on_screen && l.placed != l.was_placed)
+        ++flicker;
+      l.was_placed = l.placed;
+    }
+  }
+
+  printf("%-8s %8.2f us/frame  %6u labels/frame  %6u flickers\n",
+         name, double(duration) / FRAMES, placed / FRAMES, flicker);
+}
+
+int
+main(int argc, char **argv)
+{
+  Args args(argc, argv, "PATH\n");
+  const tstring path = args.ExpectNextT();
+  args.ExpectEnd();
+
+  Waypoints way_points;
+
+  NullOperationEnvironment operation;
+  if (!ReadWaypointFile(path.c_str(), way_points,
+                        WaypointFactory(WaypointOrigin::NONE),
+                        operation)) {
+    fprintf(stderr, "ReadWaypointFile() has failed\n");
+    return EXIT_FAILURE;
+  }
+
+  way_points.Optimise();
+  if (way_points.IsEmpty()) {
+    fprintf(stderr, "No waypoints\n");
+    return EXIT_FAILURE;
+  }
+
+  std::vector<BenchmarkLabel> labels;
+  fixed latitude = fixed(0), longitude = fixed(0);
+  for (const Waypoint &wp : way_points) {
+    BenchmarkLabel l;
+    l.location = wp.location;
+    l.priority = GetPriority(wp);
+    l.width = (StringLength(wp.name.c_str()) + 1) * GLYPH_WIDTH;
+    l.placed = l.was_placed = false;
+    labels.push_back(l);
+
+    latitude += wp.location.latitude.Degrees();
+    longitude += wp.location.longitude.Degrees();
+  }
+
+  const GeoPoint center(Angle::Degrees(longitude / labels.size()),
+                        Angle::Degrees(latitude / labels.size()));
+
+  fixed max_distance = fixed(1000);
+  for (const auto &l : labels)
+    max_distance = std::max(max_distance, center.Distance(l.location));
+
+  Projection projection;
+  projection.SetScale(fixed(SCREEN_HEIGHT / 2) / max_distance);
+  projection.SetScreenOrigin(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
+  projection.SetGeoLocation(center);
+
+  printf("%u waypoints, %u frames\n", unsigned(labels.size()), FRAMES);
+  Run("scratch", labels, projection, PlaceScratch);
+  Run("seeded", labels, projection, PlaceSeeded);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,246 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measures the MacCready glide solver and the speed-to-fly
+ * calculation, and checks the optimised speeds against a brute force
+ * scan of the polar.  With MacCready zero, MacCready::Solve() has to
+ * search the airspeed that gives the best glide over ground.
+ */
+
+#include "Engine/GlideSolvers/GlideSettings.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Engine/GlideSolvers/GlideState.hpp"
+#include "Engine/GlideSolvers/GlideResult.hpp"
+#include "Engine/GlideSolvers/GlideBatch.hpp"
+#include "Engine/GlideSolvers/MacCready.hpp"
+#include "Geo/SpeedVector.hpp"
+#include "Geo/GeoVector.hpp"
+#include "OS/Clock.hpp"
+
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static constexpr unsigned NUM_TASKS = 4096;
+static constexpr unsigned REPEAT = 10;
+
+static GlideSettings glide_settings;
+
+static std::vector<GlideState>
+MakeTasks()
+{
+  std::vector<GlideState> tasks;
+  tasks.reserve(NUM_TASKS);
+
+  for (unsigned i = 0; i < NUM_TASKS; ++i) {
+    const GeoVector vector(fixed(1000 + rand() % 100000),
+                           Angle::Degrees(rand() % 360));
+    const SpeedVector wind(Angle::Degrees(rand() % 360),
+                           fixed(rand() % 20));
+    tasks.emplace_back(vector, fixed(0), fixed(rand() % 2500), wind);
+  }
+
+  return tasks;
+}
+
+/**
+ * Find the glide height of a full glide with the best airspeed by
+ * scanning the whole speed range of the polar.
+ */
+static fixed
+ScanGlideHeight(const MacCready &mac_cready, const GlidePolar &polar,
+                const GlideState &task)
+{
+  fixed best = fixed(-1);
+  for (fixed v = polar.GetVMin(); v <= polar.GetVMax(); v += fixed(0.01)) {
+    const GlideResult result = mac_cready.SolveGlide(task, v);
+    if (result.IsOk() && (negative(best) || result.height_glide < best))
+      best = result.height_glide;
+  }
+
+  return best;
+}
+
+/**
+ * @return the number of tasks with a glide height worse than the
+ * brute force scan
+ */
+static unsigned
+CheckOptimiseGlide(const GlidePolar &polar,
+                   const std::vector<GlideState> &tasks)
+{
+  const MacCready mac_cready(glide_settings, polar);
+
+  unsigned errors = 0;
+  for (unsigned i = 0; i < NUM_TASKS; i += 16) {
+    const GlideResult result = mac_cready.Solve(tasks[i]);
+    const fixed best = ScanGlideHeight(mac_cready, polar, tasks[i]);
+    if (!result.IsOk() || negative(best))
+      continue;
+
+    if (result.height_glide > best * fixed(1.0001) + fixed(0.01))
+      ++errors;
+  }
+
+  return errors;
+}
+
+/**
+ * @return the number of speeds with a glide ratio worse than the
+ * brute force scan
+ */
+static unsigned
+CheckSpeedToFly(GlidePolar polar)
+{
+  unsigned errors = 0;
+  for (unsigned mc = 0; mc <= 50; ++mc) {
+    polar.SetMC(fixed(mc) / 10);
+
+    fixed best = fixed(-1);
+    for (fixed v = polar.GetVMin(); v <= polar.GetVMax(); v += fixed(0.01)) {
+      const fixed ratio = polar.MSinkRate(v) / v;
+      if (negative(best) || ratio < best)
+        best = ratio;
+    }
+
+    const fixed v = polar.SpeedToFlyStillAir();
+    if (polar.MSinkRate(v) / v > best * fixed(1.0001))
+      ++errors;
+  }
+
+  return errors;
+}
+
+static void
+BenchmarkSolve(const char *name, const GlidePolar &polar,
+               const std::vector<GlideState> &tasks)
+{
+  const MacCready mac_cready(glide_settings, polar);
+
+  fixed sum = fixed(0);
+  const uint64_t start = MonotonicClockUS();
+  for (unsigned r = 0; r < REPEAT; ++r)
+    for (const GlideState &task : tasks)
+      sum += mac_cready.Solve(task).time_elapsed;
+  const uint64_t duration = MonotonicClockUS() - start;
+
+  printf("%-24s %8.3f us/solve  (checksum %g)\n", name,
+         double(duration) / (REPEAT * NUM_TASKS), double(sum));
+}
+
+/**
+ * Straight glides to many destinations in the same wind, like the
+ * waypoint reachability calculation, once one by one and once with
+ * #GlideBatch.
+ */
+static void
+BenchmarkSolveStraight(const char *name, const GlidePolar &polar)
+{
+  const MacCready mac_cready(glide_settings, polar);
+  const SpeedVector wind(Angle::Degrees(rand() % 360), fixed(rand() % 20));
+
+  std::vector<GlideState> tasks;
+  tasks.reserve(NUM_TASKS);
+  GlideBatch batch;
+  batch.Reserve(NUM_TASKS);
+
+  for (unsigned i = 0; i < NUM_TASKS; ++i) {
+    const GeoVector vector(fixed(1000 + rand() % 100000),
+                           Angle::Degrees(rand() % 360));
+    const fixed altitude_difference = fixed(rand() % 2500);
+    tasks.emplace_back(vector, fixed(0), altitude_difference, wind);
+    batch.Add(vector, altitude_difference);
+  }
+
+  fixed sum = fixed(0);
+  uint64_t start = MonotonicClockUS();
+  for (unsigned r = 0; r < REPEAT; ++r)
+    for (const GlideState &task : tasks)
+      sum += mac_cready.SolveStraight(task).pure_glide_altitude_difference;
+  uint64_t duration = MonotonicClockUS() - start;
+
+  printf("%-24s %8.3f us/solve  (checksum %g)\n", name,
+         double(duration) / (REPEAT * NUM_TASKS), double(sum));
+
+  sum = fixed(0);
+  start = MonotonicClockUS();
+  for (unsigned r = 0; r < REPEAT; ++r) {
+    mac_cready.SolveStraight(batch, wind);
+    for (unsigned i = 0; i < NUM_TASKS; ++i)
+      sum += batch.GetAltitudeDifference(i);
+  }
+  duration = MonotonicClockUS() - start;
+
+  printf("%-24s %8.3f us/solve  (checksum %g)\n", "  batch",
+         double(duration) / (REPEAT * NUM_TASKS), double(sum));
+}
+
+static void
+BenchmarkSpeedToFly(GlidePolar polar)
+{
+  fixed sum = fixed(0);
+  const uint64_t start = MonotonicClockUS();
+  for (unsigned r = 0; r < REPEAT * 100; ++r) {
+    polar.SetMC(fixed(r % 50) / 10);
+    sum += polar.SpeedToFlyStillAir();
+  }
+  const uint64_t duration = MonotonicClockUS() - start;
+
+  printf("%-24s %8.3f us/call   (checksum %g)\n", "speed to fly",
+         double(duration) / (REPEAT * 100), double(sum));
+}
+
+int
+main(int argc, char **argv)
+{
+  glide_settings.SetDefaults();
+
+  const std::vector<GlideState> tasks = MakeTasks();
+
+  GlidePolar polar(fixed(0));
+  polar.SetBugs(fixed(0.9));
+  polar.SetBallast(fixed(0.5));
+
+  BenchmarkSolve("solve mc=0", polar, tasks);
+
+  GlidePolar polar_mc = polar;
+  polar_mc.SetMC(fixed(2));
+  BenchmarkSolve("solve mc=2", polar_mc, tasks);
+
+  BenchmarkSolveStraight("straight mc=0", polar);
+  BenchmarkSolveStraight("straight mc=2", polar_mc);
+
+  BenchmarkSpeedToFly(polar);
+
+  const unsigned glide_errors = CheckOptimiseGlide(polar, tasks);
+  const unsigned stf_errors = CheckSpeedToFly(polar);
+  if (glide_errors > 0 || stf_errors > 0) {
+    fprintf(stderr, "%u glide and %u speed to fly solutions are not optimal\n",
+            glide_errors, stf_errors);
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -21,11 +21,29 @@ Copyright_License {
 }
 */
 
+/*
+ * Measures the screen projection and the flat (task) projection of
+ * geographic points, the latter once point by point and once with the
+ * bulk functions which use SIMD instructions where available.
+ */
+
 #include "Projection/Projection.hpp"
 #include "Screen/Layout.hpp"
+#include "Geo/Flat/FlatProjection.hpp"
+#include "Geo/Flat/FlatGeoPoint.hpp"
+#include "Geo/Flat/FlatPoint.hpp"
+#include "Geo/SearchPointVector.hpp"
+#include "OS/Clock.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
 
 unsigned Layout::scale_1024 = 1024;
 
+/** number of points projected by each flat projection benchmark */
+static constexpr unsigned NUM_POINTS = 1024;
+static constexpr unsigned REPEAT = 16 * 1024;
+
 class TestProjection : public Projection {
 public:
   TestProjection() {
@@ -36,14 +54,24 @@ public:
   }
 };
 
-int main(int argc, char **argv)
+static void
+Report(const char *name, uint64_t duration, unsigned n, long checksum)
+{
+  printf("%-28s %8.2f ns/point  (checksum %ld)\n", name,
+         double(duration) * 1000. / n, checksum);
+}
+
+static void
+BenchmarkGeoToScreen()
 {
   TestProjection projection;
 
   GeoPoint gp = GeoPoint(Angle::Degrees(7.7061111111111114),
                          Angle::Degrees(51.051944444444445));
   long x = 0, y = 0;
-  for (unsigned i = 64 * 1024 * 1024; i-- > 0;) {
+  const unsigned n = 16 * 1024 * 1024;
+  const uint64_t start = MonotonicClockUS();
+  for (unsigned i = n; i-- > 0;) {
     RasterPoint rp = projection.GeoToScreen(gp);
 
     /* prevent gcc from optimizing this loop away */
@@ -51,5 +79,113 @@ int main(int argc, char **argv)
     y += rp.y;
   }
 
-  return x + y;
+  Report("GeoToScreen", MonotonicClockUS() - start, n, x + y);
+}
+
+static void
+BenchmarkProjectInteger(const FlatProjection &projection,
+                        const GeoPoint *src)
+{
+  FlatGeoPoint dest[NUM_POINTS];
+  long checksum = 0;
+
+  uint64_t start = MonotonicClockUS();
+  for (unsigned r = 0; r < REPEAT; ++r) {
+    for (unsigned i = 0; i < NUM_POINTS; ++i)
+      dest[i] = projection.ProjectInteger(src[i]);
+    checksum += dest[r % NUM_POINTS].longitude;
+  }
+  Report("ProjectInteger", MonotonicClockUS() - start,
+         REPEAT * NUM_POINTS, checksum);
+
+  checksum = 0;
+  start = MonotonicClockUS();
+  for (unsigned r = 0; r < REPEAT; ++r) {
+    projection.ProjectInteger(src, dest, NUM_POINTS);
+    checksum += dest[r % NUM_POINTS].longitude;
+  }
+  Report("  bulk", MonotonicClockUS() - start,
+         REPEAT * NUM_POINTS, checksum);
+}
+
+static void
+BenchmarkProjectFloat(const FlatProjection &projection,
+                      const GeoPoint *src)
+{
+  FlatPoint dest[NUM_POINTS];
+  fixed checksum = fixed(0);
+
+  uint64_t start = MonotonicClockUS();
+  for (unsigned r = 0; r < REPEAT; ++r) {
+    for (unsigned i = 0; i < NUM_POINTS; ++i)
+      dest[i] = projection.ProjectFloat(src[i]);
+    checksum += dest[r % NUM_POINTS].x;
+  }
+  Report("ProjectFloat", MonotonicClockUS() - start,
+         REPEAT * NUM_POINTS, (long)checksum);
+
+  checksum = fixed(0);
+  start = MonotonicClockUS();
+  for (unsigned r = 0; r < REPEAT; ++r) {
+    projection.ProjectFloat(src, dest, NUM_POINTS);
+    checksum += dest[r % NUM_POINTS].x;
+  }
+  Report("  bulk", MonotonicClockUS() - start,
+         REPEAT * NUM_POINTS, (long)checksum);
+}
+
+/**
+ * Like an airspace border being projected.
+ */
+static void
+BenchmarkSearchPointVector(const FlatProjection &projection,
+                           const GeoPoint *src)
+{
+  SearchPointVector spv;
+  for (unsigned i = 0; i < NUM_POINTS; ++i)
+    spv.push_back(SearchPoint(src[i]));
+
+  long checksum = 0;
+  uint64_t start = MonotonicClockUS();
+  for (unsigned r = 0; r < REPEAT; ++r) {
+    for (auto &i : spv)
+      i.Project(projection);
+    checksum += spv[r % NUM_POINTS].GetFlatLocation().longitude;
+  }
+  Report("SearchPoint::Project", MonotonicClockUS() - start,
+         REPEAT * NUM_POINTS, checksum);
+
+  checksum = 0;
+  start = MonotonicClockUS();
+  for (unsigned r = 0; r < REPEAT; ++r) {
+    spv.Project(projection);
+    checksum += spv[r % NUM_POINTS].GetFlatLocation().longitude;
+  }
+  Report("SearchPointVector::Project", MonotonicClockUS() - start,
+         REPEAT * NUM_POINTS, checksum);
+}
+
+int main(int argc, char **argv)
+{
+  BenchmarkGeoToScreen();
+
+  const GeoPoint center(Angle::Degrees(7.7061111111111114),
+                        Angle::Degrees(51.051944444444445));
+  const FlatProjection projection(center);
+
+  /* a 200 km x 200 km area, like a task or the airspaces around it */
+  static GeoPoint src[NUM_POINTS];
+  srand(42);
+  for (auto &i : src) {
+    const fixed dx = fixed(rand() % 3000 - 1500) / 1000;
+    const fixed dy = fixed(rand() % 2000 - 1000) / 1000;
+    i = GeoPoint(center.longitude + Angle::Degrees(dx),
+                 center.latitude + Angle::Degrees(dy));
+  }
+
+  BenchmarkProjectInteger(projection, src);
+  BenchmarkProjectFloat(projection, src);
+  BenchmarkSearchPointVector(projection, src);
+
+  return EXIT_SUCCESS;
 }
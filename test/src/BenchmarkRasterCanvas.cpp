@@ -0,0 +1,173 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Runs the RasterCanvas primitives which are used by the map
+ * renderer on an off-screen buffer and reports the throughput of
+ * each one in megapixels per second.  The alpha blending primitives
+ * are run both with the (SIMD) optimised and the portable pixel
+ * operations.
+ */
+
+#include "Screen/Memory/PixelTraits.hpp"
+#include "Screen/Memory/Optimised.hpp"
+#include "Screen/Memory/RasterCanvas.hpp"
+#include "OS/Clock.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static constexpr unsigned WIDTH = 800, HEIGHT = 480;
+static constexpr unsigned REPEAT = 200;
+
+/* a semi-transparent overlay, like the one used for airspace areas */
+static constexpr uint8_t ALPHA = 0x60;
+
+static void
+Report(const char *traits, const char *name, unsigned long pixels,
+       uint64_t duration_us)
+{
+  printf("%-10s %-20s %9.1f MP/s\n", traits, name,
+         double(pixels) / double(duration_us > 0 ? duration_us : 1));
+}
+
+/**
+ * Call the function #REPEAT times and report the number of pixels
+ * per second.
+ *
+ * @param pixels the number of pixels drawn by one call
+ */
+template<typename F>
+static void
+Run(const char *traits, const char *name, unsigned long pixels, F f)
+{
+  const uint64_t start = MonotonicClockUS();
+  for (unsigned i = 0; i < REPEAT; ++i)
+    f(i);
+  Report(traits, name, pixels * REPEAT, MonotonicClockUS() - start);
+}
+
+/**
+ * The portable implementation, for comparison with
+ * #AlphaPixelOperations which may be optimised.
+ */
+template<typename PixelTraits>
+struct PortableAlpha : PortableAlphaPixelOperations<PixelTraits> {
+  explicit constexpr PortableAlpha(uint8_t alpha)
+    :PortableAlphaPixelOperations<PixelTraits>(alpha) {}
+};
+
+template<typename PixelTraits>
+static void
+FillRandom(WritableImageBuffer<PixelTraits> buffer)
+{
+  uint8_t *p = (uint8_t *)buffer.data;
+  for (unsigned i = 0, n = buffer.pitch * buffer.height; i < n; ++i)
+    p[i] = rand();
+}
+
+template<typename PixelTraits>
+static void
+Benchmark(const char *traits_name, typename PixelTraits::color_type color)
+{
+  typedef typename PixelTraits::const_pointer_type const_pointer_type;
+
+  WritableImageBuffer<PixelTraits> dest, src;
+  dest.Allocate(WIDTH, HEIGHT);
+  src.Allocate(WIDTH, HEIGHT);
+  FillRandom(dest);
+  FillRandom(src);
+
+  RasterCanvas<PixelTraits> canvas(dest);
+
+  const unsigned long screen = WIDTH * HEIGHT;
+
+  Run(traits_name, "fill", screen, [&](unsigned){
+      canvas.FillRectangle(0, 0, WIDTH, HEIGHT, color);
+    });
+
+  /* short spans of varying width and alignment, like text
+     backgrounds and small polygons */
+  unsigned long span_pixels = 0;
+  for (unsigned i = 0; i < 64; ++i)
+    span_pixels += (7 + i % 57) * 16;
+  Run(traits_name, "fill-span", span_pixels, [&](unsigned){
+      for (unsigned i = 0; i < 64; ++i) {
+        const int x = (i * 37) % (WIDTH - 64), y = (i * 53) % (HEIGHT - 16);
+        canvas.FillRectangle(x, y, x + 7 + i % 57, y + 16, color);
+      }
+    });
+
+  const AlphaPixelOperations<PixelTraits> alpha(ALPHA);
+  const PortableAlpha<PixelTraits> portable_alpha(ALPHA);
+
+  Run(traits_name, "alpha-fill", screen, [&](unsigned){
+      canvas.FillRectangle(0, 0, WIDTH, HEIGHT, color, alpha);
+    });
+
+  Run(traits_name, "alpha-fill-portable", screen, [&](unsigned){
+      canvas.FillRectangle(0, 0, WIDTH, HEIGHT, color, portable_alpha);
+    });
+
+  const const_pointer_type src_data = src.data;
+
+  Run(traits_name, "alpha-copy", screen, [&](unsigned){
+      canvas.CopyRectangle(0, 0, WIDTH, HEIGHT, src_data, src.pitch, alpha);
+    });
+
+  Run(traits_name, "alpha-copy-portable", screen, [&](unsigned){
+      canvas.CopyRectangle(0, 0, WIDTH, HEIGHT, src_data, src.pitch,
+                           portable_alpha);
+    });
+
+  Run(traits_name, "copy", screen, [&](unsigned){
+      canvas.CopyRectangle(0, 0, WIDTH, HEIGHT, src_data, src.pitch);
+    });
+
+  /* doubling is used for scaled icons and bitmaps on high-dpi
+     screens */
+  Run(traits_name, "scale-2x", screen, [&](unsigned){
+      canvas.ScaleRectangle(0, 0, WIDTH, HEIGHT, src_data, src.pitch,
+                            WIDTH / 2, HEIGHT / 2);
+    });
+
+  Run(traits_name, "scale-1.5x", screen, [&](unsigned){
+      canvas.ScaleRectangle(0, 0, WIDTH, HEIGHT, src_data, src.pitch,
+                            WIDTH * 2 / 3, HEIGHT * 2 / 3);
+    });
+
+  src.Free();
+  dest.Free();
+}
+
+int
+main(int argc, char **argv)
+{
+  Benchmark<GreyscalePixelTraits>("greyscale", Luminosity8(0x80));
+
+#ifndef GREYSCALE
+  Benchmark<BGRAPixelTraits>("bgra", BGRA8Color(0x20, 0x40, 0x80, 0xff));
+#endif
+
+  return EXIT_SUCCESS;
+}
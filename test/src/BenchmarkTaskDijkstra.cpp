@@ -0,0 +1,220 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measures the cost of one TaskDijkstraMax/TaskDijkstraMin update on
+ * a 7 point AAT task with large sampled sectors, the way
+ * OrderedTask calls them for each fix: the maximum achieved distance
+ * after a new sample has replaced an old one in the active sector,
+ * and the minimum remaining distance after the aircraft has moved.
+ * The "full" runs discard the cached partial results before each
+ * update, the "incremental" runs keep them.
+ */
+
+#include "Engine/Task/PathSolvers/TaskDijkstraMax.hpp"
+#include "Engine/Task/PathSolvers/TaskDijkstraMin.hpp"
+#include "Geo/GeoVector.hpp"
+#include "OS/Clock.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static constexpr unsigned NUM_POINTS = 7;
+static constexpr unsigned ACTIVE = 3;
+static constexpr unsigned NUM_SAMPLES = 150;
+static constexpr unsigned NUM_BOUNDARY = 64;
+static constexpr unsigned UPDATES = 100;
+
+static const GeoPoint center(Angle::Degrees(7.7), Angle::Degrees(51.05));
+
+static GeoPoint
+GetTaskPointLocation(unsigned i)
+{
+  return GeoVector(fixed(100000),
+                   Angle::FullCircle() * i / NUM_POINTS).EndPoint(center);
+}
+
+static GeoPoint
+RandomPointInSector(unsigned i)
+{
+  const fixed distance = fixed(rand() % 20000);
+  const Angle bearing = Angle::Degrees(rand() % 360);
+  return GeoVector(distance, bearing).EndPoint(GetTaskPointLocation(i));
+}
+
+static SearchPointVector
+MakeSamples(unsigned i)
+{
+  SearchPointVector v;
+  for (unsigned j = 0; j < NUM_SAMPLES; ++j)
+    v.emplace_back(RandomPointInSector(i));
+  return v;
+}
+
+static SearchPointVector
+MakeBoundary(unsigned i)
+{
+  const GeoPoint location = GetTaskPointLocation(i);
+
+  SearchPointVector v;
+  for (unsigned j = 0; j < NUM_BOUNDARY; ++j)
+    v.emplace_back(GeoVector(fixed(20000),
+                             Angle::FullCircle() * j / NUM_BOUNDARY)
+                   .EndPoint(location));
+  return v;
+}
+
+template<typename S>
+static fixed
+GetSolutionDistance(const S &solver, unsigned n,
+                    const GeoPoint &origin=GeoPoint::Invalid())
+{
+  fixed distance = origin.IsValid()
+    ? origin.Distance(solver.GetSolution(0).GetLocation())
+    : fixed(0);
+  for (unsigned i = 1; i < n; ++i)
+    distance += solver.GetSolution(i - 1).GetLocation()
+      .Distance(solver.GetSolution(i).GetLocation());
+  return distance;
+}
+
+static void
+Report(const char *name, uint64_t full, uint64_t incremental)
+{
+  printf("%-10s full %10.1f us/update  incremental %10.1f us/update\n",
+         name, double(full) / UPDATES, double(incremental) / UPDATES);
+}
+
+/**
+ * @return false if the full and the incremental run disagree
+ */
+static bool
+BenchmarkMax()
+{
+  /* the task points before the active one and the active one have
+     been sampled, the ones after it are represented by their
+     nominal point */
+  SearchPointVector points[NUM_POINTS];
+  for (unsigned i = 0; i < NUM_POINTS; ++i) {
+    if (i <= ACTIVE)
+      points[i] = MakeSamples(i);
+    else
+      points[i].emplace_back(GetTaskPointLocation(i));
+  }
+
+  TaskDijkstraMax full, incremental;
+  uint64_t full_duration = 0, incremental_duration = 0;
+  bool ok = true;
+
+  for (unsigned u = 0; u < UPDATES; ++u) {
+    points[ACTIVE][rand() % NUM_SAMPLES] = SearchPoint(RandomPointInSector(ACTIVE));
+
+    for (TaskDijkstraMax *solver : { &full, &incremental }) {
+      const uint64_t start = MonotonicClockUS();
+
+      if (solver == &full)
+        solver->Invalidate();
+
+      solver->SetTaskSize(NUM_POINTS);
+      for (unsigned i = 0; i < NUM_POINTS; ++i)
+        solver->SetBoundary(i, points[i]);
+
+      if (!solver->DistanceMax())
+        ok = false;
+
+      (solver == &full ? full_duration : incremental_duration) +=
+        MonotonicClockUS() - start;
+    }
+
+    if (GetSolutionDistance(full, NUM_POINTS) !=
+        GetSolutionDistance(incremental, NUM_POINTS))
+      ok = false;
+  }
+
+  Report("max", full_duration, incremental_duration);
+  return ok;
+}
+
+static bool
+BenchmarkMin()
+{
+  /* the remaining task points are searched on their boundaries */
+  SearchPointVector points[NUM_POINTS];
+  for (unsigned i = ACTIVE; i < NUM_POINTS; ++i)
+    points[i] = MakeBoundary(i);
+
+  static constexpr unsigned n = NUM_POINTS - ACTIVE;
+
+  TaskDijkstraMin full, incremental;
+  uint64_t full_duration = 0, incremental_duration = 0;
+  bool ok = true;
+
+  GeoPoint aircraft = GetTaskPointLocation(ACTIVE - 1);
+  const GeoVector step(fixed(50), Angle::Degrees(120));
+
+  for (unsigned u = 0; u < UPDATES; ++u) {
+    aircraft = step.EndPoint(aircraft);
+    const SearchPoint location(aircraft);
+
+    for (TaskDijkstraMin *solver : { &full, &incremental }) {
+      const uint64_t start = MonotonicClockUS();
+
+      if (solver == &full)
+        solver->Invalidate();
+
+      solver->SetTaskSize(n);
+      for (unsigned i = 0; i < n; ++i)
+        solver->SetBoundary(i, points[ACTIVE + i]);
+
+      if (!solver->DistanceMin(location))
+        ok = false;
+
+      (solver == &full ? full_duration : incremental_duration) +=
+        MonotonicClockUS() - start;
+    }
+
+    if (GetSolutionDistance(full, n, aircraft) !=
+        GetSolutionDistance(incremental, n, aircraft))
+      ok = false;
+  }
+
+  Report("min", full_duration, incremental_duration);
+  return ok;
+}
+
+int
+main(int argc, char **argv)
+{
+  printf("%u task points, %u samples per sector, %u boundary points\n",
+         NUM_POINTS, NUM_SAMPLES, NUM_BOUNDARY);
+
+  bool ok = BenchmarkMax();
+  ok = BenchmarkMin() && ok;
+
+  if (!ok) {
+    fprintf(stderr, "Incremental and full results differ\n");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,435 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Replays the IGC traces in test/data through the task engine the
+ * way TaskComputer drives it, and reports the latency distribution
+ * and the heap allocations of TaskManager::Update(), UpdateIdle()
+ * and UpdateAutoMC() per fix.  Each trace is flown as a racing, AAT,
+ * MAT and FAI triangle task laid out along the trace itself, and
+ * apf-bug554.igc is also flown against apf-bug554.tsk.
+ *
+ * Usage: BenchmarkTaskManager [IGC [TSK]]
+ *
+ * Run it from the top-level source directory, built with DEBUG=n.
+ */
+
+#include "Engine/Task/TaskManager.hpp"
+#include "Engine/Task/TaskBehaviour.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Engine/Task/Ordered/Points/StartPoint.hpp"
+#include "Engine/Task/Ordered/Points/IntermediatePoint.hpp"
+#include "Engine/Task/Ordered/Points/FinishPoint.hpp"
+#include "Engine/Task/Factory/AbstractTaskFactory.hpp"
+#include "Engine/Task/ObservationZones/CylinderZone.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+#include "Task/Deserialiser.hpp"
+#include "XML/Node.hpp"
+#include "XML/Parser.hpp"
+#include "XML/DataNodeXML.hpp"
+#include "IGC/IGCParser.hpp"
+#include "IGC/IGCFix.hpp"
+#include "IGC/IGCExtensions.hpp"
+#include "IO/FileLineReader.hpp"
+#include "OS/ConvertPathName.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static unsigned n_allocations;
+
+void *
+operator new(std::size_t size)
+{
+  ++n_allocations;
+  return malloc(size > 0 ? size : 1);
+}
+
+void
+operator delete(void *p) noexcept
+{
+  free(p);
+}
+
+static std::vector<AircraftState>
+LoadTrace(const char *path)
+{
+  std::vector<AircraftState> trace;
+
+  FileLineReaderA reader(path);
+  if (reader.error())
+    return trace;
+
+  IGCExtensions extensions;
+  extensions.clear();
+
+  const fixed takeoff_speed(10);
+  bool flying = false;
+  fixed day_offset = fixed(0);
+
+  char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    IGCFix fix;
+    if (!IGCParseFix(line, extensions, fix)) {
+      IGCParseExtensions(line, extensions);
+      continue;
+    }
+
+    if (!fix.gps_valid || !fix.time.IsPlausible())
+      continue;
+
+    AircraftState state;
+    state.Reset();
+    state.location = fix.location;
+    state.altitude = fixed(fix.pressure_altitude != 0
+                           ? fix.pressure_altitude : fix.gps_altitude);
+    state.time = fixed(fix.time.GetSecondOfDay()) + day_offset;
+
+    if (!trace.empty()) {
+      const AircraftState &last = trace.back();
+      if (state.time < last.time) {
+        /* midnight wraparound */
+        day_offset += fixed(24 * 3600);
+        state.time += fixed(24 * 3600);
+      }
+
+      const fixed dt = state.time - last.time;
+      if (!positive(dt))
+        continue;
+
+      const GeoVector vector = last.location.DistanceBearing(state.location);
+      state.ground_speed = vector.distance / dt;
+      state.track = vector.bearing;
+      state.vario = (state.altitude - last.altitude) / dt;
+      state.netto_vario = state.vario;
+    }
+
+    flying |= state.ground_speed > takeoff_speed;
+    state.flying = flying;
+    trace.push_back(state);
+  }
+
+  return trace;
+}
+
+static Waypoint
+MakeWaypoint(const AircraftState &state, unsigned id)
+{
+  Waypoint wp(state.location);
+  wp.id = id;
+  wp.elevation = fixed(0);
+  wp.name = _T("WP");
+  return wp;
+}
+
+static bool
+Append(AbstractTaskFactory &factory, OrderedTaskPoint *tp)
+{
+  const bool success = factory.Append(*tp, false);
+  delete tp;
+  return success;
+}
+
+static unsigned
+GetStartIndex(const std::vector<AircraftState> &trace)
+{
+  return trace.size() * 5 / 100;
+}
+
+/**
+ * Find the largest triangle through the start which satisfies the FAI
+ * 28% rule, with its corners on the trace.
+ *
+ * @return false if there is no such triangle
+ */
+static bool
+FindTriangle(const std::vector<AircraftState> &trace, unsigned start,
+             unsigned &tp1, unsigned &tp2)
+{
+  static constexpr unsigned STEPS = 40;
+
+  const unsigned n = trace.size();
+  fixed best = fixed(0);
+  for (unsigned i = 1; i < STEPS; ++i) {
+    const GeoPoint &a = trace[n * i / STEPS].location;
+    for (unsigned j = i + 1; j < STEPS; ++j) {
+      const GeoPoint &b = trace[n * j / STEPS].location;
+      const fixed d1 = trace[start].location.Distance(a);
+      const fixed d2 = a.Distance(b);
+      const fixed d3 = b.Distance(trace[start].location);
+      const fixed total = d1 + d2 + d3;
+      if (std::min(d1, std::min(d2, d3)) >= total * fixed(0.28) &&
+          total > best) {
+        best = total;
+        tp1 = n * i / STEPS;
+        tp2 = n * j / STEPS;
+      }
+    }
+  }
+
+  return positive(best);
+}
+
+/**
+ * Create a task with two turn points, starting at 5% of the trace
+ * and finishing at 95% (or at the start for a triangle).
+ */
+static bool
+CreateTask(TaskManager &task_manager, const TaskBehaviour &task_behaviour,
+           TaskFactoryType type, const std::vector<AircraftState> &trace)
+{
+  const unsigned n = trace.size();
+  const unsigned start_index = GetStartIndex(trace);
+  const bool closed = type == TaskFactoryType::FAI_TRIANGLE;
+  unsigned tp1_index = n * 35 / 100, tp2_index = n * 65 / 100;
+  if (closed && !FindTriangle(trace, start_index, tp1_index, tp2_index))
+    return false;
+
+  const Waypoint start = MakeWaypoint(trace[start_index], 1);
+  const Waypoint tp1 = MakeWaypoint(trace[tp1_index], 2);
+  const Waypoint tp2 = MakeWaypoint(trace[tp2_index], 3);
+  const Waypoint finish = closed
+    ? start
+    : MakeWaypoint(trace[n * 95 / 100], 4);
+
+  OrderedTask task(task_behaviour);
+  task.SetFactory(type);
+  AbstractTaskFactory &factory = task.GetFactory();
+
+  if (!Append(factory, factory.CreateStart(start)))
+    return false;
+
+  for (const Waypoint *wp : { &tp1, &tp2 }) {
+    OrderedTaskPoint *tp;
+    if (type == TaskFactoryType::AAT) {
+      tp = factory.CreateIntermediate(TaskPointFactoryType::AAT_CYLINDER, *wp);
+      ((CylinderZone &)tp->GetObservationZone()).SetRadius(fixed(10000));
+    } else if (type == TaskFactoryType::MAT)
+      tp = factory.CreateIntermediate(TaskPointFactoryType::MAT_CYLINDER, *wp);
+    else
+      tp = factory.CreateIntermediate(*wp);
+
+    if (!Append(factory, tp))
+      return false;
+  }
+
+  if (!Append(factory, factory.CreateFinish(finish)))
+    return false;
+
+  task.UpdateGeometry();
+  return task.CheckTask() && task_manager.Commit(task);
+}
+
+static bool
+LoadTask(TaskManager &task_manager, const TaskBehaviour &task_behaviour,
+         const char *path)
+{
+  std::unique_ptr<XMLNode> xml_root(XML::ParseFile(PathName(path)));
+  if (!xml_root)
+    return false;
+
+  OrderedTask task(task_behaviour);
+  LoadTask(task, ConstDataNodeXML(*xml_root), nullptr);
+  task.UpdateGeometry();
+  return task.CheckTask() && task_manager.Commit(task);
+}
+
+struct Samples {
+  std::vector<unsigned> nanoseconds, allocations;
+
+  /**
+   * Allocate space for all samples in advance, so recording them
+   * does not allocate during the measurement.
+   */
+  void Reserve(unsigned n) {
+    nanoseconds.reserve(n);
+    allocations.reserve(n);
+  }
+
+  void Report(const char *name) {
+    if (nanoseconds.empty())
+      return;
+
+    std::vector<unsigned> sorted = nanoseconds;
+    std::sort(sorted.begin(), sorted.end());
+    const unsigned n = sorted.size();
+
+    unsigned long total_allocations = 0;
+    for (unsigned a : allocations)
+      total_allocations += a;
+
+    printf("  %-14s p50 %8.2f  p99 %8.2f  max %9.2f us  "
+           "%6.2f allocs/call (max %u)\n", name,
+           sorted[n / 2] / 1000., sorted[n * 99 / 100] / 1000.,
+           sorted.back() / 1000., double(total_allocations) / n,
+           *std::max_element(allocations.begin(), allocations.end()));
+  }
+};
+
+template<typename F>
+static void
+Measure(Samples &samples, F &&f)
+{
+  const unsigned allocations = n_allocations;
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>
+    (std::chrono::steady_clock::now() - start);
+  const unsigned delta = n_allocations - allocations;
+  samples.nanoseconds.push_back(duration.count());
+  samples.allocations.push_back(delta);
+}
+
+static Samples total_update, total_idle, total_auto_mc;
+
+static void
+Append(Samples &dest, const Samples &src)
+{
+  dest.nanoseconds.insert(dest.nanoseconds.end(),
+                          src.nanoseconds.begin(), src.nanoseconds.end());
+  dest.allocations.insert(dest.allocations.end(),
+                          src.allocations.begin(), src.allocations.end());
+}
+
+/**
+ * @param type the task to lay out along the trace; ignored if
+ * #task_path is set
+ */
+static bool
+Run(const char *igc_path, const std::vector<AircraftState> &trace,
+    const char *name, TaskFactoryType type, const char *task_path=nullptr)
+{
+  TaskBehaviour task_behaviour;
+  task_behaviour.SetDefaults();
+  task_behaviour.auto_mc = true;
+
+  GlidePolar glide_polar(fixed(1));
+  glide_polar.SetBallast(fixed(1));
+
+  Waypoints waypoints;
+  TaskManager task_manager(task_behaviour, waypoints);
+  task_manager.SetGlidePolar(glide_polar);
+
+  if (task_path != nullptr
+      ? !LoadTask(task_manager, task_behaviour, task_path)
+      : !CreateTask(task_manager, task_behaviour, type, trace)) {
+    printf("%s %s: task rejected\n", igc_path, name);
+    return false;
+  }
+
+  task_manager.Resume();
+
+  Samples update, idle, auto_mc;
+  update.Reserve(trace.size());
+  idle.Reserve(trace.size());
+  auto_mc.Reserve(trace.size());
+
+  AircraftState last = trace.front();
+  for (const AircraftState &state : trace) {
+    Measure(update, [&](){ task_manager.Update(state, last); });
+    Measure(idle, [&](){ task_manager.UpdateIdle(state); });
+    Measure(auto_mc, [&](){ task_manager.UpdateAutoMC(state, fixed(0)); });
+    task_manager.SetTaskAdvance().SetArmed(true);
+    last = state;
+  }
+
+  const TaskStats &stats = task_manager.GetStats();
+  printf("%s %s: %u fixes, %s, %.1f km scored\n", igc_path, name,
+         unsigned(trace.size()),
+         stats.task_finished
+         ? "finished"
+         : (stats.start.task_started ? "started" : "not started"),
+         double(stats.distance_scored) / 1000);
+
+  update.Report("Update");
+  idle.Report("UpdateIdle");
+  auto_mc.Report("UpdateAutoMC");
+
+  Append(total_update, update);
+  Append(total_idle, idle);
+  Append(total_auto_mc, auto_mc);
+  return true;
+}
+
+static bool
+RunTrace(const char *igc_path, const char *task_path)
+{
+  const std::vector<AircraftState> trace = LoadTrace(igc_path);
+  if (trace.size() < 100) {
+    fprintf(stderr, "Failed to load %s\n", igc_path);
+    return false;
+  }
+
+  bool success = true;
+  if (task_path != nullptr)
+    success &= Run(igc_path, trace, task_path, TaskFactoryType::COUNT,
+                   task_path);
+
+  success &= Run(igc_path, trace, "racing", TaskFactoryType::RACING);
+  success &= Run(igc_path, trace, "AAT", TaskFactoryType::AAT);
+  success &= Run(igc_path, trace, "MAT", TaskFactoryType::MAT);
+
+  unsigned tp1, tp2;
+  if (FindTriangle(trace, GetStartIndex(trace), tp1, tp2))
+    success &= Run(igc_path, trace, "FAI triangle",
+                   TaskFactoryType::FAI_TRIANGLE);
+  else
+    printf("%s FAI triangle: none along the trace\n", igc_path);
+
+  return success;
+}
+
+int
+main(int argc, char **argv)
+{
+  if (argc > 3) {
+    fprintf(stderr, "Usage: %s [IGC [TSK]]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  bool success = true;
+  if (argc > 1) {
+    success = RunTrace(argv[1], argc > 2 ? argv[2] : nullptr);
+  } else {
+    success &= RunTrace("test/data/apf-bug554.igc",
+                        "test/data/apf-bug554.tsk");
+    success &= RunTrace("test/data/01lz1hq1.igc", nullptr);
+    success &= RunTrace("test/data/0asljd01.igc", nullptr);
+    success &= RunTrace("test/data/9crx3101.igc", nullptr);
+  }
+
+  printf("all scenarios\n");
+  total_update.Report("Update");
+  total_idle.Report("UpdateIdle");
+  total_auto_mc.Report("UpdateAutoMC");
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
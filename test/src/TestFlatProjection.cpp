@@ -0,0 +1,125 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2015 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Geo/Flat/FlatProjection.hpp"
+#include "Geo/Flat/FlatGeoPoint.hpp"
+#include "Geo/Flat/FlatPoint.hpp"
+#include "Geo/SearchPointVector.hpp"
+#include "Util/Macros.hpp"
+#include "TestUtil.hpp"
+
+#include <stdlib.h>
+
+static constexpr unsigned N_POINTS = 101;
+
+static GeoPoint
+RandomPoint(const GeoPoint &center)
+{
+  /* up to 3 degrees east/west and 2 degrees north/south */
+  const Angle longitude = center.longitude +
+    Angle::Degrees(fixed(rand() % 6001 - 3000) / 1000);
+  const Angle latitude = center.latitude +
+    Angle::Degrees(fixed(rand() % 4001 - 2000) / 1000);
+  return GeoPoint(longitude.AsDelta(), latitude);
+}
+
+static void
+TestBulk(const GeoPoint &center)
+{
+  const FlatProjection projection(center);
+
+  GeoPoint src[N_POINTS];
+  for (auto &i : src)
+    i = RandomPoint(center);
+
+  FlatGeoPoint flat[N_POINTS];
+  projection.ProjectInteger(src, flat, N_POINTS);
+
+  FlatPoint flat_float[N_POINTS];
+  projection.ProjectFloat(src, flat_float, N_POINTS);
+
+  bool integer_equal = true, float_equal = true, within_one = true;
+  bool round_trip = true;
+  for (unsigned i = 0; i < N_POINTS; ++i) {
+    const FlatGeoPoint expected = projection.ProjectInteger(src[i]);
+    integer_equal &= flat[i] == expected;
+
+    const FlatPoint expected_float = projection.ProjectFloat(src[i]);
+    float_equal &= flat_float[i].x == expected_float.x &&
+      flat_float[i].y == expected_float.y;
+
+    /* the integer projection may calculate in single precision */
+    within_one &= abs(flat[i].longitude - iround(expected_float.x)) <= 1 &&
+      abs(flat[i].latitude - iround(expected_float.y)) <= 1;
+
+    round_trip &= projection.Unproject(flat[i]).DistanceS(src[i]) <
+      projection.GetApproximateScale();
+  }
+
+  ok1(integer_equal);
+  ok1(float_equal);
+  ok1(within_one);
+  ok1(round_trip);
+
+  /* the scalar remainder of the SIMD loops */
+  FlatGeoPoint one;
+  projection.ProjectInteger(src, &one, 1);
+  ok1(one == projection.ProjectInteger(src[0]));
+
+  /* SearchPointVector::Project() uses the bulk projection in chunks */
+  SearchPointVector spv;
+  for (const auto &i : src)
+    spv.push_back(SearchPoint(i));
+  for (unsigned i = 0; i < 100; ++i)
+    spv.push_back(SearchPoint(src[i % N_POINTS]));
+
+  spv.Project(projection);
+
+  bool spv_equal = true;
+  for (unsigned i = 0; i < spv.size(); ++i)
+    spv_equal &= spv[i].GetFlatLocation() ==
+      projection.ProjectInteger(src[i % N_POINTS]) &&
+      spv[i].GetLocation() == src[i % N_POINTS];
+  ok1(spv_equal);
+}
+
+int main(int argc, char **argv)
+{
+  static const GeoPoint centers[] = {
+    GeoPoint(Angle::Degrees(7.7061111111111114),
+             Angle::Degrees(51.051944444444445)),
+    GeoPoint::Zero(),
+    /* the points wrap around the date line */
+    GeoPoint(Angle::Degrees(179.9), Angle::Degrees(-33.8)),
+    GeoPoint(Angle::Degrees(-179.95), Angle::Degrees(10)),
+    GeoPoint(Angle::Degrees(-120), Angle::Degrees(70)),
+  };
+
+  plan_tests(ARRAY_SIZE(centers) * 6);
+
+  srand(42);
+
+  for (const auto &center : centers)
+    TestBulk(center);
+
+  return exit_status();
+}
@@ -0,0 +1,174 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Feeds frames into #FrameDamage, with a memory-mapped temporary
+ * file acting as the frame buffer.
+ */
+
+#include "Screen/FB/FrameDamage.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+
+#include <sys/mman.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static constexpr unsigned WIDTH = 600, HEIGHT = 800;
+
+/* the frame buffer has a larger pitch than the frame, like on some
+   Kobo models */
+static constexpr unsigned FB_PITCH = 608;
+
+static uint8_t frame[WIDTH * HEIGHT];
+
+static void
+FillRect(unsigned left, unsigned top, unsigned right, unsigned bottom,
+         uint8_t value)
+{
+  for (unsigned y = top; y < bottom; ++y)
+    std::fill_n(frame + y * WIDTH + left, right - left, value);
+}
+
+/**
+ * Does the frame buffer file contain exactly the frame?
+ */
+static bool
+CheckFile(int fd)
+{
+  uint8_t row[FB_PITCH];
+
+  for (unsigned y = 0; y < HEIGHT; ++y) {
+    if (pread(fd, row, FB_PITCH, y * FB_PITCH) != (ssize_t)FB_PITCH)
+      return false;
+
+    if (memcmp(row, frame + y * WIDTH, WIDTH) != 0)
+      return false;
+  }
+
+  return true;
+}
+
+static bool
+Contains(const PixelRect &rc, unsigned left, unsigned top,
+         unsigned right, unsigned bottom)
+{
+  return rc.left <= int(left) && rc.top <= int(top) &&
+    rc.right >= int(right) && rc.bottom >= int(bottom);
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(20);
+
+  char path[] = "/tmp/TestFrameDamage.XXXXXX";
+  const int fd = mkstemp(path);
+  if (fd < 0 || ftruncate(fd, FB_PITCH * HEIGHT) < 0) {
+    perror("Failed to create the frame buffer file");
+    return EXIT_FAILURE;
+  }
+
+  unlink(path);
+
+  uint8_t *fb = (uint8_t *)mmap(nullptr, FB_PITCH * HEIGHT,
+                                PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+  if (fb == (uint8_t *)MAP_FAILED) {
+    perror("mmap() failed");
+    return EXIT_FAILURE;
+  }
+
+  FrameDamage damage;
+  damage.Resize(WIDTH, HEIGHT);
+
+  PixelRect rects[FrameDamage::MAX_RECTS];
+
+  /* the first frame is copied completely, as a full refresh */
+  std::fill_n(frame, WIDTH * HEIGHT, 0xff);
+  unsigned n = damage.Update(frame, WIDTH, fb, FB_PITCH, rects);
+  ok1(n == 1);
+  ok1(Contains(rects[0], 0, 0, WIDTH, HEIGHT));
+  ok1(damage.CheckFullRefresh(rects, n));
+  ok1(CheckFile(fd));
+
+  /* nothing has changed */
+  n = damage.Update(frame, WIDTH, fb, FB_PITCH, rects);
+  ok1(n == 0);
+  ok1(!damage.CheckFullRefresh(rects, n));
+
+  /* a small change, e.g. an InfoBox value */
+  FillRect(13, 20, 50, 40, 0x00);
+  n = damage.Update(frame, WIDTH, fb, FB_PITCH, rects);
+  ok1(n == 1);
+  ok1(Contains(rects[0], 13, 20, 50, 40));
+  ok1(rects[0].left % FrameDamage::ALIGN == 0 &&
+      rects[0].right % FrameDamage::ALIGN == 0);
+  ok1(rects[0].right - rects[0].left <= 48 &&
+      rects[0].bottom - rects[0].top == 20);
+  ok1(!damage.CheckFullRefresh(rects, n));
+  ok1(CheckFile(fd));
+
+  /* two distant changes become two regions */
+  FillRect(100, 100, 120, 120, 0x80);
+  FillRect(300, 700, 310, 710, 0x80);
+  n = damage.Update(frame, WIDTH, fb, FB_PITCH, rects);
+  ok1(n == 2);
+  ok1(n == 2 && Contains(rects[0], 100, 100, 120, 120) &&
+      Contains(rects[1], 300, 700, 310, 710));
+  ok1(CheckFile(fd));
+
+  /* many changes are merged into no more than MAX_RECTS regions */
+  for (unsigned y = 0; y < HEIGHT; y += 2 * FrameDamage::MERGE_GAP)
+    FillRect(0, y, WIDTH, y + 1, 0x40);
+  n = damage.Update(frame, WIDTH, fb, FB_PITCH, rects);
+  ok1(n == FrameDamage::MAX_RECTS);
+  ok1(CheckFile(fd));
+
+  /* lots of partial updates trigger a full refresh */
+  unsigned partial = 0;
+  for (unsigned i = 0; i < 2 * FrameDamage::FULL_REFRESH_INTERVAL; ++i) {
+    frame[7] = i;
+    n = damage.Update(frame, WIDTH, fb, FB_PITCH, rects);
+    if (damage.CheckFullRefresh(rects, n))
+      break;
+
+    ++partial;
+  }
+
+  ok1(partial < FrameDamage::FULL_REFRESH_INTERVAL);
+
+  /* after Invalidate(), everything is copied again */
+  memset(fb, 0, FB_PITCH * HEIGHT);
+  damage.Invalidate();
+  n = damage.Update(frame, WIDTH, fb, FB_PITCH, rects);
+  ok1(n == 1);
+  ok1(CheckFile(fd));
+
+  munmap(fb, FB_PITCH * HEIGHT);
+  close(fd);
+
+  return exit_status();
+}
@@ -0,0 +1,118 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2015 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Geo/SpeedVector.hpp"
+#include "Engine/GlideSolvers/GlideSettings.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Engine/GlideSolvers/GlideState.hpp"
+#include "Engine/GlideSolvers/GlideResult.hpp"
+#include "Engine/GlideSolvers/GlideBatch.hpp"
+#include "Engine/GlideSolvers/MacCready.hpp"
+
+#ifdef FIXED_MATH
+#define ACCURACY 1000
+#endif
+
+#include "TestUtil.hpp"
+
+#include <vector>
+
+static GlideSettings glide_settings;
+static GlidePolar glide_polar(fixed(0));
+
+/**
+ * Compare the batch solver with MacCready::SolveStraight() for many
+ * destinations.  The number of destinations is odd, so both the SIMD
+ * and the scalar code paths are used.
+ */
+static void
+TestWind(const SpeedVector &wind)
+{
+  static constexpr fixed distances[] = { fixed(0), fixed(1000), fixed(100000) };
+  static constexpr fixed altitudes[] = { fixed(-300), fixed(1500) };
+
+  GlideBatch batch;
+  std::vector<GlideState> states;
+
+  for (unsigned bearing = 0; bearing < 360; bearing += 40) {
+    for (const fixed distance : distances) {
+      for (const fixed altitude : altitudes) {
+        if (!positive(distance) && negative(altitude))
+          /* the batch solver doesn't climb */
+          continue;
+
+        const GeoVector vector(distance, Angle::Degrees(bearing));
+        states.emplace_back(vector, fixed(1000), fixed(1000) + altitude,
+                            wind);
+        batch.Add(vector, altitude);
+      }
+    }
+  }
+
+  const MacCready mac_cready(glide_settings, glide_polar);
+  mac_cready.SolveStraight(batch, wind);
+
+  ok1(batch.size() == states.size());
+
+  for (unsigned i = 0; i < states.size(); ++i) {
+    const GlideResult result = mac_cready.SolveStraight(states[i]);
+
+    ok1(batch.IsOk(i) == result.IsOk());
+    ok1(!result.IsOk() ||
+        equals(batch.GetAltitudeDifference(i),
+               result.pure_glide_altitude_difference));
+    ok1(!result.IsOk() ||
+        equals(batch.GetTimeElapsed(i), result.time_elapsed));
+  }
+}
+
+static void
+TestAll()
+{
+  TestWind(SpeedVector(Angle::Zero(), fixed(0)));
+  TestWind(SpeedVector(Angle::Degrees(10), fixed(5)));
+  TestWind(SpeedVector(Angle::Degrees(135), fixed(15)));
+  TestWind(SpeedVector(Angle::Degrees(270), fixed(40)));
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(5 * 4 * (1 + 45 * 3));
+
+  glide_settings.SetDefaults();
+
+  TestAll();
+
+  glide_polar.SetMC(fixed(0.1));
+  TestAll();
+
+  glide_polar.SetMC(fixed(1));
+  TestAll();
+
+  glide_polar.SetMC(fixed(4));
+  TestAll();
+
+  glide_polar.SetMC(fixed(10));
+  TestAll();
+
+  return exit_status();
+}
@@ -0,0 +1,325 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2015 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Screen/Font.hpp"
+#include "Screen/Debug.hpp"
+#include "Screen/FreeType/GlyphCache.hpp"
+#include "Screen/FreeType/GlyphPacker.hpp"
+#include "Screen/FreeType/Init.hpp"
+#include "Screen/Custom/Files.hpp"
+#include "Util/UTF8.hpp"
+#include "Util/Macros.hpp"
+#include "TestUtil.hpp"
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <algorithm>
+#include <memory>
+
+#include <stdlib.h>
+#include <string.h>
+
+static constexpr unsigned FONT_SIZE = 24;
+
+static const char *const strings[] = {
+  "",
+  "0",
+  "1234.5",
+  "AVAV Wolf",
+  "Tätä öü",
+  "  -12:34  ",
+};
+
+static constexpr int
+Floor(FT_Long x)
+{
+  return (x & -64) / 64;
+}
+
+static constexpr int
+Ceil(FT_Long x)
+{
+  return Floor(x + 63);
+}
+
+/**
+ * Lay out and render the string with FreeType directly, glyph by
+ * glyph, like the text renderer did before #GlyphCache existed.
+ *
+ * @param buffer the destination buffer (one byte per pixel) or
+ * nullptr
+ * @return the width of the text
+ */
+static unsigned
+ReferenceLayout(FT_Face face, unsigned ascent_height, const char *text,
+                uint8_t *buffer, unsigned buffer_width,
+                unsigned buffer_height)
+{
+  const bool use_kerning = FT_HAS_KERNING(face);
+
+  int x = 0, max_x = 0;
+  FT_UInt previous = 0;
+
+  while (true) {
+    const auto n = NextUTF8(text);
+    if (n.first == 0)
+      break;
+
+    text = n.second;
+
+    const FT_UInt i = FT_Get_Char_Index(face, n.first);
+    if (i == 0 || FT_Load_Glyph(face, i, FT_LOAD_DEFAULT) != 0)
+      continue;
+
+    const FT_GlyphSlot glyph = face->glyph;
+    const FT_Glyph_Metrics &metrics = glyph->metrics;
+
+    if (use_kerning) {
+      if (previous != 0) {
+        FT_Vector delta;
+        FT_Get_Kerning(face, previous, i, ft_kerning_default, &delta);
+        x += delta.x >> 6;
+      }
+
+      previous = i;
+    }
+
+    const int left = x + Floor(metrics.horiBearingX);
+    const int top = int(ascent_height) - Floor(metrics.horiBearingY);
+    max_x = std::max(max_x, left + Floor(metrics.horiBearingX)
+                     + Ceil(metrics.width));
+
+    if (buffer != nullptr &&
+        FT_Render_Glyph(glyph, FT_RENDER_MODE_NORMAL) == 0) {
+      const FT_Bitmap &bitmap = glyph->bitmap;
+      for (int row = 0; row < int(bitmap.rows); ++row) {
+        const int dest_y = top + row;
+        if (dest_y < 0 || dest_y >= int(buffer_height))
+          continue;
+
+        for (int column = 0; column < int(bitmap.width); ++column) {
+          const int dest_x = left + column;
+          if (dest_x < 0 || dest_x >= int(buffer_width))
+            continue;
+
+          buffer[dest_y * buffer_width + dest_x] |=
+            bitmap.buffer[row * bitmap.pitch + column];
+        }
+      }
+    }
+
+    x += Ceil(metrics.horiAdvance);
+  }
+
+  return max_x;
+}
+
+static void
+TestFont(const Font &font, FT_Face reference)
+{
+  /* the second round is served from the cache */
+  for (unsigned round = 0; round < 2; ++round) {
+    for (const char *text : strings) {
+      const PixelSize size = font.TextSize(text);
+      const unsigned width = ReferenceLayout(reference,
+                                             font.GetAscentHeight(), text,
+                                             nullptr, 0, 0);
+      ok(size.cx == width && size.cy == font.GetHeight(),
+         "TextSize(\"%s\")", text);
+
+      /* render a little wider than needed to see stray pixels */
+      const PixelSize buffer_size = { size.cx + 4, size.cy };
+      const size_t buffer_length = Font::BufferSize(buffer_size);
+      std::unique_ptr<uint8_t[]> actual(new uint8_t[buffer_length]);
+      std::unique_ptr<uint8_t[]> expected(new uint8_t[buffer_length]());
+
+      font.Render(text, buffer_size, actual.get());
+      ReferenceLayout(reference, font.GetAscentHeight(), text,
+                      expected.get(), buffer_size.cx, buffer_size.cy);
+      ok(memcmp(actual.get(), expected.get(), buffer_length) == 0,
+         "Render(\"%s\")", text);
+    }
+  }
+}
+
+static void
+TestPacker()
+{
+  constexpr unsigned size = 64;
+  GlyphPacker packer(size);
+
+  struct Rect {
+    GlyphPacker::Slot slot;
+    unsigned width, height;
+  } rects[256];
+
+  unsigned n = 0;
+  for (; n < ARRAY_SIZE(rects); ++n) {
+    Rect &r = rects[n];
+    r.width = 1 + rand() % 12;
+    r.height = 1 + rand() % 12;
+    if (!packer.Allocate(r.slot, r.width, r.height))
+      break;
+  }
+
+  ok1(n > 10 && n < ARRAY_SIZE(rects));
+
+  bool inside = true, disjoint = true, valid = true;
+  for (unsigned i = 0; i < n; ++i) {
+    const Rect &a = rects[i];
+    valid &= packer.IsValid(a.slot);
+    inside &= a.slot.x + a.width <= size && a.slot.y + a.height <= size;
+
+    for (unsigned j = i + 1; j < n; ++j) {
+      const Rect &b = rects[j];
+      if (a.slot.x < b.slot.x + b.width && b.slot.x < a.slot.x + a.width &&
+          a.slot.y < b.slot.y + b.height && b.slot.y < a.slot.y + a.height)
+        disjoint = false;
+    }
+  }
+
+  ok1(valid);
+  ok1(inside);
+  ok1(disjoint);
+
+  /* clearing invalidates all slots and makes room again */
+  packer.Clear();
+  ok1(!packer.IsValid(rects[0].slot));
+
+  GlyphPacker::Slot slot;
+  ok1(packer.Allocate(slot, size - 1, size - 1));
+  ok1(slot.x == 0 && slot.y == 0 && packer.IsValid(slot));
+  ok1(!packer.Allocate(slot, 1, 1));
+
+  /* a bitmap which doesn't fit into the empty texture */
+  packer.Clear();
+  ok1(!packer.Allocate(slot, size, 1));
+}
+
+/**
+ * An atlas which has room for a fixed number of glyphs, and counts
+ * the calls from GlyphCache::AddToAtlas().
+ */
+class FakeAtlas {
+  const unsigned capacity;
+  unsigned n_glyphs = 0, generation = 1;
+
+public:
+  unsigned n_added = 0, n_cleared = 0;
+
+  explicit FakeAtlas(unsigned _capacity):capacity(_capacity) {}
+
+  bool IsValid(const GlyphPacker::Slot &slot) const {
+    return slot.generation == generation;
+  }
+
+  bool Add(GlyphPacker::Slot &slot, unsigned width, unsigned height,
+           const uint8_t *data) {
+    if (n_glyphs >= capacity)
+      return false;
+
+    slot.generation = generation;
+    ++n_glyphs;
+    ++n_added;
+    return true;
+  }
+
+  void Clear() {
+    n_glyphs = 0;
+    ++generation;
+    ++n_cleared;
+  }
+};
+
+static void
+TestAtlas(GlyphCache &glyphs)
+{
+  FakeAtlas atlas(12);
+
+  /* spaces have no bitmap and need no slot */
+  ok1(glyphs.AddToAtlas("   ", atlas));
+  ok1(atlas.n_added == 0);
+
+  /* each distinct glyph is added once */
+  ok1(glyphs.AddToAtlas("0123456789 1111", atlas));
+  ok1(atlas.n_added == 10 && atlas.n_cleared == 0);
+  ok1(glyphs.AddToAtlas("9876543210", atlas));
+  ok1(atlas.n_added == 10 && atlas.n_cleared == 0);
+
+  /* when the atlas runs full (after two more glyphs), it is cleared
+     and refilled with the glyphs of this string only */
+  ok1(glyphs.AddToAtlas("ABCDEFGH", atlas));
+  ok1(atlas.n_cleared == 1 && atlas.n_added == 10 + 2 + 8);
+  ok1(!atlas.IsValid(glyphs.Get('0').slot));
+  ok1(atlas.IsValid(glyphs.Get('A').slot) &&
+      atlas.IsValid(glyphs.Get('H').slot));
+
+  /* a string which doesn't fit into the empty atlas */
+  ok1(!glyphs.AddToAtlas("0123456789ABCDEFGH", atlas));
+  ok1(atlas.n_cleared == 3);
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(4 * ARRAY_SIZE(strings) + 9 + 12);
+
+  TestPacker();
+
+  Font::Initialise();
+  ScreenInitialized();
+
+  /* use the font given on the command line, or the one the
+     application would use */
+  char *path = argc > 1
+    ? strdup(argv[1])
+    : FindDefaultFont();
+
+  Font font;
+  FT_Face reference = path != nullptr
+    ? FreeType::Load(path)
+    : nullptr;
+
+  if (reference == nullptr ||
+      FT_Set_Pixel_Sizes(reference, 0, FONT_SIZE) != 0 ||
+      !font.LoadFile(path, FONT_SIZE)) {
+    skip(4 * ARRAY_SIZE(strings) + 12, 1, "No font found");
+  } else {
+    TestFont(font, reference);
+    TestAtlas(font.GetGlyphCache());
+  }
+
+  font.Destroy();
+  if (reference != nullptr)
+    FT_Done_Face(reference);
+
+  if (argc > 1)
+    free(path);
+  else
+    delete[] path;
+
+  ScreenDeinitialized();
+  Font::Deinitialise();
+
+  return exit_status();
+}
@@ -0,0 +1,154 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2015 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+/*
+ * Stress test for the IOThread: several pseudo-terminals emulate
+ * devices which flood the ports with data at the same time, and all
+ * of it must arrive in the DataHandlers.
+ */
+
+#include "Device/Port/TTYPort.hpp"
+#include "IO/Async/GlobalIOThread.hpp"
+#include "IO/DataHandler.hpp"
+#include "OS/Clock.hpp"
+#include "OS/Sleep.h"
+#include "TestUtil.hpp"
+
+#include <atomic>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <stdio.h>
+#include <stdint.h>
+
+static constexpr unsigned N_PORTS = 5;
+static constexpr size_t N_BYTES = 256 * 1024;
+
+class CountingHandler : public DataHandler {
+public:
+  std::atomic<size_t> n_bytes;
+  std::atomic<unsigned> checksum;
+
+  CountingHandler():n_bytes(0), checksum(0) {}
+
+  virtual void DataReceived(const void *data, size_t length) {
+    const uint8_t *p = (const uint8_t *)data;
+    unsigned sum = 0;
+    for (size_t i = 0; i < length; ++i)
+      sum += p[i];
+
+    checksum += sum;
+    n_bytes += length;
+  }
+};
+
+/**
+ * Open the slave side of a pseudo-terminal in raw mode, so the line
+ * discipline passes all bytes unmodified to the master.
+ */
+static int
+OpenFakeDevice(const char *path)
+{
+  int fd = open(path, O_WRONLY|O_NOCTTY);
+  if (fd < 0)
+    return -1;
+
+  struct termios attr;
+  if (tcgetattr(fd, &attr) < 0) {
+    close(fd);
+    return -1;
+  }
+
+  cfmakeraw(&attr);
+  tcsetattr(fd, TCSANOW, &attr);
+  return fd;
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(3 * N_PORTS + 1);
+
+  InitialiseIOThread();
+
+  CountingHandler handlers[N_PORTS];
+  TTYPort *ports[N_PORTS];
+  int devices[N_PORTS];
+
+  for (unsigned i = 0; i < N_PORTS; ++i) {
+    ports[i] = new TTYPort(nullptr, handlers[i]);
+    const char *slave = ports[i]->OpenPseudo();
+    devices[i] = slave != nullptr ? OpenFakeDevice(slave) : -1;
+    ok1(devices[i] >= 0);
+    ports[i]->StartRxThread();
+  }
+
+  const unsigned start = MonotonicClockMS();
+
+  /* write to all devices interleaved, in chunks of the typical size
+     of a burst of NMEA sentences */
+  uint8_t chunk[256];
+  unsigned expected_checksum = 0;
+  for (size_t i = 0; i < sizeof(chunk); ++i) {
+    chunk[i] = uint8_t(i);
+    expected_checksum += chunk[i];
+  }
+
+  expected_checksum *= N_BYTES / sizeof(chunk);
+
+  for (size_t offset = 0; offset < N_BYTES; offset += sizeof(chunk))
+    for (unsigned i = 0; i < N_PORTS; ++i)
+      if (devices[i] >= 0 &&
+          write(devices[i], chunk, sizeof(chunk)) != (ssize_t)sizeof(chunk))
+        break;
+
+  /* wait for the IOThread to catch up */
+  bool complete = false;
+  for (unsigned timeout = 0; !complete && timeout < 1000; ++timeout) {
+    complete = true;
+    for (unsigned i = 0; i < N_PORTS; ++i)
+      if (handlers[i].n_bytes < N_BYTES)
+        complete = false;
+
+    if (!complete)
+      Sleep(10);
+  }
+
+  ok1(complete);
+
+  printf("# received %u bytes on %u ports in %u ms\n",
+         unsigned(N_BYTES * N_PORTS), N_PORTS,
+         MonotonicClockMS() - start);
+
+  for (unsigned i = 0; i < N_PORTS; ++i) {
+    ok1(handlers[i].n_bytes == N_BYTES);
+    ok1(handlers[i].checksum == expected_checksum);
+
+    close(devices[i]);
+    delete ports[i];
+  }
+
+  DeinitialiseIOThread();
+
+  return exit_status();
+}
@@ -0,0 +1,122 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Computer/IdleScheduler.hpp"
+#include "TestUtil.hpp"
+
+static void
+TestCritical()
+{
+  IdleScheduler scheduler(1000);
+
+  /* never run: everything is due */
+  ok1(scheduler.IsDue(IdleScheduler::CONTEST, 2000, 5000));
+
+  for (unsigned i = 0; i < IdleScheduler::COUNT; ++i)
+    scheduler.Done(IdleScheduler::Item(i), 1000, 1100);
+
+  /* budget exhausted: only critical items are still due */
+  ok1(scheduler.IsDue(IdleScheduler::AIRSPACE, 2000, 5000));
+  ok1(scheduler.IsDue(IdleScheduler::LOGGER, 2000, 5000));
+  ok1(scheduler.IsDue(IdleScheduler::STATISTICS, 2000, 5000));
+  ok1(!scheduler.IsDue(IdleScheduler::TASK, 2000, 5000));
+  ok1(!scheduler.IsDue(IdleScheduler::CONTEST, 2000, 5000));
+
+  /* ... unless the cycle is exhaustive */
+  ok1(scheduler.IsDue(IdleScheduler::CONTEST, 2000, 5000, true));
+
+  /* budget left */
+  ok1(scheduler.IsDue(IdleScheduler::CONTEST, 2000, 2100));
+}
+
+static void
+TestEstimate()
+{
+  IdleScheduler scheduler(1000);
+
+  /* the contest item took 800us last time; it doesn't fit into a
+     cycle which has already used 300us */
+  scheduler.Done(IdleScheduler::CONTEST, 1000, 1800);
+  ok1(scheduler.IsDue(IdleScheduler::CONTEST, 2000, 2100));
+  ok1(!scheduler.IsDue(IdleScheduler::CONTEST, 2000, 2300));
+}
+
+static void
+TestDeadline()
+{
+  IdleScheduler scheduler(1000);
+
+  const uint64_t deadline =
+    IdleScheduler::GetInfo(IdleScheduler::CONTEST).deadline_us;
+
+  scheduler.Done(IdleScheduler::CONTEST, 1000, 2000);
+  ok1(!scheduler.IsDue(IdleScheduler::CONTEST, 2000, 4000));
+
+  /* overdue: run regardless of the budget */
+  ok1(!scheduler.IsDue(IdleScheduler::CONTEST, 1000 + deadline - 10000,
+                       1000 + deadline - 1));
+  ok1(scheduler.IsDue(IdleScheduler::CONTEST, 1000 + deadline - 10000,
+                      1000 + deadline));
+}
+
+static void
+TestStats()
+{
+  IdleScheduler scheduler;
+
+  const IdleScheduler::ItemStats &stats =
+    scheduler.GetStats(IdleScheduler::TASK);
+  const unsigned budget =
+    IdleScheduler::GetInfo(IdleScheduler::TASK).budget_us;
+
+  scheduler.Done(IdleScheduler::TASK, 1000, 1100);
+  scheduler.Done(IdleScheduler::TASK, 2000, 2000 + budget + 1);
+  scheduler.Done(IdleScheduler::TASK, 3000, 3200);
+  scheduler.Skip(IdleScheduler::TASK);
+
+  ok1(stats.runs == 3);
+  ok1(stats.skips == 1);
+  ok1(stats.overruns == 1);
+  ok1(stats.last_us == 200);
+  ok1(stats.max_us == budget + 1);
+  ok1(stats.total_us == 100 + budget + 1 + 200);
+  ok1(stats.GetAverageUS() == (100 + budget + 1 + 200) / 3);
+  ok1(stats.last_run == 3000);
+
+  scheduler.Reset();
+  ok1(stats.runs == 0);
+  ok1(stats.last_run == 0);
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(23);
+
+  TestCritical();
+  TestEstimate();
+  TestDeadline();
+  TestStats();
+
+  return exit_status();
+}
@@ -0,0 +1,246 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2015 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+/*
+ * Compare the SSE2 pixel operations with the portable ones.  The
+ * rows are long enough for several whole SIMD blocks, and all row
+ * lengths up to that are tested, so every possible remainder is
+ * handled by the portable code after the blocks.
+ */
+
+#include "Screen/Memory/PixelTraits.hpp"
+#include "Screen/Memory/PixelOperations.hpp"
+#include "Screen/Memory/Optimised.hpp"
+#include "Screen/Memory/RasterCanvas.hpp"
+#include "TestUtil.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+
+/* four whole greyscale blocks plus the largest remainder */
+static constexpr unsigned MAX_PIXELS = 4 * 16 + 15;
+
+/* pixels after the end of the row which must not be modified */
+static constexpr unsigned GUARD = 16;
+
+/* room for an unaligned start, a row scaled by 2 and the guard */
+static constexpr unsigned ROW_SIZE = 1 + 2 * MAX_PIXELS + GUARD;
+
+static constexpr uint8_t alphas[] = { 0, 1, 0x60, 0x80, 0xfe, 0xff };
+static constexpr unsigned N_ALPHAS = sizeof(alphas) / sizeof(alphas[0]);
+
+/**
+ * The number of pixels processed by one iteration of the SSE2
+ * kernel.
+ */
+template<typename PixelTraits>
+struct SSE2Block;
+
+template<>
+struct SSE2Block<GreyscalePixelTraits> {
+  static constexpr unsigned SIZE = 16;
+};
+
+template<>
+struct SSE2Block<BGRAPixelTraits> {
+  static constexpr unsigned SIZE = 4;
+};
+
+template<typename PixelTraits>
+struct Row {
+  typedef typename PixelTraits::color_type color_type;
+
+  color_type pixels[ROW_SIZE];
+
+  void Randomise() {
+    uint8_t *p = (uint8_t *)pixels;
+    for (unsigned i = 0; i < sizeof(pixels); ++i)
+      p[i] = rand();
+  }
+
+  /**
+   * Compare with the expected row.  The SIMD kernels round
+   * differently from the portable code (like the MMX kernels do), so
+   * the channels of the pixels in [begin, end) may differ by one.
+   * All other pixels must match exactly.
+   */
+  bool Check(const Row<PixelTraits> &expected,
+             unsigned begin, unsigned end) const {
+    const uint8_t *a = (const uint8_t *)pixels;
+    const uint8_t *b = (const uint8_t *)expected.pixels;
+
+    for (unsigned i = 0; i < sizeof(pixels); ++i) {
+      const unsigned pixel = i / sizeof(color_type);
+      const int delta = int(a[i]) - int(b[i]);
+      const int tolerance = pixel >= begin && pixel < end ? 1 : 0;
+      if (delta < -tolerance || delta > tolerance)
+        return false;
+    }
+
+    return true;
+  }
+};
+
+template<typename PixelTraits>
+static typename PixelTraits::color_type
+RandomColor()
+{
+  Row<PixelTraits> row;
+  row.Randomise();
+  return row.pixels[0];
+}
+
+/**
+ * Run the given operation on the portable and on the optimised
+ * #AlphaPixelOperations, for all row lengths up to #MAX_PIXELS, on
+ * an aligned and on an unaligned start.
+ *
+ * @param f a function which gets the operations object and a pointer
+ * to the row
+ */
+template<typename PixelTraits, typename F>
+static bool
+CompareAlpha(const char *name, uint8_t alpha, F f)
+{
+  const PortableAlphaPixelOperations<PixelTraits> portable(alpha);
+  const AlphaPixelOperations<PixelTraits> optimised(alpha);
+  constexpr unsigned BLOCK = SSE2Block<PixelTraits>::SIZE;
+
+  for (unsigned offset = 0; offset < 2; ++offset) {
+    for (unsigned n = 0; n <= MAX_PIXELS; ++n) {
+      Row<PixelTraits> expected, actual;
+      expected.Randomise();
+      actual = expected;
+
+      const auto color = RandomColor<PixelTraits>();
+      f(portable, expected.pixels + offset, n, color);
+      f(optimised, actual.pixels + offset, n, color);
+
+      if (!actual.Check(expected, offset, offset + n / BLOCK * BLOCK)) {
+        diag("%s alpha=%u offset=%u n=%u", name, alpha, offset, n);
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+struct FillOperation {
+  template<typename Operations, typename color_type>
+  void operator()(const Operations &operations,
+                  color_type *p, unsigned n, color_type color) const {
+    operations.FillPixels(p, n, color);
+  }
+};
+
+template<typename PixelTraits>
+struct CopyOperation {
+  typedef typename PixelTraits::color_type color_type;
+
+  const color_type *src;
+
+  template<typename Operations>
+  void operator()(const Operations &operations,
+                  color_type *p, unsigned n, color_type) const {
+    operations.CopyPixels(p, src, n);
+  }
+};
+
+template<typename PixelTraits>
+static void
+TestAlpha()
+{
+  Row<PixelTraits> src;
+  src.Randomise();
+
+  /* start the source at a different offset, to have the source and
+     the destination misaligned relative to each other */
+  const CopyOperation<PixelTraits> copy{src.pixels + 3};
+
+  for (unsigned i = 0; i < N_ALPHAS; ++i) {
+    const uint8_t alpha = alphas[i];
+
+    ok1(CompareAlpha<PixelTraits>("fill", alpha, FillOperation()));
+    ok1(CompareAlpha<PixelTraits>("copy", alpha, copy));
+  }
+}
+
+/**
+ * Compare RasterCanvas::ScalePixels() by exactly 2, which uses the
+ * SSE2 kernel, with a trivial implementation.
+ */
+template<typename PixelTraits>
+static bool
+TestScaleTwice()
+{
+  const RasterCanvas<PixelTraits>
+    canvas(WritableImageBuffer<PixelTraits>::Empty());
+
+  Row<PixelTraits> src;
+  src.Randomise();
+
+  for (unsigned offset = 0; offset < 2; ++offset) {
+    for (unsigned n = 0; n <= MAX_PIXELS; ++n) {
+      Row<PixelTraits> expected, actual;
+      expected.Randomise();
+      actual = expected;
+
+      for (unsigned i = 0; i < n; ++i)
+        expected.pixels[offset + 2 * i] =
+          expected.pixels[offset + 2 * i + 1] = src.pixels[i];
+
+      canvas.ScalePixels(actual.pixels + offset, 2 * n, src.pixels, n,
+                         PixelTraits());
+
+      if (!actual.Check(expected, 0, 0)) {
+        diag("scale offset=%u n=%u", offset, n);
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+#endif
+
+int
+main(int argc, char **argv)
+{
+#ifdef __SSE2__
+  plan_tests(2 * (2 * N_ALPHAS + 1));
+
+  TestAlpha<GreyscalePixelTraits>();
+  ok1(TestScaleTwice<GreyscalePixelTraits>());
+
+  TestAlpha<BGRAPixelTraits>();
+  ok1(TestScaleTwice<BGRAPixelTraits>());
+#else
+  plan_skip_all((char *)"no SSE2");
+#endif
+
+  return exit_status();
+}
@@ -0,0 +1,182 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2015 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Geo/SearchPointVector.hpp"
+#include "TestUtil.hpp"
+
+#include <stdlib.h>
+
+static constexpr unsigned N_POINTS = 500;
+static constexpr unsigned CHECK_INTERVAL = 50;
+
+static GeoPoint
+RandomWalk(GeoPoint &location)
+{
+  /* wander around within a 0.1 degree box, like a glider circling in
+     an AAT sector */
+  const GeoPoint centre(Angle::Degrees(7), Angle::Degrees(51));
+  location.longitude += Angle::Degrees((rand() % 201 - 100) * 0.0002);
+  location.latitude += Angle::Degrees((rand() % 201 - 100) * 0.0002);
+  if ((location.longitude - centre.longitude).Absolute() > Angle::Degrees(0.05))
+    location.longitude = centre.longitude;
+  if ((location.latitude - centre.latitude).Absolute() > Angle::Degrees(0.05))
+    location.latitude = centre.latitude;
+  return location;
+}
+
+static fixed
+Cross(const GeoPoint &p0, const GeoPoint &p1, const GeoPoint &p2)
+{
+  return ((p1.longitude - p0.longitude) * (p2.latitude - p0.latitude)
+          - (p2.longitude - p0.longitude) * (p1.latitude - p0.latitude)).Native();
+}
+
+/**
+ * Twice the area of a closed polygon; positive if counter-clockwise.
+ */
+static fixed
+Area(const SearchPointVector &v)
+{
+  fixed area = fixed(0);
+  for (unsigned i = 1; i + 1 < v.size(); ++i)
+    area += Cross(v[0].GetLocation(), v[i].GetLocation(),
+                  v[i + 1].GetLocation());
+  return area;
+}
+
+static bool
+IsConvexClosed(const SearchPointVector &v)
+{
+  if (v.size() < 4 || !(v.front().GetLocation() == v.back().GetLocation()))
+    return false;
+
+  const unsigned n = v.size() - 1;
+  for (unsigned i = 0; i < n; ++i)
+    if (!positive(Cross(v[i].GetLocation(), v[i + 1].GetLocation(),
+                        v[(i + 2) % n].GetLocation())))
+      return false;
+
+  return true;
+}
+
+/**
+ * Is the point inside the hull, allowing for the collinearity tolerance
+ * which pruned vertices close to an edge?
+ */
+static bool
+IsCovered(const SearchPointVector &v, const GeoPoint &p)
+{
+  for (unsigned i = 0; i + 1 < v.size(); ++i) {
+    const GeoPoint &a = v[i].GetLocation(), &b = v[i + 1].GetLocation();
+    const fixed length_squared =
+      sqr((b.longitude - a.longitude).Native()) +
+      sqr((b.latitude - a.latitude).Native());
+    /* allow 2% of the edge length */
+    if (sqr(Cross(a, b, p)) > length_squared * length_squared / 2500)
+      if (negative(Cross(a, b, p)))
+        return false;
+  }
+
+  return true;
+}
+
+static void
+TestExtend()
+{
+  srand(42);
+
+  SearchPointVector all, hull;
+  GeoPoint location(Angle::Degrees(7), Angle::Degrees(51));
+
+  for (unsigned i = 1; i <= N_POINTS; ++i) {
+    const SearchPoint sp(RandomWalk(location));
+    all.push_back(sp);
+
+    hull.ExtendConvexHull(sp);
+
+    if (i % CHECK_INTERVAL == 0) {
+      ok1(IsConvexClosed(hull));
+
+      SearchPointVector reference = all;
+      reference.PruneInterior();
+      /* both prune (nearly) collinear vertices, but not necessarily
+         the same ones */
+      ok1(equals(Area(hull), Area(reference), 100));
+
+      bool covered = true;
+      for (const auto &j : all)
+        covered &= IsCovered(hull, j.GetLocation());
+      ok1(covered);
+    }
+  }
+
+  /* a point inside does not modify the hull */
+  const SearchPointVector copy = hull;
+  const GeoPoint centre =
+    hull[0].GetLocation().Interpolate(hull[hull.size() / 2].GetLocation(),
+                                      fixed(0.5));
+  ok1(!hull.ExtendConvexHull(SearchPoint(centre)));
+  ok1(hull.size() == copy.size());
+
+  /* neither does a vertex */
+  ok1(!hull.ExtendConvexHull(hull[1]));
+  ok1(hull.size() == copy.size());
+}
+
+static void
+TestThin()
+{
+  srand(7);
+
+  SearchPointVector hull;
+  for (unsigned i = 0; i < N_POINTS; ++i) {
+    /* points on a circle, so every one of them is a hull vertex */
+    const Angle a = Angle::FullCircle() * fixed(rand() % 10000) / 10000;
+    const GeoPoint p(Angle::Degrees(7) + Angle::Degrees(a.cos() * fixed(0.1)),
+                     Angle::Degrees(51) + Angle::Degrees(a.sin() * fixed(0.1)));
+    hull.ExtendConvexHull(SearchPoint(p));
+  }
+
+  ok1(IsConvexClosed(hull));
+  ok1(hull.size() > 64);
+
+  const fixed area = Area(hull);
+  ok1(hull.ThinConvexHull(64));
+  ok1(hull.size() <= 64);
+  ok1(IsConvexClosed(hull));
+  ok1(Area(hull) <= area);
+  /* a 63-gon inscribed in a circle covers 99.5% of its area */
+  ok1(Area(hull) > area * fixed(0.99));
+
+  ok1(!hull.ThinConvexHull(64));
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(N_POINTS / CHECK_INTERVAL * 3 + 4 + 8);
+
+  TestExtend();
+  TestThin();
+
+  return exit_status();
+}
@@ -0,0 +1,241 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2015 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Compares the AAT target ranges found by TaskAnalyticTarget with
+ * those found by the ZeroFinder based TaskMinTarget.
+ */
+
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Engine/Task/Ordered/Settings.hpp"
+#include "Engine/Task/Ordered/Points/AATPoint.hpp"
+#include "Engine/Task/Ordered/Points/StartPoint.hpp"
+#include "Engine/Task/Ordered/Points/FinishPoint.hpp"
+#include "Engine/Task/ObservationZones/CylinderZone.hpp"
+#include "Engine/Task/ObservationZones/AnnularSectorZone.hpp"
+#include "Engine/Task/Solvers/TaskAnalyticTarget.hpp"
+#include "Engine/Task/Solvers/TaskMinTarget.hpp"
+#include "Engine/Task/Solvers/TaskMacCreadyRemaining.hpp"
+#include "TestUtil.hpp"
+
+#include <vector>
+
+static TaskBehaviour task_behaviour;
+static OrderedTaskSettings ordered_task_settings;
+
+static GeoPoint
+MakeGeoPoint(double longitude, double latitude)
+{
+  return GeoPoint(Angle::Degrees(longitude),
+                  Angle::Degrees(latitude));
+}
+
+static Waypoint
+MakeWaypoint(double longitude, double latitude)
+{
+  Waypoint wp(MakeGeoPoint(longitude, latitude));
+  wp.elevation = fixed(200);
+  return wp;
+}
+
+/**
+ * Wraps an #OrderedTask for the solvers, which operate on the raw
+ * task point list.
+ */
+class TestTask {
+  OrderedTask task;
+  std::vector<OrderedTaskPoint *> points;
+
+public:
+  TestTask():task(task_behaviour) {}
+
+  void AddStart(const Waypoint &wp) {
+    task.Append(StartPoint(new CylinderZone(wp.location, fixed(1000)), wp,
+                           task_behaviour,
+                           ordered_task_settings.start_constraints));
+  }
+
+  void AddAAT(const Waypoint &wp, ObservationZonePoint *oz) {
+    task.Append(AATPoint(oz, wp, task_behaviour));
+  }
+
+  void AddFinish(const Waypoint &wp) {
+    task.Append(FinishPoint(new CylinderZone(wp.location, fixed(1000)), wp,
+                            task_behaviour,
+                            ordered_task_settings.finish_constraints));
+  }
+
+  bool Commit() {
+    task.SetActiveTaskPoint(0);
+    task.UpdateGeometry();
+
+    points.clear();
+    for (unsigned i = 0; i < task.TaskSize(); ++i)
+      points.push_back(&task.GetPoint(i));
+
+    return task.CheckTask();
+  }
+
+  const std::vector<OrderedTaskPoint *> &GetPoints() const {
+    return points;
+  }
+
+  StartPoint *GetStart() {
+    return (StartPoint *)points.front();
+  }
+
+  /**
+   * Solve the task with all targets at the given range.
+   *
+   * @return the time remaining [s]
+   */
+  fixed GetTime(const AircraftState &aircraft, const GlidePolar &polar,
+                fixed range) {
+    TaskMacCreadyRemaining tm(points.cbegin(), points.cend(), 0,
+                              task_behaviour.glide, polar, false);
+    tm.set_range(range, false);
+    GetStart()->ScanDistanceRemaining(aircraft.location);
+    return tm.glide_solution(aircraft).time_elapsed;
+  }
+};
+
+static void
+TestCompare(TestTask &task, const AircraftState &aircraft,
+            const GlidePolar &polar, fixed t_remaining)
+{
+  TaskMinTarget zero_finder(task.GetPoints(), 0, aircraft,
+                            task_behaviour.glide, polar, t_remaining,
+                            task.GetStart());
+  const fixed p_zero_finder = zero_finder.search(fixed(0));
+
+  TaskAnalyticTarget analytic(task.GetPoints(), 0, aircraft,
+                              task_behaviour.glide, polar, t_remaining,
+                              task.GetStart());
+  const fixed p_analytic = analytic.search(fixed(0));
+
+  /* both stop within TOLERANCE_MIN_TARGET of the root */
+  ok(fabs(p_analytic - p_zero_finder) < fixed(0.005),
+     "analytic range %f, zero finder range %f",
+     (double)p_analytic, (double)p_zero_finder);
+}
+
+/**
+ * Solve for a few minimum times between the shortest and the longest
+ * possible task, and for times outside of that interval.
+ */
+static void
+TestTask(TestTask &task)
+{
+  ok1(task.Commit());
+
+  AircraftState aircraft;
+  aircraft.Reset();
+  aircraft.location = task.GetPoints().front()->GetLocation();
+  aircraft.altitude = fixed(1500);
+  aircraft.flying = true;
+
+  static constexpr double mcs[] = { 0.5, 1.5, 3 };
+  for (const double mc : mcs) {
+    const GlidePolar polar{fixed(mc)};
+
+    const fixed t_min = task.GetTime(aircraft, polar, fixed(0));
+    const fixed t_max = task.GetTime(aircraft, polar, fixed(1));
+    ok1(t_max > t_min);
+
+    for (unsigned i = 1; i < 4; ++i)
+      TestCompare(task, aircraft, polar,
+                  t_min + (t_max - t_min) * i / 4);
+
+    /* the shortest task is already too slow */
+    TestCompare(task, aircraft, polar, t_min / 2);
+
+    /* the longest task is still too fast */
+    TestCompare(task, aircraft, polar, t_max * 2);
+  }
+}
+
+static void
+TestOutAndReturn()
+{
+  const Waypoint start = MakeWaypoint(7, 51);
+  const Waypoint turn = MakeWaypoint(7, 51.8);
+
+  class TestTask task;
+  task.AddStart(start);
+  task.AddAAT(turn, new CylinderZone(turn.location, fixed(20000)));
+  task.AddFinish(start);
+  TestTask(task);
+}
+
+static void
+TestTriangle()
+{
+  const Waypoint start = MakeWaypoint(7, 51);
+  const Waypoint turn1 = MakeWaypoint(7.8, 51.6);
+  const Waypoint turn2 = MakeWaypoint(6.5, 51.7);
+
+  class TestTask task;
+  task.AddStart(start);
+  task.AddAAT(turn1, new CylinderZone(turn1.location, fixed(15000)));
+  task.AddAAT(turn2, new CylinderZone(turn2.location, fixed(30000)));
+  task.AddFinish(start);
+  TestTask(task);
+}
+
+static void
+TestSectors()
+{
+  const Waypoint start = MakeWaypoint(7, 51);
+  const Waypoint turn1 = MakeWaypoint(8, 51.2);
+  const Waypoint turn2 = MakeWaypoint(8.3, 51.9);
+  const Waypoint turn3 = MakeWaypoint(7.2, 52);
+  const Waypoint finish = MakeWaypoint(7.1, 51.1);
+
+  class TestTask task;
+  task.AddStart(start);
+  task.AddAAT(turn1, new AnnularSectorZone(turn1.location, fixed(25000),
+                                           Angle::Degrees(45),
+                                           Angle::Degrees(135),
+                                           fixed(5000)));
+  task.AddAAT(turn2, new CylinderZone(turn2.location, fixed(10000)));
+  task.AddAAT(turn3, new AnnularSectorZone(turn3.location, fixed(30000),
+                                           Angle::Degrees(270),
+                                           Angle::Degrees(30)));
+  task.AddFinish(finish);
+  TestTask(task);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(3 * (1 + 3 * 6));
+
+  task_behaviour.SetDefaults();
+  ordered_task_settings.SetDefaults();
+
+  TestOutAndReturn();
+  TestTriangle();
+  TestSectors();
+
+  return exit_status();
+}
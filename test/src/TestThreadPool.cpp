@@ -0,0 +1,188 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Thread/ThreadPool.hpp"
+#include "Thread/Handle.hpp"
+#include "OS/Sleep.h"
+#include "TestUtil.hpp"
+
+#include <atomic>
+
+static constexpr unsigned MAX_ITEMS = 64;
+
+/**
+ * Counts the calls for each index of a ForEach() call.
+ */
+class Counter {
+  std::atomic<unsigned> calls[MAX_ITEMS];
+
+public:
+  Counter() {
+    for (auto &i : calls)
+      i.store(0, std::memory_order_relaxed);
+  }
+
+  void operator()(unsigned i) {
+    if (i < MAX_ITEMS)
+      calls[i].fetch_add(1, std::memory_order_relaxed);
+    else
+      /* out of range: will be detected by Check() as a missing
+         call */
+      calls[0].fetch_add(MAX_ITEMS, std::memory_order_relaxed);
+  }
+
+  /**
+   * Were all indices below n visited exactly once, and no others?
+   */
+  bool Check(unsigned n) const {
+    for (unsigned i = 0; i < MAX_ITEMS; ++i)
+      if (calls[i].load(std::memory_order_relaxed) != (i < n ? 1u : 0u))
+        return false;
+
+    return true;
+  }
+};
+
+static bool
+ForEachOnce(ThreadPool &pool, unsigned n)
+{
+  Counter counter;
+  pool.ForEach(n, [&counter](unsigned i){ counter(i); });
+  return counter.Check(n);
+}
+
+/**
+ * Does ForEach() wait for slow calls to finish?
+ */
+static bool
+WaitsForAll(ThreadPool &pool, unsigned n)
+{
+  std::atomic<unsigned> finished(0);
+  pool.ForEach(n, [&finished](unsigned i){
+      if (i % 2 == 0)
+        Sleep(10);
+      finished.fetch_add(1, std::memory_order_relaxed);
+    });
+
+  return finished.load(std::memory_order_relaxed) == n;
+}
+
+/**
+ * Are all calls made in the calling thread?
+ */
+static bool
+RunsInCaller(ThreadPool &pool, unsigned n)
+{
+  const ThreadHandle caller = ThreadHandle::GetCurrent();
+  bool inside = true;
+  pool.ForEach(n, [&caller, &inside](unsigned){
+      if (!caller.IsInside())
+        inside = false;
+    });
+
+  return inside;
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(19);
+
+  /* without threads, the caller does all the work */
+  {
+    ThreadPool pool(0);
+    ok1(pool.GetConcurrency() == 1);
+    ok1(ForEachOnce(pool, 0));
+    ok1(ForEachOnce(pool, MAX_ITEMS));
+    ok1(RunsInCaller(pool, MAX_ITEMS));
+  }
+
+  /* the number of threads is clipped */
+  {
+    ThreadPool pool(1000);
+    ok1(pool.GetConcurrency() == 4);
+  }
+
+  {
+    ThreadPool pool(3);
+    ok1(pool.GetConcurrency() == 4);
+
+    /* zero items */
+    ok1(ForEachOnce(pool, 0));
+
+    /* a single item is run in the calling thread */
+    ok1(ForEachOnce(pool, 1));
+    ok1(RunsInCaller(pool, 1));
+
+    /* fewer items than workers */
+    ok1(ForEachOnce(pool, 2));
+    ok1(ForEachOnce(pool, 3));
+
+    /* more items than workers */
+    ok1(ForEachOnce(pool, 4));
+    ok1(ForEachOnce(pool, MAX_ITEMS));
+
+    ok1(WaitsForAll(pool, 16));
+
+    /* many consecutive calls of varying size on the same pool: each
+       one must see only its own items, even if a worker is still
+       returning from the previous call */
+    bool repeated = true;
+    for (unsigned i = 0; i < 20000 && repeated; ++i)
+      repeated = ForEachOnce(pool, i % 9);
+    ok1(repeated);
+
+    /* still usable afterwards */
+    ok1(ForEachOnce(pool, MAX_ITEMS));
+  }
+
+  /* shutdown: destroying pools which were never used, or just after
+     ForEach() has returned, must not hang */
+  for (unsigned n_threads = 1; n_threads <= 3; ++n_threads) {
+    ThreadPool pool(n_threads);
+  }
+  ok1(true);
+
+  {
+    std::atomic<unsigned> calls(0);
+
+    {
+      ThreadPool pool(3);
+      pool.ForEach(MAX_ITEMS, [&calls](unsigned){
+          calls.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+
+    ok1(calls.load(std::memory_order_relaxed) == MAX_ITEMS);
+  }
+
+  /* pools which are created, used once and destroyed */
+  bool short_lived = true;
+  for (unsigned i = 0; i < 1000 && short_lived; ++i) {
+    ThreadPool pool(1 + i % 3);
+    short_lived = ForEachOnce(pool, i % 5);
+  }
+  ok1(short_lived);
+
+  return exit_status();
+}
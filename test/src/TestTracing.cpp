@@ -0,0 +1,167 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Thread/Tracing.hpp"
+#include "Thread/Thread.hpp"
+#include "TestUtil.hpp"
+
+#include <string.h>
+
+class TracedThread : public Thread {
+public:
+  TracedThread():Thread("Traced") {}
+
+protected:
+  virtual void Run() {
+    Tracing::Record("worker", 100, 150);
+  }
+};
+
+/**
+ * Records events as fast as possible until stopped.  Each event's
+ * duration is derived from its start time, which allows detecting
+ * torn events.
+ */
+class StressThread : public Thread {
+  std::atomic<bool> stop;
+
+public:
+  StressThread():Thread("Stress"), stop(false) {}
+
+  void Stop() {
+    stop.store(true, std::memory_order_relaxed);
+  }
+
+protected:
+  virtual void Run() {
+    for (uint64_t i = 1; !stop.load(std::memory_order_relaxed); ++i)
+      Tracing::Record("stress", i, i + i % 1000);
+  }
+};
+
+static const Tracing::ThreadEvents *
+FindThread(const std::vector<Tracing::ThreadEvents> &threads,
+           const char *name)
+{
+  for (const auto &thread : threads)
+    if (strcmp(thread.name, name) == 0)
+      return &thread;
+
+  return nullptr;
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(18);
+
+  /* disabled: ScopeTrace records nothing */
+  {
+    const ScopeTrace trace("disabled");
+  }
+
+  ok1(!Tracing::IsEnabled());
+  ok1(Tracing::Collect().empty());
+
+  Tracing::Enable(true);
+  ok1(Tracing::IsEnabled());
+
+  {
+    const ScopeTrace trace("enabled");
+  }
+
+  Tracing::Record("explicit", 1000, 1250);
+
+  auto threads = Tracing::Collect();
+  ok1(threads.size() == 1);
+  ok1(strcmp(threads.front().name, "main") == 0);
+  ok1(threads.front().events.size() == 2);
+  ok1(strcmp(threads.front().events[0].name, "enabled") == 0);
+  ok1(strcmp(threads.front().events[1].name, "explicit") == 0);
+  ok1(threads.front().events[1].start_us == 1000);
+  ok1(threads.front().events[1].duration_us == 250);
+
+  /* the ring buffer keeps only the newest events */
+  for (unsigned i = 0; i < Tracing::RING_SIZE + 10; ++i)
+    Tracing::Record("wrap", i, i + 1);
+
+  threads = Tracing::Collect();
+  ok1(threads.front().events.size() == Tracing::RING_SIZE);
+  ok1(threads.front().events.front().start_us == 10);
+
+  Tracing::Clear();
+  threads = Tracing::Collect();
+  ok1(threads.front().events.empty());
+
+  /* a second thread gets its own ring buffer with its name */
+  TracedThread thread;
+  thread.Start();
+  thread.Join();
+
+  threads = Tracing::Collect();
+  ok1(threads.size() == 2);
+
+  const Tracing::ThreadEvents *traced = FindThread(threads, "Traced");
+  ok1(traced != nullptr);
+  ok1(traced != nullptr && traced->events.size() == 1);
+
+  /* collecting while another thread overwrites its ring buffer never
+     returns a torn or out-of-order event */
+  StressThread stress;
+  stress.Start();
+
+  /* wait until the ring buffer is well filled */
+  const Tracing::ThreadEvents *st;
+  do {
+    threads = Tracing::Collect();
+    st = FindThread(threads, "Stress");
+  } while (st == nullptr || st->events.size() < Tracing::RING_SIZE / 2);
+
+  unsigned n_events = 0;
+  bool consistent = true;
+  for (unsigned i = 0; i < 200; ++i) {
+    threads = Tracing::Collect();
+    st = FindThread(threads, "Stress");
+    if (st == nullptr)
+      continue;
+
+    n_events += st->events.size();
+
+    uint64_t previous = 0;
+    for (const auto &event : st->events) {
+      if (strcmp(event.name, "stress") != 0 ||
+          event.duration_us != event.start_us % 1000 ||
+          (previous != 0 && event.start_us != previous + 1))
+        consistent = false;
+      previous = event.start_us;
+    }
+  }
+
+  stress.Stop();
+  stress.Join();
+
+  ok1(n_events > 0);
+  ok1(consistent);
+
+  return exit_status();
+}
@@ -0,0 +1,120 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2015 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Thread/TripleBuffer.hpp"
+#include "Thread/Thread.hpp"
+#include "TestUtil.hpp"
+
+struct Snapshot {
+  unsigned a, b;
+};
+
+/**
+ * Publishes snapshots whose two attributes must always be equal; a
+ * torn read would make them differ.
+ */
+class Producer : public Thread {
+  TripleBuffer<Snapshot> &buffer;
+
+public:
+  static constexpr unsigned N = 200000;
+
+  Producer(TripleBuffer<Snapshot> &_buffer):buffer(_buffer) {}
+
+protected:
+  virtual void Run() {
+    for (unsigned i = 1; i <= N; ++i) {
+      Snapshot &s = buffer.Back();
+      s.a = i;
+      s.b = i;
+      buffer.Publish();
+    }
+  }
+};
+
+static void
+TestSequential()
+{
+  TripleBuffer<unsigned> buffer;
+  buffer.Reset(0);
+
+  ok1(!buffer.IsFresh());
+  ok1(!buffer.Update());
+  ok1(buffer.Front() == 0);
+
+  buffer.Publish(1);
+  ok1(buffer.IsFresh());
+  ok1(buffer.Front() == 0);
+  ok1(buffer.Update());
+  ok1(buffer.Front() == 1);
+  ok1(!buffer.Update());
+  ok1(buffer.Front() == 1);
+
+  /* only the latest snapshot is seen */
+  buffer.Publish(2);
+  buffer.Publish(3);
+  buffer.Publish(4);
+  ok1(buffer.Front() == 1);
+  ok1(buffer.Update());
+  ok1(buffer.Front() == 4);
+  ok1(!buffer.IsFresh());
+}
+
+static void
+TestConcurrent()
+{
+  TripleBuffer<Snapshot> buffer;
+  buffer.Reset({0, 0});
+
+  Producer producer(buffer);
+  producer.Start();
+
+  bool consistent = true, monotonic = true;
+  unsigned last = 0;
+  while (last < Producer::N) {
+    if (!buffer.Update())
+      continue;
+
+    const Snapshot &s = buffer.Front();
+    if (s.a != s.b)
+      consistent = false;
+    if (s.a <= last)
+      monotonic = false;
+    last = s.a;
+  }
+
+  producer.Join();
+
+  ok1(consistent);
+  ok1(monotonic);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(15);
+
+  TestSequential();
+  TestConcurrent();
+
+  return exit_status();
+}
@@ -0,0 +1,270 @@
+/*
+Copyright_License {
+
+  Top Hat Soaring Glide Computer - http://www.tophatsoaring.org/
+  Copyright (C) 2000-2016 The Top Hat Soaring Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Computer/WaypointReachComputer.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Engine/GlideSolvers/GlideState.hpp"
+#include "Engine/GlideSolvers/GlideResult.hpp"
+#include "Engine/GlideSolvers/MacCready.hpp"
+#include "Engine/Task/TaskBehaviour.hpp"
+#include "Task/RoutePlannerGlue.hpp"
+#include "NMEA/MoreData.hpp"
+#include "NMEA/Derived.hpp"
+#include "Geo/GeoVector.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+
+typedef WaypointReachComputer::CandidateArray CandidateArray;
+
+static constexpr unsigned MAX_ITEMS = WaypointReachInfo::MAX_ITEMS;
+
+/* more landables than fit into the table; a prime, for the
+   permutation in AddWaypoints() */
+static constexpr unsigned N_LANDABLES = 601;
+
+static const GeoPoint center(Angle::Degrees(7), Angle::Degrees(51));
+
+static GeoPoint
+MakeLocation(fixed distance, unsigned i)
+{
+  return GeoVector(distance, Angle::Degrees(i * 37 % 360)).EndPoint(center);
+}
+
+/**
+ * @return the id of the new waypoint
+ */
+static unsigned
+Append(Waypoints &waypoints, const GeoPoint &location,
+       Waypoint::Type type, unsigned original_id, bool watched=false)
+{
+  Waypoint waypoint(location);
+  waypoint.type = type;
+  waypoint.original_id = original_id;
+  waypoint.elevation = fixed(0);
+  if (watched)
+    waypoint.origin = WaypointOrigin::WATCHED;
+  return waypoints.Append(std::move(waypoint)).id;
+}
+
+/**
+ * Add #N_LANDABLES airfields at different distances, in an order
+ * which depends on the given factor, and turn points which are
+ * nearer than all of them.  One of the turn points is watched.
+ */
+static void
+AddWaypoints(Waypoints &waypoints, unsigned factor)
+{
+  for (unsigned i = 0; i < N_LANDABLES; ++i) {
+    const unsigned j = i * factor % N_LANDABLES;
+    Append(waypoints, MakeLocation(fixed(1000 + 50 * j), j),
+           Waypoint::Type::AIRFIELD, j);
+
+    if (i % 10 == 0)
+      Append(waypoints, MakeLocation(fixed(500), i),
+             Waypoint::Type::NORMAL, 1000 + i, i == 50);
+  }
+
+  waypoints.Optimise();
+}
+
+static bool
+IsEligible(const Waypoint &waypoint)
+{
+  return waypoint.IsLandable() || waypoint.flags.watched;
+}
+
+/**
+ * Were exactly the nearest eligible waypoints collected?
+ */
+static bool
+IsNearest(const CandidateArray &candidates, unsigned expected_size)
+{
+  if (candidates.size() != expected_size)
+    return false;
+
+  for (const auto &candidate : candidates)
+    if (!IsEligible(*candidate.waypoint))
+      return false;
+
+  /* the watched turn point is nearer than all airfields */
+  if (std::none_of(candidates.begin(), candidates.end(),
+                   [](const WaypointReachComputer::Candidate &c){
+                     return c.waypoint->flags.watched;
+                   }))
+    return false;
+
+  /* the airfields with original_id below expected_size-1 are the
+     nearest ones */
+  for (const auto &candidate : candidates)
+    if (candidate.waypoint->IsLandable() &&
+        candidate.waypoint->original_id >= expected_size - 1)
+      return false;
+
+  return true;
+}
+
+static void
+TestCandidates()
+{
+  /* the result must not depend on the order in which the waypoints
+     are visited */
+  static constexpr unsigned factors[] = { 1, 7, 263, 600 };
+  for (unsigned factor : factors) {
+    Waypoints waypoints;
+    AddWaypoints(waypoints, factor);
+
+    CandidateArray candidates;
+    WaypointReachComputer::CollectCandidates(waypoints, center,
+                                             fixed(100000), candidates);
+    ok(IsNearest(candidates, MAX_ITEMS), "nearest, factor %u", factor);
+  }
+
+  /* fewer candidates than the table size: all are collected */
+  {
+    Waypoints waypoints;
+    for (unsigned i = 0; i < 10; ++i)
+      Append(waypoints, MakeLocation(fixed(1000 + 50 * i), i),
+             Waypoint::Type::AIRFIELD, i);
+    Append(waypoints, MakeLocation(fixed(500), 0),
+           Waypoint::Type::NORMAL, 1000);
+    Append(waypoints, MakeLocation(fixed(500), 1),
+           Waypoint::Type::NORMAL, 1001, true);
+    waypoints.Optimise();
+
+    CandidateArray candidates;
+    WaypointReachComputer::CollectCandidates(waypoints, center,
+                                             fixed(100000), candidates);
+    ok1(IsNearest(candidates, 11));
+  }
+
+  /* no waypoints */
+  {
+    Waypoints waypoints;
+    CandidateArray candidates;
+    WaypointReachComputer::CollectCandidates(waypoints, center,
+                                             fixed(100000), candidates);
+    ok1(candidates.empty());
+  }
+}
+
+/**
+ * Without a reach fan, the arrival heights are straight glides.
+ */
+static void
+TestStraightGlide()
+{
+  const GeoPoint near_location = MakeLocation(fixed(5000), 0);
+
+  Waypoints waypoints;
+  const unsigned near = Append(waypoints, near_location,
+                               Waypoint::Type::AIRFIELD, 0);
+  const unsigned far = Append(waypoints, MakeLocation(fixed(45000), 1),
+                              Waypoint::Type::AIRFIELD, 1);
+  const unsigned turnpoint = Append(waypoints, MakeLocation(fixed(1000), 2),
+                                    Waypoint::Type::NORMAL, 2);
+  waypoints.Optimise();
+
+  TaskBehaviour task_behaviour;
+  task_behaviour.SetDefaults();
+
+  const GlidePolar polar(fixed(0));
+
+  MoreData basic;
+  basic.Reset();
+  basic.time = fixed(1000);
+  basic.location = center;
+  basic.location_available.Update(basic.time);
+  basic.nav_altitude = fixed(1000);
+  basic.gps_altitude_available.Update(basic.time);
+
+  DerivedInfo calculated;
+  calculated.Reset();
+  calculated.glide_polar_safety = polar;
+
+  const RoutePlannerGlue route_planner;
+  ok1(route_planner.IsReachEmpty());
+
+  WaypointReachComputer computer;
+  computer.Reset();
+  computer.Compute(waypoints, basic, calculated, task_behaviour,
+                   polar, route_planner);
+
+  ok1(calculated.generations.values[DerivedGenerations::TERRAIN] == 1);
+
+  {
+    ProtectedWaypointReach::Lease lease(computer.GetReach());
+    const WaypointReachInfo &info = lease;
+
+    ok1(info.version == 1);
+    ok1(info.items.size() == 2);
+    ok1(info.Find(turnpoint) == nullptr);
+
+    const MacCready mac_cready(task_behaviour.glide, polar);
+    const fixed elevation = task_behaviour.safety_height_arrival;
+
+    const WaypointReachInfo::Item *item = info.Find(near);
+    ok1(item != nullptr &&
+        item->reachable == WaypointReachInfo::Reachability::TERRAIN);
+    const GlideResult near_result =
+      mac_cready.SolveStraight(GlideState(GeoVector(center, near_location),
+                                          elevation, basic.nav_altitude,
+                                          SpeedVector::Zero()));
+    ok1(item != nullptr && near_result.IsOk() &&
+        abs((int)item->reach.direct -
+            (int)near_result.altitude_difference) <= 1);
+
+    item = info.Find(far);
+    ok1(item != nullptr &&
+        item->reachable == WaypointReachInfo::Reachability::UNREACHABLE &&
+        !item->reach.IsReachableDirect());
+  }
+
+  /* not again within the same second */
+  computer.Compute(waypoints, basic, calculated, task_behaviour,
+                   polar, route_planner);
+  ok1(calculated.generations.values[DerivedGenerations::TERRAIN] == 1);
+
+  /* the table is cleared when the position is lost */
+  basic.location_available.Clear();
+  computer.Compute(waypoints, basic, calculated, task_behaviour,
+                   polar, route_planner);
+  ok1(calculated.generations.values[DerivedGenerations::TERRAIN] == 2);
+
+  {
+    ProtectedWaypointReach::Lease lease(computer.GetReach());
+    ok1(lease->version == 2 && lease->items.empty());
+  }
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(17);
+
+  TestCandidates();
+  TestStraightGlide();
+
+  return exit_status();
+}